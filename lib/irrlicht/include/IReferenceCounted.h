@@ -7,6 +7,8 @@
 
 #include "irrTypes.h"
 
+#include <atomic>
+
 namespace irr
 {
 
@@ -53,6 +55,21 @@ namespace irr
 		{
 		}
 
+		//! Copies the debug name and the reference counter, as a copy of a
+		//! plain counter would.
+		IReferenceCounted(const IReferenceCounted& other)
+			: DebugName(other.DebugName),
+			ReferenceCounter(other.ReferenceCounter.load())
+		{
+		}
+
+		IReferenceCounted& operator=(const IReferenceCounted& other)
+		{
+			DebugName = other.DebugName;
+			ReferenceCounter = other.ReferenceCounter.load();
+			return *this;
+		}
+
 		//! Grabs the object. Increments the reference counter by one.
 		/** Someone who calls grab() to an object, should later also
 		call drop() to it. If an object never gets as much drop() as
@@ -118,8 +135,7 @@ namespace irr
 			// someone is doing bad reference counting.
 			_IRR_DEBUG_BREAK_IF(ReferenceCounter <= 0)
 
-			--ReferenceCounter;
-			if (!ReferenceCounter)
+			if (--ReferenceCounter == 0)
 			{
 				delete this;
 				return true;
@@ -161,7 +177,9 @@ namespace irr
 		const c8* DebugName;
 
 		//! The reference counter. Mutable to do reference counting on const objects.
-		mutable s32 ReferenceCounter;
+		/** Atomic, since meshes and textures are shared by simulations that
+		step in parallel. */
+		mutable std::atomic<s32> ReferenceCounter;
 	};
 
 } // end namespace irr
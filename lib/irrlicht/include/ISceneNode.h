@@ -18,6 +18,8 @@
 #include "irrList.h"
 #include "IAttributes.h"
 
+#include <mutex>
+
 namespace irr
 {
 namespace scene
@@ -29,6 +31,16 @@ namespace scene
 	//! Typedef for list of scene node animators
 	typedef core::list<ISceneNodeAnimator*> ISceneNodeAnimatorList;
 
+	//! Guards the children lists of all scene nodes.
+	/** Simulations that step in parallel add and remove nodes below the
+	same root node. Recursive, since removing a child can delete it, which
+	removes its own children. */
+	inline std::recursive_mutex& getSceneGraphMutex()
+	{
+		static std::recursive_mutex mutex;
+		return mutex;
+	}
+
 	//! Scene node interface.
 	/** A scene node is a node in the hierarchical scene graph. Every scene
 	node may have children, which are also scene nodes. Children move
@@ -294,6 +306,7 @@ namespace scene
 		{
 			if (child && (child != this))
 			{
+				std::lock_guard<std::recursive_mutex> lock(getSceneGraphMutex());
 				// Change scene manager?
 				if (SceneManager != child->SceneManager)
 					child->setSceneManager(SceneManager);
@@ -314,6 +327,7 @@ namespace scene
 		e.g. because it couldn't be found in the children list. */
 		virtual bool removeChild(ISceneNode* child)
 		{
+			std::lock_guard<std::recursive_mutex> lock(getSceneGraphMutex());
 			ISceneNodeList::Iterator it = Children.begin();
 			for (; it != Children.end(); ++it)
 				if ((*it) == child)
@@ -335,6 +349,7 @@ namespace scene
 		*/
 		virtual void removeAll()
 		{
+			std::lock_guard<std::recursive_mutex> lock(getSceneGraphMutex());
 			ISceneNodeList::Iterator it = Children.begin();
 			for (; it != Children.end(); ++it)
 			{
@@ -351,6 +366,7 @@ namespace scene
 		*/
 		virtual void remove()
 		{
+			std::lock_guard<std::recursive_mutex> lock(getSceneGraphMutex());
 			if (Parent)
 				Parent->removeChild(this);
 		}
@@ -614,6 +630,7 @@ namespace scene
 		/** \param newParent The new parent to be used. */
 		virtual void setParent(ISceneNode* newParent)
 		{
+			std::lock_guard<std::recursive_mutex> lock(getSceneGraphMutex());
 			grab();
 			remove();
 
@@ -10,8 +10,11 @@
 #include "pystk.hpp"
 #include "state.hpp"
 #include "view.hpp"
+#include "karts/kart_properties_manager.hpp"
+#include "tracks/track_cache.hpp"
 #include "utils/objecttype.h"
 #include "utils/log.hpp"
+#include "utils/profiler.hpp"
 
 #ifdef WIN32
 #include <Windows.h>
@@ -22,23 +25,60 @@ using namespace pybind11::literals;
 
 PYBIND11_MAKE_OPAQUE(std::vector<PySTKPlayerConfig>);
 
+// A SERVER_ONLY build is a separate module, such that both can be installed side by side
+#ifdef SERVER_ONLY
+#define PYSTK_MODULE pystk_headless
+#else
+#define PYSTK_MODULE pystk
+#endif
+
+static py::object get_output(const std::shared_ptr<NumpyPBO> & buf, const std::vector<py::array> & out, unsigned int frame) {
+    if (!buf)
+        return py::none();
+    if (out.empty())
+        return buf->get();
+    return buf->get(out[frame % out.size()]);
+}
+
+static std::vector<py::array> as_outputs(const std::shared_ptr<NumpyPBO> & buf, py::object o) {
+    std::vector<py::array> r;
+    if (o.is_none())
+        return r;
+    if (!buf)
+        throw std::invalid_argument("Cannot set an output that is not in RaceConfig.observations!");
+    if (py::isinstance<py::array>(o))
+        r.push_back(o.cast<py::array>());
+    else
+        for (auto a: o)
+            r.push_back(a.cast<py::array>());
+    for (const auto & a: r)
+        buf->checkOutput(a);
+    return r;
+}
+
 void path_and_init(const PySTKGraphicsConfig & config) {
     auto sys = py::module::import("sys"), os = py::module::import("os");
     auto path = os.attr("path"), env = os.attr("environ");
-    auto module_path = path.attr("join")(path.attr("dirname")(path.attr("abspath")(sys.attr("modules")["pystk"].attr("__file__"))), "pystk_data");
+    auto module_path = path.attr("join")(path.attr("dirname")(path.attr("abspath")(sys.attr("modules")[PYBIND11_TOSTRING(PYSTK_MODULE)].attr("__file__"))), "pystk_data");
     // Give supertuxkart a hint where the assets are
     env["SUPERTUXKART_DATADIR"] = module_path;
     PySTKRace::init(config);
 }
-PYBIND11_MODULE(pystk, m) {
+PYBIND11_MODULE(PYSTK_MODULE, m) {
     m.doc() = "Python SuperTuxKart interface";
 
+#ifndef SERVER_ONLY
     // Make offscreen rendering default
     if (!getenv("IRR_DEVICE_TYPE"))
 #ifdef WIN32
         _putenv_s("IRR_DEVICE_TYPE", "offscreen");
 #else
         setenv("IRR_DEVICE_TYPE", "offscreen", 0);
+#endif
+    m.attr("headless") = false;
+#else
+    // Races run without a GL context, nothing is rendered
+    m.attr("headless") = true;
 #endif
     // Adjust the log level
     Log::setLogLevel(Log::LL_FATAL);
@@ -82,6 +122,15 @@ PYBIND11_MODULE(pystk, m) {
         m.def("unknown_debug_name", unknownDebugName);
         m.attr("object_type_shift") = OBJECT_TYPE_SHIFT;
     }
+    {
+        py::enum_<PySTKRayHit>(m, "RayHit", "What a ray of Race.raycast hit")
+        .value("none", PySTKRayHit::NONE)
+        .value("track", PySTKRayHit::TRACK)
+        .value("kart", PySTKRayHit::KART)
+        .value("flyable", PySTKRayHit::FLYABLE)
+        .value("physical_object", PySTKRayHit::PHYSICAL_OBJECT)
+        .value("animation", PySTKRayHit::ANIMATION);
+    }
     {
         py::class_<PySTKGraphicsConfig, std::shared_ptr<PySTKGraphicsConfig>> cls(m, "GraphicsConfig", "SuperTuxKart graphics configuration.");
         
@@ -138,7 +187,7 @@ PYBIND11_MODULE(pystk, m) {
             .value("SOCCER", PySTKRaceConfig::RaceMode::SOCCER);
         
         cls
-        .def(py::init<int,PySTKRaceConfig::RaceMode,std::vector<PySTKPlayerConfig>,std::string,bool,int,int,int,float,bool>(), py::arg("difficulty") = 2, py::arg("mode") = PySTKRaceConfig::NORMAL_RACE, py::arg("players") = std::vector<PySTKPlayerConfig>{{"",PySTKPlayerConfig::PLAYER_CONTROL}}, py::arg("track") = "", py::arg("reverse") = false, py::arg("laps") = 3, py::arg("seed") = 0, py::arg("num_kart") = 1, py::arg("step_size") = 0.1, py::arg("render") = true)
+        .def(py::init<int,PySTKRaceConfig::RaceMode,std::vector<PySTKPlayerConfig>,std::string,bool,int,int,int,float,bool,int,int,int,std::set<std::string>>(), py::arg("difficulty") = 2, py::arg("mode") = PySTKRaceConfig::NORMAL_RACE, py::arg("players") = std::vector<PySTKPlayerConfig>{{"",PySTKPlayerConfig::PLAYER_CONTROL}}, py::arg("track") = "", py::arg("reverse") = false, py::arg("laps") = 3, py::arg("seed") = 0, py::arg("num_kart") = 1, py::arg("step_size") = 0.1, py::arg("render") = true, py::arg("render_latency") = 0, py::arg("observation_width") = 0, py::arg("observation_height") = 0, py::arg("observations") = std::set<std::string>{"image", "depth", "instance"})
         .def_readwrite("difficulty", &PySTKRaceConfig::difficulty, "Skill of AI players 0..2")
         .def_readwrite("mode", &PySTKRaceConfig::mode, "Specify the type of race")
         .def_readwrite("players", &PySTKRaceConfig::players, "List of all agent players")
@@ -148,16 +197,25 @@ PYBIND11_MODULE(pystk, m) {
         .def_readwrite("seed", &PySTKRaceConfig::seed, "Random seed")
         .def_readwrite("num_kart", &PySTKRaceConfig::num_kart, "Total number of karts, fill the race with num_kart - len(players) AI karts")
         .def_readwrite("step_size", &PySTKRaceConfig::step_size, "Game time between different step calls")
-        .def_readwrite("render", &PySTKRaceConfig::render, "Is rendering enabled?");
+        .def_readwrite("render", &PySTKRaceConfig::render, "Is rendering enabled?")
+        .def_readwrite("observations", &PySTKRaceConfig::observations, "Set of render outputs to read back, any of 'image', 'depth' and 'instance'. Outputs not in this set are None in render_data, and without 'instance' the label pass is skipped.")
+        .def_readwrite("observation_width", &PySTKRaceConfig::observation_width, "Width of the render outputs, 0 uses the screen width. The race is rendered at up to twice this size (at most the screen size) and downsampled on the GPU (linear filtering for image, nearest for depth and instance).")
+        .def_readwrite("observation_height", &PySTKRaceConfig::observation_height, "Height of the render outputs, 0 uses the screen height")
+        .def_readwrite("render_latency", &PySTKRaceConfig::render_latency, "Number of steps render_data lags behind the simulation. With a latency of 1 the readback of a frame overlaps with the next step instead of stalling on the GPU.");
         add_pickle(cls);
     }
 
     {
         py::class_<PySTKRenderData, std::shared_ptr<PySTKRenderData> > cls(m, "RenderData", "SuperTuxKart rendering output");
         cls
-       .def_property_readonly("image", [](const PySTKRenderData & rd) { return rd.color_buf_->get(); }, "Color image of the kart (memoryview[uint8] screen_height x screen_width x 3)")
-       .def_property_readonly("depth", [](const PySTKRenderData & rd) { return rd.depth_buf_->get(); }, "Depth image of the kart (memoryview[float] screen_height x screen_width)")
-       .def_property_readonly("instance", [](const PySTKRenderData & rd) { return rd.instance_buf_->get(); }, "Instance labels (memoryview[uint32] screen_height x screen_width)");
+       .def_property_readonly("image", [](const PySTKRenderData & rd) { return get_output(rd.color_buf_, rd.color_out_, rd.frame_); }, "Color image of the kart (memoryview[uint8] observation_height x observation_width x 3)")
+       .def_property_readonly("depth", [](const PySTKRenderData & rd) { return get_output(rd.depth_buf_, rd.depth_out_, rd.frame_); }, "Depth image of the kart (memoryview[float] observation_height x observation_width)")
+       .def_property_readonly("instance", [](const PySTKRenderData & rd) { return get_output(rd.instance_buf_, rd.instance_out_, rd.frame_); }, "Instance labels (memoryview[uint32] observation_height x observation_width)")
+       .def("set_output", [](PySTKRenderData & rd, py::object image, py::object depth, py::object instance) {
+            rd.color_out_ = as_outputs(rd.color_buf_, image);
+            rd.depth_out_ = as_outputs(rd.depth_buf_, depth);
+            rd.instance_out_ = as_outputs(rd.instance_buf_, instance);
+        }, py::arg("image") = py::none(), py::arg("depth") = py::none(), py::arg("instance") = py::none(), "Register caller owned numpy arrays, image, depth and instance then write into these arrays instead of allocating new ones. Each argument is None (allocate), an array, or a list of arrays used as a ring buffer (frame i writes into the i % len-th array). The arrays need the dtype and shape of the corresponding property.");
 ;
 //        add_pickle(cls);
     }
@@ -184,26 +242,108 @@ PYBIND11_MODULE(pystk, m) {
         .def(py::init<const PySTKRaceConfig &>(),py::arg("config"))
         .def("restart", &PySTKRace::restart,"Restart the current track. Use this function if the race config does not change, instead of creating a new SuperTuxKart object")
         .def("start", &PySTKRace::start,"start the race")
-        .def("step", (bool (PySTKRace::*)(const std::vector<PySTKAction> &)) &PySTKRace::step, py::arg("action"), "Take a step with an action per agent")
-        .def("step", (bool (PySTKRace::*)(const PySTKAction &)) &PySTKRace::step, py::arg("action"), "Take a step with an action for agent 0")
-        .def("step", (bool (PySTKRace::*)()) &PySTKRace::step, "Take a step without changing the action")
+        .def("step", (bool (PySTKRace::*)(const std::vector<PySTKAction> &)) &PySTKRace::step, py::arg("action"), "Take a step with an action per agent", py::call_guard<py::gil_scoped_release>())
+        .def("step", (bool (PySTKRace::*)(const PySTKAction &)) &PySTKRace::step, py::arg("action"), "Take a step with an action for agent 0", py::call_guard<py::gil_scoped_release>())
+        .def("step", (bool (PySTKRace::*)()) &PySTKRace::step, "Take a step without changing the action", py::call_guard<py::gil_scoped_release>())
         .def("stop", &PySTKRace::stop,"Stop the race")
+        .def("save_state", [](PySTKRace & r) -> py::bytes { return py::bytes(r.saveState()); }, "Snapshot the simulation state of the race into a bytes object. The state can be restored into this race, or into another race with the same config")
+        .def("load_state", [](PySTKRace & r, py::bytes state) { r.loadState(state); }, py::arg("state"), "Restore a state created by save_state. The race needs the same track, karts and mode as the saved one. render_data is updated on the next step")
+        .def("raycast", [](PySTKRace & r, py::array_t<int, py::array::c_style | py::array::forcecast> kart_ids, py::array_t<float, py::array::c_style | py::array::forcecast> directions, float max_dist, bool local) {
+            if (kart_ids.ndim() != 1)
+                throw std::invalid_argument("Expected kart_ids of shape (n_karts,)!");
+            if (directions.ndim() != 2 || directions.shape(1) != 3)
+                throw std::invalid_argument("Expected directions of shape (n_rays, 3)!");
+            const int n_karts = kart_ids.shape(0), n_rays = directions.shape(0);
+            py::array_t<float> distance({n_karts, n_rays});
+            py::array_t<int8_t> hit({n_karts, n_rays});
+            const int * k = kart_ids.data();
+            const float * d = directions.data();
+            float * distance_data = distance.mutable_data();
+            int8_t * hit_data = hit.mutable_data();
+            {
+                py::gil_scoped_release release;
+                r.raycast(k, n_karts, d, n_rays, max_dist, local, distance_data, hit_data);
+            }
+            return py::make_tuple(distance, hit);
+        }, py::arg("kart_ids"), py::arg("directions"), py::arg("max_dist") = 50.f, py::arg("local") = true, "Cast a ray along each of directions (float array of shape (n_rays, 3)) from the center of each kart in kart_ids. Directions are in the kart frame if local, in world coordinates otherwise. Returns the hit distance (ndarray[float] n_karts x n_rays, max_dist if nothing is hit) and what was hit (ndarray[int8] n_karts x n_rays, see RayHit). Rays ignore the kart they start from and run in parallel.")
         .def_property_readonly("render_data", &PySTKRace::render_data, "rendering data from the last step")
         .def_property_readonly("last_action", &PySTKRace::last_action, "the last action the agent took")
         .def_property_readonly("config", &PySTKRace::config,"The current race configuration");
     }
+    {
+        py::class_<PySTKBatchRace, std::shared_ptr<PySTKBatchRace> >(m, "BatchRace", "A batch of SuperTuxKart races stepped with a single call")
+        .def(py::init<const std::vector<PySTKRaceConfig> &>(), py::arg("configs"), "Create one race per config. All configs need the same number of players.")
+        .def("restart", &PySTKBatchRace::restart, "Restart all races")
+        .def("start", &PySTKBatchRace::start, "Start all races")
+        .def("step", [](PySTKBatchRace & b, py::array_t<float, py::array::c_style | py::array::forcecast> actions) {
+            if (actions.ndim() != 3 || actions.shape(0) != b.size() || actions.shape(1) != b.n_players() || actions.shape(2) != PySTKAction::N_FLOATS)
+                throw std::invalid_argument("Expected actions of shape ("+std::to_string(b.size())+", "+std::to_string(b.n_players())+", "+std::to_string(PySTKAction::N_FLOATS)+")!");
+            const float * a = actions.data();
+            {
+                py::gil_scoped_release release;
+                b.step(a);
+            }
+            return b.done();
+        }, py::arg("actions"), "Take a step in all races. actions is a float array of shape (len(races), n_players, 7) holding steer, acceleration, brake, nitro, drift, rescue, fire per player (boolean fields are on if > 0.5). Returns the done flag of each race. With pystk_headless the races step in parallel.")
+        .def("step", [](PySTKBatchRace & b) {
+            {
+                py::gil_scoped_release release;
+                b.step(nullptr);
+            }
+            return b.done();
+        }, "Take a step in all races without changing the actions")
+        .def("stop", &PySTKBatchRace::stop, "Stop all races")
+        .def("__len__", &PySTKBatchRace::size)
+        .def_property_readonly("races", &PySTKBatchRace::races, "The individual races")
+        .def_property_readonly("done", &PySTKBatchRace::done, "Done flag of each race after the last step (ndarray[bool] len(races))")
+        .def_property_readonly("image", &PySTKBatchRace::image, "Color images of all players (ndarray[uint8] len(races) x n_players x observation_height x observation_width x 3), updated in place by step")
+        .def_property_readonly("depth", &PySTKBatchRace::depth, "Depth images of all players (ndarray[float] len(races) x n_players x observation_height x observation_width), updated in place by step")
+        .def_property_readonly("instance", &PySTKBatchRace::instance, "Instance labels of all players (ndarray[uint32] len(races) x n_players x observation_height x observation_width), updated in place by step");
+    }
     
     m.def("list_tracks", &PySTKRace::listTracks, "Return a list of track names (possible values for RaceConfig.track)");
     m.def("list_karts", &PySTKRace::listKarts, "Return a list of karts to play as (possible values for PlayerConfig.kart");
+    m.def("set_track_cache_size", &TrackCache::setMaxEntries, py::arg("size"), "Set how many loaded tracks keep their graph and collision meshes in memory after a race, so the next race on the same track, mode and direction loads faster. 0 disables the cache. Default 8.");
+    m.def("clear_track_cache", &TrackCache::clear, "Free all cached tracks that are not used by a running race");
+    m.def("set_kart_model_cache_size", &KartPropertiesManager::setMaxLoadedModels, py::arg("size"), "Set how many karts keep their models and textures loaded when no race uses them. Kart models are only loaded when a race uses the kart, the least recently used ones are unloaded first. Default 16.");
+    
+    {
+        py::module prof = m.def_submodule("profiler", "Run-time profiler of the simulation and rendering");
+        prof.def("enable", []() { profiler.setEnabled(true); }, "Start recording timings. Recording is off by default and costs close to nothing while off.");
+        prof.def("disable", []() { profiler.setEnabled(false); }, "Stop recording timings, recorded timings are kept");
+        prof.def("is_enabled", []() { return profiler.isEnabled(); }, "Are timings recorded?");
+        prof.def("reset", []() { profiler.reset(); }, "Remove all recorded timings");
+        prof.def("steps", []() { return profiler.getFrames(); }, "Number of race steps recorded since the last reset (summed over all races)");
+        prof.def("timings", []() {
+            py::dict r;
+            const unsigned long steps = profiler.getFrames();
+            for (const auto & t: profiler.getTimings()) {
+                py::dict d;
+                d["count"] = t.second.m_count;
+                d["total"] = t.second.m_total;
+                d["mean"] = t.second.m_total / t.second.m_count;
+                d["max"] = t.second.m_max;
+                d["per_step"] = steps ? t.second.m_total / steps : 0.0;
+                r[py::str(t.first)] = d;
+            }
+            return r;
+        }, "Aggregated timings in ms since the last reset, as dict of marker name to {'count', 'total', 'mean', 'max', 'per_step'}. Includes the update, physics, AI, render and readback of each step, and the GPU timer queries of the rendering passes (prefixed by 'GPU').");
+        prof.def("save_chrome_trace", [](const std::string & filename) {
+            if (!profiler.writeChromeTrace(filename))
+                throw std::invalid_argument("Cannot write trace file '" + filename + "'");
+        }, py::arg("filename"), "Save all recorded markers since the last reset as Chrome trace (JSON), to be opened in chrome://tracing or Perfetto");
+        prof.def("set_max_trace_events", [](size_t n) { profiler.setMaxTraceEvents(n); }, py::arg("n"), "Maximum number of markers kept for the trace, further markers are only aggregated. Default 1048576.");
+    }
     
     // Initialize SuperTuxKart
-    m.def("init", &path_and_init, py::arg("config"), "Initialize Python SuperTuxKart. Only call this function once per process. Calling it twice will cause a crash.");
+    m.def("init", &path_and_init, py::arg("config"), "Initialize Python SuperTuxKart. Only call this function once per process. Calling it twice will cause a crash. Several races can run in the process after a single init.");
     m.def("clean", &PySTKRace::clean, "Free Python SuperTuxKart, call this once at exit (optional). Will be called atexit otherwise.");
     
     auto atexit = py::module::import("atexit");
         atexit.attr("register")(py::cpp_function([]() {
             // A bit ugly
-            PySTKRace::running_kart = nullptr;
+            PySTKRace::n_running = 0;
+            PySTKRace::n_rendering = 0;
             PySTKRace::clean();
         }));
 }
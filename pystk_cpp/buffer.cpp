@@ -1,8 +1,13 @@
 #include "buffer.hpp"
 #include "graphics/gl_headers.hpp"
 #include "utils/log.hpp"
-#include "util.hpp"
+#include "graphics/central_settings.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
 
+#ifndef SERVER_ONLY
 int n_channel(int format) {
     switch(format) {
     case GL_DEPTH_COMPONENT: return 1;
@@ -37,9 +42,24 @@ BasicPBO::BasicPBO(int width, int height, int format, int type): width_(width),
     size_ = width*height*n_channel(format)*type_size(type);
     glGenBuffers(1, &buffer_id_);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer_id_);
-    glBufferData(GL_PIXEL_PACK_BUFFER, size_, NULL, GL_STREAM_COPY);
+    if (CVS->isARBBufferStorageUsable()) {
+        // Map once and keep the mapping, reads then go straight from the driver's memory
+        const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_PIXEL_PACK_BUFFER, size_, NULL, flags);
+        mapped_ = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size_, flags);
+    } else {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size_, NULL, GL_STREAM_COPY);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 BasicPBO::~BasicPBO() {
+    if (fence_)
+        glDeleteSync((GLsync)fence_);
+    if (mapped_) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer_id_);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
     glDeleteBuffers(1, &buffer_id_);
 }
 void BasicPBO::read(GLuint texture) {
@@ -51,15 +71,44 @@ void BasicPBO::read(GLuint texture) {
         glGetTexImage(GL_TEXTURE_2D, 0, format_, type_, 0);
     }
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (mapped_) {
+        // A coherent mapping only sees the GPU writes once this fence is signaled
+        if (fence_)
+            glDeleteSync((GLsync)fence_);
+        fence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
 }
-void BasicPBO::write(void * mem) {
+const void * BasicPBO::map() {
+    if (mapped_) {
+        if (fence_) {
+            GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+            while (glClientWaitSync((GLsync)fence_, flags, 1000000000) == GL_TIMEOUT_EXPIRED)
+                flags = 0;
+            glDeleteSync((GLsync)fence_);
+            fence_ = nullptr;
+        }
+        return mapped_;
+    }
     glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer_id_);
-    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, size_, mem);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size_, GL_MAP_READ_BIT);
+}
+void BasicPBO::unmap() {
+    if (!mapped_) {
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+}
+void BasicPBO::writeFlipped(void * mem) {
+    // OpenGL stores the bottom row first, flip while copying instead of in a second pass
+    const uint8_t * src = static_cast<const uint8_t *>(map());
+    if (src) {
+        const size_t row = size_ / height_;
+        uint8_t * dst = static_cast<uint8_t *>(mem);
+        for (int i = 0; i < height_; i++)
+            memcpy(dst + i * row, src + (height_ - 1 - i) * row, row);
+    }
+    unmap();
 }
-
-
-
 py::array make(py::array::ShapeContainer shape, int gl_type) {
     switch(gl_type) {
         case GL_UNSIGNED_BYTE:  return py::array_t<unsigned char, py::array::c_style>(shape);
@@ -87,6 +136,7 @@ void NumpyPBO::read(unsigned int texture)
 {
     BasicPBO::read(texture);
     need_update_ = true;
+    written_ = nullptr;
 }
 
 py::array NumpyPBO::get()
@@ -94,9 +144,52 @@ py::array NumpyPBO::get()
     if (need_update_) {
         // Copy data_ here to preveny any nasty surprises...
         data_ = make(py::array::ShapeContainer(data_.shape(), data_.shape() + data_.ndim()), type_);
-        BasicPBO::write(data_.mutable_data());
-        _yflip(data_.mutable_data(), data_.shape()[0], data_.strides()[0]);
+        BasicPBO::writeFlipped(data_.mutable_data());
+        need_update_ = false;
     }
     return data_;
 }
 
+void NumpyPBO::checkOutput(const py::array & out) const
+{
+    if (!out.dtype().is(data_.dtype()))
+        throw std::invalid_argument("Output array has the wrong dtype, expected "+std::string(py::str(data_.dtype()))+"!");
+    if (out.ndim() != data_.ndim() || !std::equal(out.shape(), out.shape() + out.ndim(), data_.shape()))
+        throw std::invalid_argument("Output array has the wrong shape!");
+    if (!(out.flags() & py::array::c_style) || !out.writeable())
+        throw std::invalid_argument("Output array needs to be writeable and C contiguous!");
+}
+
+py::array NumpyPBO::get(py::array out)
+{
+    if (written_ != out.data()) {
+        checkOutput(out);
+        BasicPBO::writeFlipped(out.mutable_data());
+        written_ = out.data();
+    }
+    return out;
+}
+
+void NumpyPBO::copyTo(void * mem)
+{
+    BasicPBO::writeFlipped(mem);
+}
+
+#else
+// pystk_headless has no GL context. Races never create buffers, these only
+// exist such that the bindings link.
+BasicPBO::BasicPBO(int width, int height, int format, int type): width_(width), height_(height), format_(format), type_(type) {
+    throw std::logic_error("pystk_headless cannot render!");
+}
+BasicPBO::~BasicPBO() {}
+void BasicPBO::read(unsigned int texture) {}
+const void * BasicPBO::map() { return nullptr; }
+void BasicPBO::unmap() {}
+void BasicPBO::writeFlipped(void * mem) {}
+NumpyPBO::NumpyPBO(int width, int height, int format, int type): BasicPBO(width, height, format, type) {}
+void NumpyPBO::read(unsigned int texture) {}
+py::array NumpyPBO::get() { return data_; }
+py::array NumpyPBO::get(py::array out) { return out; }
+void NumpyPBO::copyTo(void * mem) {}
+void NumpyPBO::checkOutput(const py::array & out) const {}
+#endif   // !SERVER_ONLY
@@ -6,21 +6,35 @@ class BasicPBO {
 protected:
     unsigned int buffer_id_;
     int width_, height_, format_, type_, size_;
+    // Persistently mapped buffer contents (nullptr if buffer storage is not available)
+    void * mapped_ = nullptr;
+    // Signaled once the last read finished on the GPU
+    void * fence_ = nullptr;
+    const void * map();
+    void unmap();
     BasicPBO(BasicPBO&) = delete;
     BasicPBO& operator=(BasicPBO&) = delete;
 public:
     BasicPBO(int width, int height, int format, int type);
     virtual void read(unsigned int texture);
-    virtual void write(void * mem);
+    // Copy the last read into mem, storing the rows top to bottom
+    virtual void writeFlipped(void * mem);
     virtual ~BasicPBO();
 };
 
 class NumpyPBO: public BasicPBO {
 protected:
-    bool need_update_;
+    bool need_update_ = false;
     py::array data_;
+    // The last output array written by get(out)
+    const void * written_ = nullptr;
 public:
     NumpyPBO(int width, int height, int format, int type);
     virtual void read(unsigned int texture);
     virtual py::array get();
+    // Write the current frame into a caller owned array (no allocation)
+    virtual py::array get(py::array out);
+    virtual void copyTo(void * mem);
+    // Check if out can be used with get(out), throws std::invalid_argument otherwise
+    void checkOutput(const py::array & out) const;
 };
@@ -64,6 +64,12 @@ void pickle(std::ostream & s, const PySTKRaceConfig & o) {
     pickle(s, o.seed);
     pickle(s, o.num_kart);
     pickle(s, o.step_size);
+    pickle(s, o.render_latency);
+    pickle(s, o.observation_width);
+    pickle(s, o.observation_height);
+    pickle(s, (uint32_t)o.observations.size());
+    for (const auto & n: o.observations)
+        pickle(s, n);
 }
 void unpickle(std::istream & s, PySTKRaceConfig * o) {
     unpickle(s, &o->difficulty);
@@ -74,6 +80,17 @@ void unpickle(std::istream & s, PySTKRaceConfig * o) {
     unpickle(s, &o->seed);
     unpickle(s, &o->num_kart);
     unpickle(s, &o->step_size);
+    unpickle(s, &o->render_latency);
+    unpickle(s, &o->observation_width);
+    unpickle(s, &o->observation_height);
+    uint32_t n_observations;
+    unpickle(s, &n_observations);
+    o->observations.clear();
+    for (uint32_t i = 0; i < n_observations; i++) {
+        std::string n;
+        unpickle(s, &n);
+        o->observations.insert(n);
+    }
 }
 void pickle(std::ostream & s, const PySTKAction & o) {
     pickle(s, o.steering_angle);
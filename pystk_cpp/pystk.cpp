@@ -50,6 +50,7 @@
 #include "graphics/camera.hpp"
 #include "graphics/central_settings.hpp"
 #include "graphics/frame_buffer.hpp"
+#include "graphics/glwrap.hpp"
 #include "graphics/graphics_restrictions.hpp"
 #include "graphics/irr_driver.hpp"
 #include "graphics/material_manager.hpp"
@@ -78,6 +79,7 @@
 #include "scriptengine/property_animator.hpp"
 #include "tracks/arena_graph.hpp"
 #include "tracks/track.hpp"
+#include "tracks/track_cache.hpp"
 #include "tracks/track_manager.hpp"
 #include "utils/command_line.hpp"
 #include "utils/constants.hpp"
@@ -86,7 +88,10 @@
 #include "utils/log.hpp"
 #include "utils/mini_glm.hpp"
 #include "utils/profiler.hpp"
+#include "utils/state_buffer.hpp"
+#include "utils/stk_process.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/thread_pool.hpp"
 #include "utils/objecttype.h"
 #include "util.hpp"
 #include "buffer.hpp"
@@ -145,139 +150,199 @@ const PySTKGraphicsConfig & PySTKGraphicsConfig::ld() {
     return config;
 }
 
+#ifdef SERVER_ONLY
+// Without a GL context races have no render targets
+class PySTKRenderTarget {
+public:
+    void reset() {}
+};
+#else
 class PySTKRenderTarget {
     friend class PySTKRace;
 
 private:
-    const int BUF_SIZE = 2;
+    // Frames in flight: the one handed out, the latency ones still read back and the new one
+    const int latency_, BUF_SIZE;
     std::unique_ptr<RenderTarget> rt_;
     std::vector<std::shared_ptr<NumpyPBO> > color_buf_, depth_buf_, instance_buf_;
-    int buf_num_=0;
+    int buf_num_=0, n_read_=0;
+
+    // Downsampling to the observation size, only used if it differs from the render size
+    struct Level { unsigned int texture; int width, height; };
+    int obs_width_, obs_height_;
+    unsigned int read_fbo_ = 0, draw_fbo_ = 0;
+    // Successive halvings of the color image, the last level has the observation size
+    std::vector<Level> color_levels_;
+    unsigned int depth_tex_ = 0, label_tex_ = 0;
+    void downsample(RTT * rtts);
 
 protected:
     void render(irr::scene::ICameraSceneNode* camera, float dt);
     void fetch(std::shared_ptr<PySTKRenderData> data);
+    // Forget frames in flight, the next fetch hands out its own frame
+    void reset() { n_read_ = 0; }
     
 public:
-    PySTKRenderTarget(std::unique_ptr<RenderTarget>&& rt);
+    PySTKRenderTarget(std::unique_ptr<RenderTarget>&& rt, const PySTKRaceConfig & config);
+    ~PySTKRenderTarget();
     
 };
+#endif   // SERVER_ONLY
+
+namespace {
+// Closest hit of a ray that ignores the kart it starts from
+struct KartRayResult : public btCollisionWorld::ClosestRayResultCallback {
+    const btCollisionObject * me;
+    KartRayResult(const btVector3 & from, const btVector3 & to, const btCollisionObject * me)
+        : btCollisionWorld::ClosestRayResultCallback(from, to), me(me) {}
+    virtual bool needsCollision(btBroadphaseProxy* proxy) const override {
+        return proxy->m_clientObject != me && btCollisionWorld::ClosestRayResultCallback::needsCollision(proxy);
+    }
+};
+// Collects all collision objects whose AABB overlaps a query box
+struct CollectObjects : public btBroadphaseAabbCallback {
+    std::vector<btCollisionObject*> objects;
+    virtual bool process(const btBroadphaseProxy* proxy) override {
+        objects.push_back((btCollisionObject*)proxy->m_clientObject);
+        return true;
+    }
+};
+PySTKRayHit rayHitType(const btCollisionObject * object) {
+    const UserPointer * up = (const UserPointer*)object->getUserPointer();
+    if (!up) return PySTKRayHit::NONE;
+    if (up->is(UserPointer::UP_TRACK)) return PySTKRayHit::TRACK;
+    if (up->is(UserPointer::UP_KART)) return PySTKRayHit::KART;
+    if (up->is(UserPointer::UP_FLYABLE)) return PySTKRayHit::FLYABLE;
+    if (up->is(UserPointer::UP_PHYSICAL_OBJECT)) return PySTKRayHit::PHYSICAL_OBJECT;
+    if (up->is(UserPointer::UP_ANIMATION)) return PySTKRayHit::ANIMATION;
+    return PySTKRayHit::NONE;
+}
+}
 
-Kart::Kart(int number)
-    : m_kart(World::getWorld()->getPlayerKart(number))
-{
+#ifndef SERVER_ONLY
+// Races render at up to this multiple of the observation size, the image is then halved with linear filtering
+static const int OBSERVATION_SUPERSAMPLING = 2;
+static unsigned int makeTexture(int width, int height, GLint internal_format, GLint format, GLint type) {
+    GLuint result;
+    glGenTextures(1, &result);
+    glBindTexture(GL_TEXTURE_2D, result);
+    if (CVS->isARBTextureStorageUsable())
+        glTexStorage2D(GL_TEXTURE_2D, 1, internal_format, width, height);
+    else
+        glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return result;
+}
+static void blitTexture(GLuint read_fbo, GLuint draw_fbo, GLenum attachment, GLbitfield mask, GLenum filter,
+                        GLuint src, int src_width, int src_height, GLuint dst, int dst_width, int dst_height) {
+    const bool color = attachment == GL_COLOR_ATTACHMENT0;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, read_fbo);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, attachment, GL_TEXTURE_2D, src, 0);
+    glReadBuffer(color ? GL_COLOR_ATTACHMENT0 : GL_NONE);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_fbo);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, attachment, GL_TEXTURE_2D, dst, 0);
+    glDrawBuffer(color ? GL_COLOR_ATTACHMENT0 : GL_NONE);
+    glBlitFramebuffer(0, 0, src_width, src_height, 0, 0, dst_width, dst_height, mask, filter);
+    // Detach again, the same FBOs are used for color, depth and labels
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, attachment, GL_TEXTURE_2D, 0, 0);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, attachment, GL_TEXTURE_2D, 0, 0);
 }
 
-void Kart::getSurroundings()
-{
-	int radius = 5;
-	// means that there is a ray for every 10 degrees
-	// This is a sphere, so we're shooting on polar coordinates likely
-	three_array array;
-    const Vec3 cart_xyz = m_kart->getXYZ();
-
-	for (int theta=0; theta <= 360; theta += 10) {
-		for (int omega=0; omega <= 360; omega+= 10) {
-			float x = radius * cos(omega) * sin(theta);
-			float y = radius * sin(omega) * sin(theta);
-			float z = radius * cos(theta);
-
-			Vec3 my_vec;
-
-			my_vec[0] = x + cart_xyz[0];
-			my_vec[1] = x + cart_xyz[1];
-			my_vec[2] = x + cart_xyz[2];
-
-			btCollisionWorld::ClosestRayResultCallback ray_callback(cart_xyz,
-									       	my_vec);
-            Physics::get()->getPhysicsWorld()->rayTest(cart_xyz, my_vec, ray_callback);
-
-            // Physics::get()->getPhysicsWorld()->rayTest(cart_xyz, my_vec, ray_callback);
-
-			if(ray_callback.hasHit()) {
-				float distance = abs(sqrt(pow(cart_xyz[0] - my_vec[0], 2) +
-							  pow(cart_xyz[1] - my_vec[1], 2) +
-							  pow(cart_xyz[2] - my_vec[2], 2)));
-
-				for (int i=0; i<radius; i++) {
-					if (distance < i) {
-						array[theta][omega][i] = 0;
-					}
-					else {
-						btCollisionObject* hit_object = ray_callback.m_collisionObject;
-						const UserPointer *upA = (UserPointer*)(hit_object->getUserPointer());
-
-						// 1) object A is a track
-						// =======================
-						if(upA->is(UserPointer::UP_TRACK))
-						{
-							array[theta][omega][i] = 1;
-						}
-						// 2) object a is a kart
-						// =====================
-						else if(upA->is(UserPointer::UP_KART))
-						{
-							array[theta][omega][i] = 2;
-						}
-						// 3) object is a projectile
-						// =========================
-						else if(upA->is(UserPointer::UP_FLYABLE))
-						{
-							array[theta][omega][i] = 3;
-						}
-						// Object is a physical object
-						// ===========================
-						else if(upA->is(UserPointer::UP_PHYSICAL_OBJECT))
-						{
-							array[theta][omega][i] = 4;
-						}
-						else if (upA->is(UserPointer::UP_ANIMATION))
-						{
-							array[theta][omega][i] = 5;
-						}
-						else
-						    assert("Unknown user pointer");           // 4) Should never happen
-					}
-				}
-
-			}
-			else {
-				for (int i=0; i<radius; i++) {
-					array[theta][omega][i] = 0;
-				}
-			}
-		} // for omega
-	} // for theta
-}
-
-PySTKRenderTarget::PySTKRenderTarget(std::unique_ptr<RenderTarget>&& rt):rt_(std::move(rt)) {
-    int W = rt_->getTextureSize().Width, H = rt_->getTextureSize().Height;
+PySTKRenderTarget::PySTKRenderTarget(std::unique_ptr<RenderTarget>&& rt, const PySTKRaceConfig & config):latency_(std::max(config.render_latency, 0)), BUF_SIZE(std::max(config.render_latency, 0) + 2), rt_(std::move(rt)) {
+    int RW = rt_->getTextureSize().Width, RH = rt_->getTextureSize().Height;
+    obs_width_ = config.observation_width > 0 ? config.observation_width : RW;
+    obs_height_ = config.observation_height > 0 ? config.observation_height : RH;
+    int W = obs_width_, H = obs_height_;
     buf_num_ = 0;
+    // Outputs that are not observed get no PBO (nullptr) and are never read back
+    const bool image = config.observes("image"), depth = config.observes("depth"), instance = config.observes("instance");
+    if (rt_->getRTTs() && (W != RW || H != RH) && (image || depth || instance)) {
+        glGenFramebuffers(1, &read_fbo_);
+        glGenFramebuffers(1, &draw_fbo_);
+        if (image) {
+            // Halve with linear filtering (a 2x2 box filter) while the image is at least twice the
+            // observation size, a single linear blit from far away would alias
+            int w = RW, h = RH;
+            while (w >= 2 * W && h >= 2 * H) {
+                w /= 2;
+                h /= 2;
+                if (w != W || h != H)
+                    color_levels_.push_back({makeTexture(w, h, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE), w, h});
+            }
+            color_levels_.push_back({makeTexture(W, H, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE), W, H});
+        }
+        // Depth and labels can not be averaged, they are sampled (nearest) such that instance ids stay valid
+        if (depth)
+            depth_tex_ = makeTexture(W, H, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8);
+        if (instance)
+            label_tex_ = makeTexture(W, H, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT);
+    }
     for(int i=0; i<BUF_SIZE; i++) {
-        color_buf_.push_back(std::make_shared<NumpyPBO>(W, H, GL_RGB, GL_UNSIGNED_BYTE));
-        depth_buf_.push_back(std::make_shared<NumpyPBO>(W, H, GL_DEPTH_COMPONENT, GL_FLOAT));
-        instance_buf_.push_back(std::make_shared<NumpyPBO>(W, H, GL_RED_INTEGER, GL_UNSIGNED_INT));
+        color_buf_.push_back(image ? std::make_shared<NumpyPBO>(W, H, GL_RGB, GL_UNSIGNED_BYTE) : nullptr);
+        depth_buf_.push_back(depth ? std::make_shared<NumpyPBO>(W, H, GL_DEPTH_COMPONENT, GL_FLOAT) : nullptr);
+        instance_buf_.push_back(instance ? std::make_shared<NumpyPBO>(W, H, GL_RED_INTEGER, GL_UNSIGNED_INT) : nullptr);
     }
+    // Without instance labels there is no need for the track label pass
+    if (rt_->getRTTs())
+        rt_->getRTTs()->setRenderLabels(instance);
+}
+PySTKRenderTarget::~PySTKRenderTarget() {
+    for (const auto & l: color_levels_)
+        glDeleteTextures(1, &l.texture);
+    if (depth_tex_) glDeleteTextures(1, &depth_tex_);
+    if (label_tex_) glDeleteTextures(1, &label_tex_);
+    if (read_fbo_) glDeleteFramebuffers(1, &read_fbo_);
+    if (draw_fbo_) glDeleteFramebuffers(1, &draw_fbo_);
 }
 void PySTKRenderTarget::render(irr::scene::ICameraSceneNode* camera, float dt) {
     rt_->renderToTexture(camera, dt);
 }
+void PySTKRenderTarget::downsample(RTT * rtts) {
+    // glBlitFramebuffer is clipped by the scissor box
+    GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    GLuint src = rtts->getRenderTarget(RTT_COLOR);
+    int sw = rtts->getWidth(), sh = rtts->getHeight();
+    for (const auto & l: color_levels_) {
+        blitTexture(read_fbo_, draw_fbo_, GL_COLOR_ATTACHMENT0, GL_COLOR_BUFFER_BIT, GL_LINEAR, src, sw, sh, l.texture, l.width, l.height);
+        src = l.texture;
+        sw = l.width;
+        sh = l.height;
+    }
+    if (depth_tex_)
+        blitTexture(read_fbo_, draw_fbo_, GL_DEPTH_STENCIL_ATTACHMENT, GL_DEPTH_BUFFER_BIT, GL_NEAREST, rtts->getDepthStencilTexture(), rtts->getWidth(), rtts->getHeight(), depth_tex_, obs_width_, obs_height_);
+    if (label_tex_)
+        blitTexture(read_fbo_, draw_fbo_, GL_COLOR_ATTACHMENT0, GL_COLOR_BUFFER_BIT, GL_NEAREST, rtts->getRenderTarget(RTT_LABEL), rtts->getWidth(), rtts->getHeight(), label_tex_, obs_width_, obs_height_);
+    glBindFramebuffer(GL_FRAMEBUFFER, irr_driver->getDefaultFramebuffer());
+    if (scissor)
+        glEnable(GL_SCISSOR_TEST);
+}
 void PySTKRenderTarget::fetch(std::shared_ptr<PySTKRenderData> data) {
     RTT * rtts = rt_->getRTTs();
     if (rtts && data) {
-        unsigned int W = rtts->getWidth(), H = rtts->getHeight();
-        // Read the color and depth image
-        data->color_buf_ = color_buf_[buf_num_];
-        data->depth_buf_ = depth_buf_[buf_num_];
-        data->instance_buf_ = instance_buf_[buf_num_];
-        
-        data->depth_buf_->read(rtts->getDepthStencilTexture());
-        data->color_buf_->read(rtts->getRenderTarget(RTT_COLOR));
-        data->instance_buf_->read(rtts->getRenderTarget(RTT_LABEL));
+        if (read_fbo_)
+            downsample(rtts);
+        // Start the (asynchronous) read of the color, depth and instance image
+        if (depth_buf_[buf_num_])
+            depth_buf_[buf_num_]->read(depth_tex_ ? depth_tex_ : rtts->getDepthStencilTexture());
+        if (color_buf_[buf_num_])
+            color_buf_[buf_num_]->read(color_levels_.size() ? color_levels_.back().texture : rtts->getRenderTarget(RTT_COLOR));
+        if (instance_buf_[buf_num_])
+            instance_buf_[buf_num_]->read(label_tex_ ? label_tex_ : rtts->getRenderTarget(RTT_LABEL));
+        n_read_++;
+
+        // Hand out the frame read latency_ steps ago, it is most likely done by now.
+        // Before that many frames exist the oldest one is used.
+        int h = (buf_num_ + BUF_SIZE - std::min(latency_, n_read_ - 1)) % BUF_SIZE;
+        data->color_buf_ = color_buf_[h];
+        data->depth_buf_ = depth_buf_[h];
+        data->instance_buf_ = instance_buf_[h];
+        data->frame_++;
         buf_num_ = (buf_num_+1) % BUF_SIZE;
     }
     
 }
+#endif   // !SERVER_ONLY
 
 
 void PySTKAction::set(KartControl * control) const {
@@ -298,19 +363,43 @@ void PySTKAction::get(const KartControl * control) {
     steering_angle = control->getSteer();
     drift = control->getSkidControl() != KartControl::SC_NONE;
 }
+void PySTKAction::load(const float * v) {
+    steering_angle = v[0];
+    acceleration = v[1];
+    brake = v[2] > 0.5f;
+    nitro = v[3] > 0.5f;
+    drift = v[4] > 0.5f;
+    rescue = v[5] > 0.5f;
+    fire = v[6] > 0.5f;
+}
 
-PySTKRace * PySTKRace::running_kart = 0;
+int PySTKRace::n_running = 0;
+int PySTKRace::n_rendering = 0;
+std::shared_timed_mutex PySTKRace::engine_mutex;
+// Locks engine_mutex to change the state all races share
+typedef std::unique_lock<std::shared_timed_mutex> EngineLock;
+// Locks engine_mutex for calls that only read the shared state
+typedef std::shared_lock<std::shared_timed_mutex> SharedEngineLock;
+#ifdef SERVER_ONLY
+// Headless races step in parallel
+typedef SharedEngineLock StepLock;
+#else
+// Steps create GL resources (e.g. the draw call of a rubber band), GL calls cannot be made in parallel
+typedef EngineLock StepLock;
+#endif
 static int is_init = 0;
 #ifdef RENDERDOC
 static RENDERDOC_API_1_1_2 *rdoc_api = NULL;
 #endif
 void PySTKRace::init(const PySTKGraphicsConfig & config) {
-    if (running_kart)
+    EngineLock lock(engine_mutex);
+    if (n_running)
         throw std::invalid_argument("Cannot init while supertuxkart is running!");
     if (is_init) {
         throw std::invalid_argument("PySTK already initialized! Call clean first!");
     } else {
         is_init = 1;
+        STKProcess::reset();
         initUserConfig();
         stk_config->load(file_manager->getAsset("stk_config.xml"));
         initGraphicsConfig(config);
@@ -339,9 +428,11 @@ void PySTKRace::init(const PySTKGraphicsConfig & config) {
 #endif
 }
 void PySTKRace::clean() {
-    if (running_kart)
+    EngineLock lock(engine_mutex);
+    if (n_running)
         throw std::invalid_argument("Cannot clean up while supertuxkart is running!");
     if (is_init) {
+        STKProcess::reset();
         cleanSuperTuxKart();
         Log::flushBuffers();
 
@@ -350,20 +441,79 @@ void PySTKRace::clean() {
         is_init = 0;
     }
 }
-bool PySTKRace::isRunning() { return running_kart; }
+bool PySTKRace::isRunning() { return n_running > 0; }
+/** Make the simulation slot of this race the one of the calling thread. All
+ *  world, track, physics and race manager lookups then resolve to this race.
+ *  The slot stays bound after the call returns, such that WorldState and
+ *  Track read the race that was last used on this thread.
+ *  Must be called with engine_mutex held, and with mutex_ held if it is
+ *  only held shared.
+ */
+void PySTKRace::bindSlot() const {
+    STKProcess::init(PT_MAIN, slot_);
+}
 PySTKRace::PySTKRace(const PySTKRaceConfig & config) {
-    if (running_kart)
-        throw std::invalid_argument("Cannot run more than one supertux instance per process!");
     if (!is_init)
         throw std::invalid_argument("PySTK not initialized yet! Call pystk.init().");
-    running_kart = this;
-    
-    resetObjectId();
-    
-    setupConfig(config);
-    for(int i=0; i<config.players.size(); i++)
-        render_targets_.push_back( std::make_unique<PySTKRenderTarget>(irr_driver->createRenderTarget( {(unsigned int)UserConfigParams::m_width, (unsigned int)UserConfigParams::m_height}, "player"+std::to_string(i))) );
+    for (const auto & o: config.observations)
+        if (o != "image" && o != "depth" && o != "instance")
+            throw std::invalid_argument("Unknown observation '"+o+"', use 'image', 'depth' or 'instance'!");
+    if (config.observation_width < 0 || config.observation_height < 0)
+        throw std::invalid_argument("Observation size cannot be negative!");
+    EngineLock lock(engine_mutex);
+#ifdef SERVER_ONLY
+    const bool render = false;
+#else
+    const bool render = config.render;
+#endif
+    // All races load their scene, lights, sky and fog into the one irrlicht scene, a rendering race would draw the other races
+    if (n_rendering > 0)
+        throw std::invalid_argument("Cannot create another race while a race with render=True is running!");
+    if (render && n_running > 0)
+        throw std::invalid_argument("A race with render=True cannot run next to other races, delete them first!");
+    slot_ = STKProcess::acquireSlot();
+    if (slot_ >= STK_MAX_PROCESS_SLOTS)
+        throw std::invalid_argument("Cannot run more than "+std::to_string(STK_MAX_PROCESS_SLOTS - PT_COUNT)+" supertux instances per process!");
+    n_running++;
+    rendering_ = render;
+    if (rendering_) n_rendering++;
     
+    try {
+        bindSlot();
+        RaceManager::create();
+        ProjectileManager::create();
+        resetObjectId();
+        
+        setupConfig(config);
+#ifndef SERVER_ONLY
+        // Render at a multiple of the observation size that fits the screen, at most OBSERVATION_SUPERSAMPLING
+        const int W = observation_width(), H = observation_height();
+        const int S = std::max(1, std::min({OBSERVATION_SUPERSAMPLING, (int)UserConfigParams::m_width / W, (int)UserConfigParams::m_height / H}));
+        const irr::core::dimension2du render_size(S * W, S * H);
+#endif
+        for(int i=0; i<config.players.size(); i++) {
+            // Create the render data up front, such that outputs can be registered before the first step
+            render_data_.push_back( std::make_shared<PySTKRenderData>() );
+#ifndef SERVER_ONLY
+            // A race that does not render never reads its render targets
+            if (!rendering_) continue;
+            render_targets_.push_back( std::make_unique<PySTKRenderTarget>(irr_driver->createRenderTarget(render_size, "player"+std::to_string(i)), config) );
+            render_data_[i]->color_buf_ = render_targets_[i]->color_buf_[0];
+            render_data_[i]->depth_buf_ = render_targets_[i]->depth_buf_[0];
+            render_data_[i]->instance_buf_ = render_targets_[i]->instance_buf_[0];
+#endif
+        }
+    } catch (...) {
+        // The destructor does not run for a race that failed to construct
+        release();
+        throw;
+    }
+}
+int PySTKRace::observation_width() const {
+    return config_.observation_width > 0 ? config_.observation_width : (int)UserConfigParams::m_width;
+}
+int PySTKRace::observation_height() const {
+    return config_.observation_height > 0 ? config_.observation_height : (int)UserConfigParams::m_height;
 }
 std::vector<std::string> PySTKRace::listTracks() {
     if (track_manager)
@@ -375,8 +525,25 @@ std::vector<std::string> PySTKRace::listKarts() {
         return kart_properties_manager->getAllAvailableKarts();
     return std::vector<std::string>();
 }
+/** Frees the managers and the slot of this race. Used by the destructor and
+ *  if the constructor fails. Must be called with engine_mutex held.
+ */
+void PySTKRace::release() {
+    bindSlot();
+    render_targets_.clear();
+    if (World::getWorld())
+        RaceManager::get()->exitRace();
+    ProjectileManager::destroy();
+    RaceManager::destroy();
+    // Do not leave the thread bound to a slot that can be handed out again
+    STKProcess::reset();
+    STKProcess::releaseSlot(slot_);
+    n_running--;
+    if (rendering_) n_rendering--;
+}
 PySTKRace::~PySTKRace() {
-    running_kart = nullptr;
+    EngineLock lock(engine_mutex);
+    release();
 }
 
 class LocalPlayerAIController: public Controller {
@@ -389,6 +556,8 @@ public:
     }
     virtual void  reset              ()
     { ai_controller_->reset(); }
+    virtual void  decide             (int ticks)
+    { ai_controller_->decide(ticks); }
     virtual void  update             (int ticks)
     { ai_controller_->update(ticks); }
     virtual void  handleZipper       ()
@@ -431,15 +600,21 @@ public:
     { return ai_controller_->finishedRace(time); }
 };
 void PySTKRace::restart() {
+    EngineLock lock(engine_mutex);
+    bindSlot();
     World::getWorld()->reset(true /* restart */);
+    for (auto & rt: render_targets_) rt->reset();
     ItemManager::updateRandomSeed(config_.seed);
     powerup_manager->setRandomSeed(config_.seed);
 }
 
 void PySTKRace::start() {
+    EngineLock lock(engine_mutex);
+    bindSlot();
     RaceManager::get()->setupPlayerKartInfo();
     RaceManager::get()->startNew();
     time_leftover_ = 0.f;
+    for (auto & rt: render_targets_) rt->reset();
     
     for(int i=0; i<config_.players.size(); i++) {
         AbstractKart * player_kart = World::getWorld()->getPlayerKart(i);
@@ -450,50 +625,240 @@ void PySTKRace::start() {
     powerup_manager->setRandomSeed(config_.seed);
 }
 void PySTKRace::stop() {
+    EngineLock lock(engine_mutex);
+    bindSlot();
     render_targets_.clear();
+#ifndef SERVER_ONLY
     if (CVS->isGLSL())
     {
         // Reset screen in case the minimap was drawn
         glViewport(0, 0, irr_driver->getActualScreenSize().Width,
             irr_driver->getActualScreenSize().Height);
     }
+#endif
 
     if (World::getWorld())
     {
         RaceManager::get()->exitRace();
     }
 }
+// Written at the start of every saved state, bump if the layout changes
+static const uint32_t STATE_MAGIC = 0x53544b05;
+// The header identifies the race a state belongs to, it is checked before anything is restored
+static void saveStateHeader(StateBuffer * buffer) {
+    World * world = World::getWorld();
+    buffer->add<uint32_t>(STATE_MAGIC);
+    buffer->addString(Track::getCurrentTrack()->getIdent());
+    buffer->add<int>(RaceManager::get()->getMinorMode());
+    buffer->add<uint32_t>(world->getNumKarts());
+    for (unsigned int i = 0; i < world->getNumKarts(); i++)
+        buffer->addString(world->getKart(i)->getIdent());
+}
+static void checkStateHeader(StateBuffer * buffer) {
+    World * world = World::getWorld();
+    if (buffer->get<uint32_t>() != STATE_MAGIC)
+        throw std::invalid_argument("Not a saved race state");
+    if (buffer->getString() != Track::getCurrentTrack()->getIdent())
+        throw std::invalid_argument("Saved state is for a different track");
+    if (buffer->get<int>() != RaceManager::get()->getMinorMode())
+        throw std::invalid_argument("Saved state is for a different race mode");
+    if (buffer->get<uint32_t>() != world->getNumKarts())
+        throw std::invalid_argument("Saved state has a different number of karts");
+    for (unsigned int i = 0; i < world->getNumKarts(); i++)
+        if (buffer->getString() != world->getKart(i)->getIdent())
+            throw std::invalid_argument("Saved state has different karts");
+}
+std::string PySTKRace::saveState() {
+    SharedEngineLock lock(engine_mutex);
+    std::lock_guard<std::mutex> race_lock(mutex_);
+    bindSlot();
+    World * world = World::getWorld();
+    if (!world) throw std::invalid_argument("Race not started, call start() first");
+    StateBuffer buffer;
+    saveStateHeader(&buffer);
+    buffer.add<float>(time_leftover_);
+    world->saveState(&buffer);
+    return buffer.getData();
+}
+void PySTKRace::loadState(const std::string & state) {
+    StepLock lock(engine_mutex);
+    std::lock_guard<std::mutex> race_lock(mutex_);
+    bindSlot();
+    World * world = World::getWorld();
+    if (!world) throw std::invalid_argument("Race not started, call start() first");
+    StateBuffer buffer(state);
+    try {
+        checkStateHeader(&buffer);
+    } catch (std::runtime_error &) {
+        // A truncated header
+        throw std::invalid_argument("Not a saved race state");
+    }
+    // The body can still be truncated or written by a different build, keep the current state to roll back to
+    StateBuffer backup;
+    world->saveState(&backup);
+    try {
+        float time_leftover = buffer.get<float>();
+        world->restoreState(&buffer);
+        if (!buffer.atEnd())
+            throw std::invalid_argument("Saved state does not match this race");
+        time_leftover_ = time_leftover;
+    } catch (...) {
+        StateBuffer rollback(backup.getData());
+        world->restoreState(&rollback);
+        throw;
+    }
+    last_action_.resize(config_.players.size());
+    for(int i=0; i<last_action_.size(); i++)
+        last_action_[i].get(&world->getPlayerKart(i)->getControls());
+}
+// Number of rays of one kart handled by a single task
+static const int RAYS_PER_TASK = 64;
+void PySTKRace::raycast(const int * kart_ids, int n_karts, const float * directions, int n_rays, float max_dist, bool local, float * distance, int8_t * hit) {
+    SharedEngineLock lock(engine_mutex);
+    std::lock_guard<std::mutex> race_lock(mutex_);
+    bindSlot();
+    World * world = World::getWorld();
+    if (!world) throw std::invalid_argument("Race not started, call start() first");
+    if (!(max_dist > 0)) throw std::invalid_argument("max_dist needs to be positive");
+    for(int k=0; k<n_karts; k++)
+        if (kart_ids[k] < 0 || kart_ids[k] >= (int)world->getNumKarts())
+            throw std::invalid_argument("Invalid kart id " + std::to_string(kart_ids[k]));
+
+    btDynamicsWorld * physics_world = Physics::get()->getPhysicsWorld();
+
+    // All objects a kart can see are gathered with a single broadphase query,
+    // individual rays then only test the (few) candidates they pass through.
+    std::vector<const AbstractKart*> karts(n_karts);
+    std::vector<std::vector<btCollisionObject*> > candidates(n_karts);
+    for(int k=0; k<n_karts; k++) {
+        karts[k] = world->getKart(kart_ids[k]);
+        const btVector3 & from = karts[k]->getXYZ();
+        const btVector3 range(max_dist, max_dist, max_dist);
+        CollectObjects collect;
+        physics_world->getBroadphase()->aabbTest(from - range, from + range, collect);
+        for(btCollisionObject * o: collect.objects)
+            if (o != karts[k]->getBody())
+                candidates[k].push_back(o);
+    }
+
+    const int tasks_per_kart = (n_rays + RAYS_PER_TASK - 1) / RAYS_PER_TASK;
+    ThreadPool::get()->parallelFor(n_karts * tasks_per_kart, [&](unsigned int task) {
+        const int k = task / tasks_per_kart, r0 = (task % tasks_per_kart) * RAYS_PER_TASK;
+        const int r1 = std::min(r0 + RAYS_PER_TASK, n_rays);
+        const btTransform & trans = karts[k]->getTrans();
+        const btVector3 & from = trans.getOrigin();
+        for(int r=r0; r<r1; r++) {
+            btVector3 dir(directions[3*r], directions[3*r+1], directions[3*r+2]);
+            float & d = distance[k*n_rays+r];
+            int8_t & h = hit[k*n_rays+r];
+            d = max_dist;
+            h = (int8_t)PySTKRayHit::NONE;
+            if (dir.length2() == 0) continue;
+            dir.normalize();
+            if (local) dir = trans.getBasis() * dir;
+            const btVector3 to = from + dir * max_dist;
+
+            btVector3 inv_dir;
+            for(int i=0; i<3; i++)
+                inv_dir[i] = dir[i] == 0 ? btScalar(BT_LARGE_FLOAT) : 1 / dir[i];
+            unsigned int sign[3] = {inv_dir[0] < 0, inv_dir[1] < 0, inv_dir[2] < 0};
+            btTransform ray_from, ray_to;
+            ray_from.setIdentity(); ray_from.setOrigin(from);
+            ray_to.setIdentity(); ray_to.setOrigin(to);
+
+            KartRayResult result(from, to, karts[k]->getBody());
+            for(btCollisionObject * o: candidates[k]) {
+                const btBroadphaseProxy * proxy = o->getBroadphaseHandle();
+                const btVector3 aabb[2] = {proxy->m_aabbMin, proxy->m_aabbMax};
+                btScalar t_min = 1;
+                // Skip objects the ray misses, or that are behind the closest hit so far
+                if (!btRayAabb2(from, inv_dir, sign, aabb, t_min, 0, max_dist * result.m_closestHitFraction))
+                    continue;
+                if (!result.needsCollision(const_cast<btBroadphaseProxy*>(proxy)))
+                    continue;
+                btCollisionWorld::rayTestSingle(ray_from, ray_to, o, o->getCollisionShape(), o->getWorldTransform(), result);
+            }
+            if (result.hasHit()) {
+                d = result.m_closestHitFraction * max_dist;
+                h = (int8_t)rayHitType(result.m_collisionObject);
+            }
+        }
+    });
+}
+#ifndef SERVER_ONLY
+// Keeps the renderer in multi-view mode for its lifetime, also if rendering a view throws
+struct MultiViewScope {
+    MultiViewScope(float dt, const std::vector<irr::scene::ICameraSceneNode*> & cameras) { irr_driver->beginMultiView(dt, cameras); }
+    ~MultiViewScope() { irr_driver->endMultiView(); }
+};
+#endif
 void PySTKRace::render(float dt) {
+#ifndef SERVER_ONLY
     World *world = World::getWorld();
 
     if (world)
     {
-        // Render all views
-        for(unsigned int i = 0; i < Camera::getNumCameras() && i < render_targets_.size(); i++) {
-            Camera::getCamera(i)->activate(false);
-            render_targets_[i]->render(Camera::getCamera(i)->getCameraSceneNode(), dt);
+        // Render all views, animations, lighting, particles and the shadow map are shared between them
+        {
+            std::vector<irr::scene::ICameraSceneNode*> cameras;
+            for(unsigned int i = 0; i < Camera::getNumCameras() && i < render_targets_.size(); i++)
+                cameras.push_back(Camera::getCamera(i)->getCameraSceneNode());
+            MultiViewScope multi_view(dt, cameras);
+            for(unsigned int i = 0; i < cameras.size(); i++) {
+                Camera::getCamera(i)->activate(false);
+                render_targets_[i]->render(Camera::getCamera(i)->getCameraSceneNode(), dt);
+            }
         }
         while (render_data_.size() < render_targets_.size()) render_data_.push_back( std::make_shared<PySTKRenderData>() );
         // Fetch all views
-        for(unsigned int i = 0; i < render_targets_.size(); i++) {
-            render_targets_[i]->fetch(render_data_[i]);
+        {
+            ProfilerScope readback_marker("PySTK::render (readback)", 0x00, 0x40, 0x7F);
+            for(unsigned int i = 0; i < render_targets_.size(); i++) {
+                render_targets_[i]->fetch(render_data_[i]);
+            }
+        }
+        // Collect the GPU timer queries that finished
+        if (profiler.isEnabled()) {
+            for(unsigned int q = 0; q < Q_LAST; q++) {
+                GPUTimer & timer = irr_driver->getGPUTimer(q);
+                if (!timer.isQueryPending()) continue;
+                unsigned int us = timer.elapsedTimeus();
+                if (!timer.isQueryPending())
+                    profiler.addTime(std::string("GPU ") + timer.getName(), us / 1000.0);
+            }
         }
     }
+#endif
 }
 
 bool PySTKRace::step(const std::vector<PySTKAction> & a) {
+    StepLock lock(engine_mutex);
+    std::lock_guard<std::mutex> race_lock(mutex_);
+    bindSlot();
     for(int i=0; i<a.size(); i++) {
         KartControl & control = World::getWorld()->getPlayerKart(i)->getControls();
         a[i].set(&control);
     }
-    return step();
+    return update();
 }
 bool PySTKRace::step(const PySTKAction & a) {
+    StepLock lock(engine_mutex);
+    std::lock_guard<std::mutex> race_lock(mutex_);
+    bindSlot();
     KartControl & control = World::getWorld()->getPlayerKart(0)->getControls();
     a.set(&control);
-    return step();
+    return update();
 }
 bool PySTKRace::step() {
+    StepLock lock(engine_mutex);
+    std::lock_guard<std::mutex> race_lock(mutex_);
+    bindSlot();
+    return update();
+}
+/** Advances the race by one step. Must be called with the locks of step()
+ *  held and the slot bound.
+ */
+bool PySTKRace::update() {
     const float dt = config_.step_size;
     if (!World::getWorld()) return false;
     
@@ -501,29 +866,38 @@ bool PySTKRace::step() {
     if(rdoc_api) rdoc_api->StartFrameCapture(NULL, NULL);
 #endif
 
-    // Update first
-    time_leftover_ += dt;
-    int ticks = stk_config->time2Ticks(time_leftover_);
-    time_leftover_ -= stk_config->ticks2Time(ticks);
-    for(int i=0; i<ticks; i++) {
-        World::getWorld()->updateWorld(1);
-        World::getWorld()->updateTime(1);
-    }
-    last_action_.resize(config_.players.size());
-    for(int i=0; i<last_action_.size(); i++)
-        last_action_[i].get(&World::getWorld()->getPlayerKart(i)->getControls());
-    
-    PropertyAnimator::get()->update(dt);
-    
-    // Then render
-    if (config_.render) {
-        World::getWorld()->updateGraphics(dt);
+    {
+        // The scopes pop their markers even if a step throws
+        ProfilerScope step_marker("PySTK::step", 0x00, 0x00, 0x7F);
+        // Update first
+        {
+            ProfilerScope update_marker("PySTK::step (update)", 0x00, 0x20, 0x7F);
+            time_leftover_ += dt;
+            int ticks = stk_config->time2Ticks(time_leftover_);
+            time_leftover_ -= stk_config->ticks2Time(ticks);
+            for(int i=0; i<ticks; i++) {
+                World::getWorld()->updateWorld(1);
+                World::getWorld()->updateTime(1);
+            }
+            last_action_.resize(config_.players.size());
+            for(int i=0; i<last_action_.size(); i++)
+                last_action_[i].get(&World::getWorld()->getPlayerKart(i)->getControls());
+
+            PropertyAnimator::get()->update(dt);
+        }
 
-        irr_driver->minimalUpdate(dt);
-        render(dt);
-    } else {
-        World::getWorld()->updateGraphicsMinimal(dt);
+        // Then render
+        ProfilerScope render_marker("PySTK::step (render)", 0x00, 0x30, 0x7F);
+        if (config_.render) {
+            World::getWorld()->updateGraphics(dt);
+
+            irr_driver->minimalUpdate(dt);
+            render(dt);
+        } else {
+            World::getWorld()->updateGraphicsMinimal(dt);
+        }
     }
+    PROFILER_SYNC_FRAME();
 
     if (config_.render && !irr_driver->getDevice()->run())
         return false;
@@ -536,8 +910,10 @@ bool PySTKRace::step() {
 void PySTKRace::load() {
     
     material_manager->loadMaterial();
+#ifndef SERVER_ONLY
     // Preload the explosion effects (explode.png)
     ParticleKindManager::get()->getParticles("explosion.xml");
+#endif
 
     // Reading the rest of the player data needs the unlock manager to
     // initialise the game slots of all players and the AchievementsManager
@@ -580,6 +956,10 @@ static RaceManager::MinorRaceModeType translate_mode(PySTKRaceConfig::RaceMode m
 
 void PySTKRace::setupConfig(const PySTKRaceConfig & config) {
     config_ = config;
+#ifdef SERVER_ONLY
+    // Nothing can be rendered without a GL context
+    config_.render = false;
+#endif
     RaceManager::get()->setDifficulty(RaceManager::Difficulty(config.difficulty));
     RaceManager::get()->setMinorMode(translate_mode(config.mode));
     RaceManager::get()->setNumPlayers(config.players.size());
@@ -654,7 +1034,9 @@ void PySTKRace::initRest()
 
     font_manager = new FontManager();
     font_manager->loadFonts();
+#ifndef SERVER_ONLY
     SP::loadShaders();
+#endif
 
     // The order here can be important, e.g. KartPropertiesManager needs
     // defaultKartProperties, which are defined in stk_config.
@@ -709,6 +1091,7 @@ void PySTKRace::cleanSuperTuxKart()
     ProjectileManager::destroy();
     if(kart_properties_manager) delete kart_properties_manager;
     kart_properties_manager = nullptr;
+    TrackCache::clear();
     if(track_manager)           delete track_manager;
     track_manager = nullptr;
     if(material_manager)        delete material_manager;
@@ -744,3 +1127,132 @@ void PySTKRace::cleanUserConfig()
     if(irr_driver)              delete irr_driver;
     irr_driver = nullptr;
 }   // cleanUserConfig
+
+//=============================================================================
+/** Creates one race per config. All races need the same number of players,
+ *  such that actions and observations can be stacked into single arrays.
+ *  The observation arrays are allocated once here and overwritten by step().
+ */
+PySTKBatchRace::PySTKBatchRace(const std::vector<PySTKRaceConfig> & configs) {
+    if (configs.empty())
+        throw std::invalid_argument("BatchRace needs at least one RaceConfig!");
+    n_players_ = configs[0].players.size();
+    bool render = false;
+    for (const auto & c: configs) {
+        if ((int)c.players.size() != n_players_)
+            throw std::invalid_argument("All races in a BatchRace need the same number of players!");
+        render = render || c.render;
+    }
+#ifdef SERVER_ONLY
+    render = false;
+#endif
+    // See PySTKRace::PySTKRace, a rendering race needs the scene to itself
+    if (render && configs.size() > 1)
+        throw std::invalid_argument("A BatchRace with render=True can only hold a single race!");
+    for (const auto & c: configs)
+        races_.push_back(std::make_shared<PySTKRace>(c));
+
+    const ssize_t K = races_.size(), P = n_players_;
+    done_ = py::array_t<bool>(K);
+    done_ptr_ = done_.mutable_data();
+    std::fill(done_ptr_, done_ptr_ + K, false);
+    // Only allocate the outputs at least one race observes
+    bool image = false, depth = false, instance = false;
+    for (const auto & c: configs) {
+        image = image || c.observes("image");
+        depth = depth || c.observes("depth");
+        instance = instance || c.observes("instance");
+    }
+    std::shared_ptr<PySTKRace> first = races_[0];
+    for (const auto & r: races_)
+        if (r->config().render) { first = r; break; }
+    const ssize_t H = first->observation_height(), W = first->observation_width();
+    for (const auto & r: races_)
+        if (r->config().render && (r->observation_width() != W || r->observation_height() != H))
+            throw std::invalid_argument("All rendering races in a BatchRace need the same observation size!");
+    if (image) {
+        image_ = py::array_t<uint8_t>({K, P, H, W, (ssize_t)3});
+        image_ptr_ = image_.mutable_data();
+        std::fill(image_ptr_, image_ptr_ + image_.size(), 0);
+    }
+    if (depth) {
+        depth_ = py::array_t<float>({K, P, H, W});
+        depth_ptr_ = depth_.mutable_data();
+        std::fill(depth_ptr_, depth_ptr_ + depth_.size(), 0.f);
+    }
+    if (instance) {
+        instance_ = py::array_t<uint32_t>({K, P, H, W});
+        instance_ptr_ = instance_.mutable_data();
+        std::fill(instance_ptr_, instance_ptr_ + instance_.size(), 0);
+    }
+}   // PySTKBatchRace
+
+// ----------------------------------------------------------------------------
+PySTKBatchRace::~PySTKBatchRace() {
+    races_.clear();
+}   // ~PySTKBatchRace
+
+// ----------------------------------------------------------------------------
+void PySTKBatchRace::restart() {
+    for (auto & r: races_) r->restart();
+    std::fill(done_ptr_, done_ptr_ + races_.size(), false);
+}   // restart
+
+// ----------------------------------------------------------------------------
+void PySTKBatchRace::start() {
+    for (auto & r: races_) r->start();
+    std::fill(done_ptr_, done_ptr_ + races_.size(), false);
+}   // start
+
+// ----------------------------------------------------------------------------
+void PySTKBatchRace::stop() {
+    for (auto & r: races_) r->stop();
+}   // stop
+
+// ----------------------------------------------------------------------------
+/** Copies the render data of race k into its slice of the stacked arrays. */
+void PySTKBatchRace::fetch(int k) {
+    const auto & data = races_[k]->render_data();
+    const ssize_t H = races_[k]->observation_height(), W = races_[k]->observation_width();
+    for (int p = 0; p < n_players_ && p < (int)data.size(); p++) {
+        if (!data[p]) continue;
+        const ssize_t o = (ssize_t)k * n_players_ + p;
+        if (data[p]->color_buf_)
+            data[p]->color_buf_->copyTo(image_ptr_ + o * H * W * 3);
+        if (data[p]->depth_buf_)
+            data[p]->depth_buf_->copyTo(depth_ptr_ + o * H * W);
+        if (data[p]->instance_buf_)
+            data[p]->instance_buf_->copyTo(instance_ptr_ + o * H * W);
+    }
+}   // fetch
+
+// ----------------------------------------------------------------------------
+/** Steps all races once. Does not touch any python object, so it may (and
+ *  should) be called without holding the GIL.
+ *  In pystk_headless the races are stepped in parallel on the global
+ *  ThreadPool, each task binds the slot of its race (see PySTKRace::step).
+ *  Steps of the GL build create GL resources, which only the thread owning
+ *  the context may do, so there the races are stepped one after the other
+ *  on the calling thread.
+ */
+void PySTKBatchRace::step(const float * actions) {
+    const int K = races_.size();
+    auto step_race = [&](unsigned int k) {
+        if (actions) {
+            std::vector<PySTKAction> a(n_players_);
+            for (int p = 0; p < n_players_; p++)
+                a[p].load(actions + ((size_t)k * n_players_ + p) * PySTKAction::N_FLOATS);
+            done_ptr_[k] = !races_[k]->step(a);
+        } else {
+            done_ptr_[k] = !races_[k]->step();
+        }
+    };
+#ifdef SERVER_ONLY
+    ThreadPool::get()->parallelFor(K, step_race);
+#else
+    for (int k = 0; k < K; k++) {
+        step_race(k);
+        if (races_[k]->config().render) fetch(k);
+    }
+#endif
+}   // step
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
 #include <vector>
 #include "buffer.hpp"
 
@@ -50,12 +55,22 @@ struct PySTKRaceConfig {
 	int num_kart = 1;
 	float step_size = 0.1;
 	bool render = true;
+	// Number of frames render_data lags behind the simulation (0 = current frame)
+	int render_latency = 0;
+	// Size of the render outputs, 0 uses the screen size. Downsampled on the GPU before the readback.
+	int observation_width = 0, observation_height = 0;
+	// Render outputs to read back, any of "image", "depth" and "instance"
+	std::set<std::string> observations = {"image", "depth", "instance"};
+	bool observes(const std::string & name) const { return render && observations.count(name); }
 };
 
 class PySTKRenderTarget;
 
 struct PySTKRenderData {
     std::shared_ptr<NumpyPBO> color_buf_, depth_buf_, instance_buf_;
+    // Optional caller owned outputs, frame i is written to *_out_[i % size]
+    std::vector<py::array> color_out_, depth_out_, instance_out_;
+    unsigned int frame_ = 0;
 };
 
 class KartControl;
@@ -69,24 +84,22 @@ struct PySTKAction {
 	bool drift = false;
 	bool rescue = false;
 	bool fire = false;
+	// Number of floats in a flat action (see load)
+	static const int N_FLOATS = 7;
 	void set(KartControl * control) const;
 	void get(const KartControl * control);
+	// Read steer, acceleration, brake, nitro, drift, rescue, fire from a float array
+	void load(const float * v);
 };
 
-// Note: it would likely be easier to just define this here
-// radius = 5
-typedef std::array<std::array<std::array<int, 36>, 36>, 5> three_array;
-class AbstractKart;
-
-class Kart {
-public:
-    Kart(int kart_number);
-
-    void getSurroundings();
-
-private:
-    AbstractKart *m_kart;
-	
+// What a ray of PySTKRace::raycast hit
+enum class PySTKRayHit: int8_t {
+	NONE = 0,
+	TRACK,
+	KART,
+	FLYABLE,
+	PHYSICAL_OBJECT,
+	ANIMATION,
 };
 
 class PySTKRace {
@@ -98,7 +111,12 @@ protected: // Static methods
 	static void cleanUserConfig();
 
 public: // Static methods
-	static PySTKRace * running_kart;
+	static int n_running;
+	// Number of running races with render=True, at most one and only if it is the only race
+	static int n_rendering;
+	// Held exclusively to init, create, start, restart, stop and destroy races, since these load into or free the state all races share.
+	// Headless steps, raycasts and save_state only hold it shared, they touch the slot of their race and the (thread safe) scene graph.
+	static std::shared_timed_mutex engine_mutex;
 	static void init(const PySTKGraphicsConfig & config);
 	static void load();
 	static void clean();
@@ -107,14 +125,21 @@ public: // Static methods
 	static std::vector<std::string> listKarts();
 
 protected:
+	void bindSlot() const;
+	void release();
 	void setupConfig(const PySTKRaceConfig & config);
 	void setupRaceStart();
 	void render(float dt);
+	bool update();
 	std::vector<std::unique_ptr<PySTKRenderTarget> > render_targets_;
 	std::vector<std::shared_ptr<PySTKRenderData> > render_data_;
 	PySTKRaceConfig config_;
 	float time_leftover_ = 0;
 	std::vector<PySTKAction> last_action_;
+	unsigned int slot_;
+	bool rendering_ = false;
+	// Serializes calls into this race while engine_mutex is only held shared
+	std::mutex mutex_;
 
 public:
 	PySTKRace(const PySTKRace &) = delete;
@@ -127,7 +152,49 @@ public:
 	bool step(const PySTKAction &);
 	bool step();
 	void stop();
+	std::string saveState();
+	void loadState(const std::string & state);
+	// Cast n_rays rays from each of the n_karts karts, directions is a contiguous (n_rays, 3) array.
+	// distance and hit are (n_karts, n_rays) outputs, rays that hit nothing return max_dist and NONE.
+	void raycast(const int * kart_ids, int n_karts, const float * directions, int n_rays, float max_dist, bool local, float * distance, int8_t * hit);
 	const std::vector<std::shared_ptr<PySTKRenderData> > & render_data() const { return render_data_; }
 	const std::vector<PySTKAction> & last_action() const { return last_action_; }
 	const PySTKRaceConfig & config() const { return config_; }
+	int observation_width() const;
+	int observation_height() const;
+};
+
+class PySTKBatchRace {
+protected:
+	std::vector<std::shared_ptr<PySTKRace> > races_;
+	int n_players_ = 0;
+	// Preallocated outputs, updated in place by step
+	py::array_t<bool> done_;
+	py::array_t<uint8_t> image_;
+	py::array_t<float> depth_;
+	py::array_t<uint32_t> instance_;
+	bool * done_ptr_ = nullptr;
+	uint8_t * image_ptr_ = nullptr;
+	float * depth_ptr_ = nullptr;
+	uint32_t * instance_ptr_ = nullptr;
+	void fetch(int k);
+
+public:
+	PySTKBatchRace(const PySTKBatchRace &) = delete;
+	PySTKBatchRace& operator=(const PySTKBatchRace &) = delete;
+	PySTKBatchRace(const std::vector<PySTKRaceConfig> & configs);
+	~PySTKBatchRace();
+	void restart();
+	void start();
+	// actions is a contiguous (size, n_players, PySTKAction::N_FLOATS) array, or nullptr to keep the last action
+	void step(const float * actions);
+	void stop();
+	int size() const { return races_.size(); }
+	int n_players() const { return n_players_; }
+	const std::vector<std::shared_ptr<PySTKRace> > & races() const { return races_; }
+	const py::array_t<bool> & done() const { return done_; }
+	// The stacked outputs, None if no race observes them
+	py::object image() const { return image_ptr_ ? py::object(image_) : py::none(); }
+	py::object depth() const { return depth_ptr_ ? py::object(depth_) : py::none(); }
+	py::object instance() const { return instance_ptr_ ? py::object(instance_) : py::none(); }
 };
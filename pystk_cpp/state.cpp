@@ -60,6 +60,11 @@ void pickle(std::ostream & s, const PyWorldState & o);
 void unpickle(std::istream & s, PyWorldState * o);
 // End AUTO Generated
 
+// WorldColumns holds numpy arrays and is pickled by hand
+struct PyWorldColumns;
+void pickle(std::ostream & s, const PyWorldColumns & o);
+void unpickle(std::istream & s, PyWorldColumns * o);
+
 typedef std::array<float, 3> PyVec3;
 typedef std::array<float, 4> PyQuaternion;
 
@@ -658,6 +663,165 @@ struct PyWorldState {
 	}
 };
 
+/* Columnar variant of WorldState. All values are written into numpy arrays
+ * that are reused between calls, so update() does not allocate anything
+ * unless the number of karts or items changes. */
+struct PyWorldColumns {
+	enum KartColumn {
+		K_ID = 0, K_PLAYER_ID,
+		K_LOCATION_X, K_LOCATION_Y, K_LOCATION_Z,
+		K_ROTATION_X, K_ROTATION_Y, K_ROTATION_Z, K_ROTATION_W,
+		K_FRONT_X, K_FRONT_Y, K_FRONT_Z,
+		K_VELOCITY_X, K_VELOCITY_Y, K_VELOCITY_Z,
+		K_SIZE_X, K_SIZE_Y, K_SIZE_Z,
+		K_SHIELD_TIME, K_RACE_RESULT, K_JUMPING,
+		K_FINISHED_LAPS, K_LAP_TIME, K_FINISH_TIME,
+		K_OVERALL_DISTANCE, K_DISTANCE_DOWN_TRACK,
+		K_MAX_STEER_ANGLE, K_WHEEL_BASE, K_LIVES,
+		K_ATTACHMENT_TYPE, K_ATTACHMENT_TIME_LEFT,
+		K_POWERUP_TYPE, K_POWERUP_NUM,
+		NUM_KART_COLUMNS
+	};
+	static std::vector<std::string> kartColumns() {
+		return {"id", "player_id",
+		        "location_x", "location_y", "location_z",
+		        "rotation_x", "rotation_y", "rotation_z", "rotation_w",
+		        "front_x", "front_y", "front_z",
+		        "velocity_x", "velocity_y", "velocity_z",
+		        "size_x", "size_y", "size_z",
+		        "shield_time", "race_result", "jumping",
+		        "finished_laps", "lap_time", "finish_time",
+		        "overall_distance", "distance_down_track",
+		        "max_steer_angle", "wheel_base", "lives",
+		        "attachment_type", "attachment_time_left",
+		        "powerup_type", "powerup_num"};
+	}
+	enum ItemColumn {
+		I_LOCATION_X = 0, I_LOCATION_Y, I_LOCATION_Z, I_SIZE,
+		NUM_ITEM_COLUMNS
+	};
+	static std::vector<std::string> itemColumns() {
+		return {"location_x", "location_y", "location_z", "size"};
+	}
+
+	float time = 0;
+	py::array_t<float> karts = py::array_t<float>(py::array::ShapeContainer({0, (int)NUM_KART_COLUMNS}));
+	py::array_t<float> items = py::array_t<float>(py::array::ShapeContainer({0, (int)NUM_ITEM_COLUMNS}));
+	py::array_t<int32_t> item_ids = py::array_t<int32_t>(py::array::ShapeContainer({0, 2}));
+	py::array_t<float> ball = py::array_t<float>(py::array::ShapeContainer({4}));
+	// Scratch list of valid items, kept to avoid reallocating on every update
+	std::vector<const Item*> valid_items;
+
+	static void define(py::object m) {
+		py::class_<PyWorldColumns, std::shared_ptr<PyWorldColumns>> c(m, "WorldColumns");
+		c.def(py::init<>())
+#define R(x, d) .def_readonly(#x, &PyWorldColumns::x, d)
+		  R(time, "Game time")
+		  R(karts, "State of karts, one row per kart, columns given by kart_columns (float N x 33)")
+		  R(items, "Location and size of items, columns given by item_columns (float M x 4)")
+		  R(item_ids, "Object id and Item.Type of each row in items (int M x 2)")
+		  R(ball, "Location and diameter of the soccer ball, zero outside of soccer mode (float 4)")
+#undef R
+		 .def_property_readonly_static("kart_columns", [](py::object) { return kartColumns(); }, "Names of the columns of karts")
+		 .def_property_readonly_static("item_columns", [](py::object) { return itemColumns(); }, "Names of the columns of items")
+		 .def("update", &PyWorldColumns::update, "Update the arrays in place with the current world state. The arrays are only reallocated if the number of karts or items changed.")
+		 .def("__repr__", [](const PyWorldColumns &c) { return "<WorldColumns #karts="+std::to_string(c.karts.shape(0))+" #items="+std::to_string(c.items.shape(0))+">"; });
+		add_pickle(c);
+	}
+	void update() {
+		World * w = World::getWorld();
+		if (w) {
+			// One cast per update, not per kart
+			LinearWorld * lw = dynamic_cast<LinearWorld*>(w);
+			SoccerWorld * sw = dynamic_cast<SoccerWorld*>(w);
+			ThreeStrikesBattle * tw = dynamic_cast<ThreeStrikesBattle*>(w);
+			const World::KartList & k = w->getKarts();
+			if (karts.shape(0) != (ssize_t)k.size())
+				karts = py::array_t<float>(py::array::ShapeContainer({(int)k.size(), (int)NUM_KART_COLUMNS}));
+			float * out = karts.mutable_data();
+			int pid = 0;
+			for(unsigned int i=0; i<k.size(); i++, out += NUM_KART_COLUMNS) {
+				const AbstractKart * kart = k[i].get();
+				const btTransform & t = kart->getTrans();
+				const btQuaternion r = t.getRotation();
+				const Vec3 & front = kart->getFrontXYZ();
+				const btVector3 & v = kart->getVelocity();
+				const Attachment * a = kart->getAttachment();
+				const Powerup * p = kart->getPowerup();
+				out[K_ID] = kart->getWorldKartId();
+				out[K_PLAYER_ID] = kart->getController()->isLocalPlayerController() ? pid++ : -1;
+				out[K_LOCATION_X] = t.getOrigin().getX();
+				out[K_LOCATION_Y] = t.getOrigin().getY();
+				out[K_LOCATION_Z] = t.getOrigin().getZ();
+				out[K_ROTATION_X] = r.x();
+				out[K_ROTATION_Y] = r.y();
+				out[K_ROTATION_Z] = r.z();
+				out[K_ROTATION_W] = r.w();
+				out[K_FRONT_X] = front.getX();
+				out[K_FRONT_Y] = front.getY();
+				out[K_FRONT_Z] = front.getZ();
+				out[K_VELOCITY_X] = v.getX();
+				out[K_VELOCITY_Y] = v.getY();
+				out[K_VELOCITY_Z] = v.getZ();
+				out[K_SIZE_X] = kart->getKartWidth();
+				out[K_SIZE_Y] = kart->getKartHeight();
+				out[K_SIZE_Z] = kart->getKartLength();
+				out[K_SHIELD_TIME] = kart->getShieldTime();
+				out[K_RACE_RESULT] = kart->getRaceResult();
+				out[K_JUMPING] = kart->isJumping();
+				out[K_FINISHED_LAPS] = lw ? lw->getFinishedLapsOfKart(i) : 0;
+				out[K_LAP_TIME] = lw ? stk_config->ticks2Time(lw->getTicksAtLapForKart(i)) : 0;
+				out[K_FINISH_TIME] = kart->getFinishTime();
+				out[K_OVERALL_DISTANCE] = lw ? lw->getOverallDistance(i) : 0;
+				out[K_DISTANCE_DOWN_TRACK] = lw ? lw->getDistanceDownTrackForKart(i, true) : 0;
+				out[K_MAX_STEER_ANGLE] = kart->getMaxSteerAngle();
+				out[K_WHEEL_BASE] = kart->getKartProperties()->getWheelBase();
+				out[K_LIVES] = tw ? tw->getKartLife(i) : 0;
+				out[K_ATTACHMENT_TYPE] = a ? (int)a->getType() : (int)Attachment::ATTACH_NOTHING;
+				out[K_ATTACHMENT_TIME_LEFT] = a ? stk_config->ticks2Time(a->getTicksLeft()) : 0;
+				out[K_POWERUP_TYPE] = p ? (int)p->getType() : (int)PowerupManager::POWERUP_NOTHING;
+				out[K_POWERUP_NUM] = p ? p->getNum() : 0;
+			}
+			time = w->getTime();
+			float * b = ball.mutable_data();
+			if (sw) {
+				const Vec3 & bp = sw->getBallPosition();
+				b[0] = bp.getX(); b[1] = bp.getY(); b[2] = bp.getZ();
+				b[3] = sw->getBallDiameter();
+			} else {
+				b[0] = b[1] = b[2] = b[3] = 0;
+			}
+		}
+		ItemManager * im = Track::getCurrentTrack()->getItemManager();
+		valid_items.clear();
+		if (im) {
+			for(unsigned int i=0; i<im->getNumberOfItems(); i++) {
+				const Item * I = static_cast<const Item*>(im->getItem(i));
+				if (PyItem::isValid(I))
+					valid_items.push_back(I);
+			}
+		}
+		if (items.shape(0) != (ssize_t)valid_items.size()) {
+			items = py::array_t<float>(py::array::ShapeContainer({(int)valid_items.size(), (int)NUM_ITEM_COLUMNS}));
+			item_ids = py::array_t<int32_t>(py::array::ShapeContainer({(int)valid_items.size(), 2}));
+		}
+		float * out = items.mutable_data();
+		int32_t * ids = item_ids.mutable_data();
+		for(const Item * I: valid_items) {
+			const Vec3 & xyz = I->getXYZ();
+			const Vec3 * ap = I->getAvoidancePoint(0);
+			out[I_LOCATION_X] = xyz.getX();
+			out[I_LOCATION_Y] = xyz.getY();
+			out[I_LOCATION_Z] = xyz.getZ();
+			out[I_SIZE] = ap ? (xyz - *ap).length() : 1.1f;
+			ids[0] = I->getObjectId();
+			ids[1] = (int)I->getType();
+			out += NUM_ITEM_COLUMNS;
+			ids += 2;
+		}
+	}
+};
+
 // AUTO Generated //
 void pickle(std::ostream & s, const PyAttachment & o) {
     pickle(s, o.type);
@@ -810,6 +974,20 @@ void unpickle(std::istream & s, PyWorldState * o) {
 }
 // End AUTO Generated //
 
+void pickle(std::ostream & s, const PyWorldColumns & o) {
+    pickle(s, o.time);
+    ::pickle(s, o.karts);
+    ::pickle(s, o.items);
+    ::pickle(s, o.item_ids);
+    ::pickle(s, o.ball);
+}
+void unpickle(std::istream & s, PyWorldColumns * o) {
+    unpickle(s, &o->time);
+    unpickle(s, &o->karts);
+    unpickle(s, &o->items);
+    unpickle(s, &o->item_ids);
+    unpickle(s, &o->ball);
+}
 
 
 void defineState(py::object m) {
@@ -823,6 +1001,7 @@ void defineState(py::object m) {
 	PySoccer::define(m);
 	PyFFA::define(m);
 	PyWorldState::define(m);
+	PyWorldColumns::define(m);
 	PyTrack::define(m);
 };
 
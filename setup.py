@@ -45,6 +45,9 @@ class CMakeBuild(build_ext):
             os.path.dirname(self.get_ext_fullpath(ext.name)))
         cmake_args = ['-DCMAKE_LIBRARY_OUTPUT_DIRECTORY=' + extdir,
                       '-DPYTHON_EXECUTABLE=' + sys.executable]
+        if os.environ.get('PYSTK_HEADLESS'):
+            # Builds pystk_headless, physics only without any OpenGL
+            cmake_args += ['-DSERVER_ONLY=ON']
 
         cfg = 'Debug' if self.debug else 'Release'
         build_args = ['--config', cfg]
@@ -21,6 +21,7 @@
 #include "animations/ipo.hpp"
 #include "io/file_manager.hpp"
 #include "io/xml_node.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/vs.hpp"
 
 #include <algorithm>
@@ -106,6 +107,27 @@ void AnimationBase::reset()
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves if the animation is playing (scripts can start and stop it) and
+ *  its current time.
+ *  \param buffer The buffer to append the state to.
+ */
+void AnimationBase::saveState(StateBuffer *buffer) const
+{
+    buffer->add<bool>(m_playing);
+    buffer->add<float>(m_current_time);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState().
+ *  \param buffer The buffer to read the state from.
+ */
+void AnimationBase::restoreState(StateBuffer *buffer)
+{
+    m_playing      = buffer->get<bool>();
+    m_current_time = buffer->get<float>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Updates the time, position and rotation. Called once per frame.
  *  \param dt Time since last call.
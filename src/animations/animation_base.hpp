@@ -31,6 +31,7 @@
 #include "utils/vec3.hpp"
 
 class Ipo;
+class StateBuffer;
 class XMLNode;
 
 /**
@@ -81,9 +82,14 @@ public:
     void         setInitialTransform(const Vec3 &xyz,
                                      const Vec3 &hpr);
     void         reset();
+    void         saveState(StateBuffer *buffer) const;
+    void         restoreState(StateBuffer *buffer);
     // ------------------------------------------------------------------------
     /** Disables or enables an animation. */
     void         setPlaying(bool playing) {m_playing = playing; }
+    // ------------------------------------------------------------------------
+    /** Returns true if the animation is currently playing. */
+    bool         isPlaying() const { return m_playing; }
 
     // ------------------------------------------------------------------------
     float getAnimationDuration() const         { return m_animation_duration; }
@@ -99,6 +99,19 @@ public:
     virtual std::unique_ptr<RenderTarget> createRenderTarget(const irr::core::dimension2du &dimension,
                                                              const std::string &name) = 0;
     virtual void createPostProcessing() {}
+    // ------------------------------------------------------------------------
+    /** Starts rendering several views of the same frame, e.g. one for each
+     *  player. Work that does not depend on the camera is only done once
+     *  until endMultiView() is called, and the views share one shadow map.
+     *  Each view is still rendered in a pass of its own, with its own
+     *  culling and draw calls.
+     *  \param dt Time since the last frame.
+     *  \param cameras The cameras of all views that will be rendered.
+     */
+    virtual void beginMultiView(float dt,
+                        const std::vector<irr::scene::ICameraSceneNode*> &cameras) {}
+    // ------------------------------------------------------------------------
+    virtual void endMultiView() {}
 };
 
 #endif //HEADER_ABSTRACT_RENDERER_HPP
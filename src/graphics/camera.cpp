@@ -40,7 +40,7 @@
 #include <algorithm>
 #include <cmath>
 
-std::vector<Camera*> Camera::m_all_cameras;
+std::vector<Camera*> Camera::m_all_cameras[STK_MAX_PROCESS_SLOTS];
 Camera*              Camera::s_active_camera = NULL;
 Camera::CameraType   Camera::m_default_type  = Camera::CM_TYPE_NORMAL;
 
@@ -53,8 +53,9 @@ Camera* Camera::createCamera(AbstractKart* kart, const int index)
 {
 
     Camera *camera = createCamera(index, m_default_type, kart);
-    m_all_cameras.push_back(camera);
-    std::sort(m_all_cameras.begin(), m_all_cameras.end(),
+    std::vector<Camera*>& all_cameras = getAllCameras();
+    all_cameras.push_back(camera);
+    std::sort(all_cameras.begin(), all_cameras.end(),
         [](const Camera* a, const Camera* b)
         {
             return a->getIndex() < b->getIndex();
@@ -87,9 +88,10 @@ Camera* Camera::createCamera(unsigned int index, CameraType type,
 // ----------------------------------------------------------------------------
 void Camera::changeCamera(unsigned int camera_index, CameraType type)
 {
-    assert(camera_index<m_all_cameras.size());
+    std::vector<Camera*>& all_cameras = getAllCameras();
+    assert(camera_index<all_cameras.size());
 
-    Camera *old_camera = m_all_cameras[camera_index];
+    Camera *old_camera = all_cameras[camera_index];
     // Nothing to do if this is already the right type.
 
     if(old_camera->getType()==type) return;
@@ -97,7 +99,7 @@ void Camera::changeCamera(unsigned int camera_index, CameraType type)
     Camera *new_camera = createCamera(old_camera->getIndex(), type,
                                       old_camera->m_original_kart);
     // Replace the previous camera
-    m_all_cameras[camera_index] = new_camera;
+    all_cameras[camera_index] = new_camera;
     if(s_active_camera == old_camera)
         s_active_camera = new_camera;
     delete old_camera;
@@ -26,6 +26,7 @@
 #include "utils/aligned_array.hpp"
 #include "utils/leak_check.hpp"
 #include "utils/log.hpp"
+#include "utils/stk_process.hpp"
 #include "utils/vec3.hpp"
 
 #include "matrix4.h"
@@ -109,8 +110,15 @@ private:
     float           m_aspect;
 
 
-    /** List of all cameras. */
-    static std::vector<Camera*> m_all_cameras;
+    /** List of all cameras of each simulation slot. */
+    static std::vector<Camera*> m_all_cameras[STK_MAX_PROCESS_SLOTS];
+
+    // ------------------------------------------------------------------------
+    /** Returns the list of all cameras of the current simulation slot. */
+    static std::vector<Camera*>& getAllCameras()
+    {
+        return m_all_cameras[STKProcess::getSlot()];
+    }   // getAllCameras
 
 protected:
     /** The camera scene node. */
@@ -149,11 +157,11 @@ public:
     /** Returns the number of cameras used. */
     static unsigned int getNumCameras()
     {
-        return (unsigned int)m_all_cameras.size(); 
+        return (unsigned int)getAllCameras().size();
     }   // getNumCameras
     // ------------------------------------------------------------------------
     /** Returns a camera. */
-    static Camera *getCamera(unsigned int n) { return m_all_cameras[n]; }
+    static Camera *getCamera(unsigned int n) { return getAllCameras()[n]; }
     // ------------------------------------------------------------------------
     /** Returns the currently active camera. */
     static Camera* getActiveCamera() { return s_active_camera; }
@@ -161,9 +169,10 @@ public:
     /** Remove all cameras. */
     static void removeAllCameras()
     {
-        for(unsigned int i=0; i<m_all_cameras.size(); i++)
-            delete m_all_cameras[i];
-        m_all_cameras.clear();
+        std::vector<Camera*>& all_cameras = getAllCameras();
+        for(unsigned int i=0; i<all_cameras.size(); i++)
+            delete all_cameras[i];
+        all_cameras.clear();
     }   // removeAllCameras
 
     // ========================================================================
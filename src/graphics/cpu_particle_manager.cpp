@@ -22,6 +22,7 @@
 #include "graphics/material.hpp"
 #include "graphics/material_manager.hpp"
 #include "utils/log.hpp"
+#include "utils/thread_pool.hpp"
 
 #include <algorithm>
 
@@ -138,7 +139,8 @@ CPUParticleManager::GLParticle::GLParticle(bool flips)
 CPUParticleManager::CPUParticleManager()
 {
     assert(CVS->isGLSL());
-    
+    m_frame = 0;
+
     const float vertices[] =
     {
         -0.5f, 0.5f, 0.0f, 0.0f,
@@ -187,6 +189,11 @@ void CPUParticleManager::addBillboardNode(scene::IBillboardSceneNode* node)
 // ----------------------------------------------------------------------------
 void CPUParticleManager::generateAll()
 {
+    // The emitters are independent, so they are simulated in parallel into
+    // one buffer each, which are then appended to the buffer of their
+    // material in the same order as before
+    std::vector<STKParticle*> nodes;
+    std::vector<std::vector<CPUParticle>*> generated;
     for (auto& p : m_particles_queue)
     {
         if (p.second.empty())
@@ -195,7 +202,8 @@ void CPUParticleManager::generateAll()
         }
         for (auto& q : p.second)
         {
-            q->generate(&m_particles_generated[p.first]);
+            nodes.push_back(q);
+            generated.push_back(&m_particles_generated[p.first]);
         }
         if (isFlipsMaterial(p.first))
         {
@@ -204,6 +212,25 @@ void CPUParticleManager::generateAll()
                 m_particles_queue.at(p.first)[0]->getMaxCount()));
         }
     }
+    if (m_node_particles.size() < nodes.size())
+        m_node_particles.resize(nodes.size());
+    auto generate_one = [&](unsigned int i)
+    {
+        m_node_particles[i].clear();
+        nodes[i]->generate(&m_node_particles[i], 0.1f,
+                           nodes[i]->simulateInFrame(m_frame));
+    };
+    if (nodes.size() > 1)
+        ThreadPool::get()->parallelFor((unsigned int)nodes.size(),
+                                       generate_one);
+    else if (nodes.size() == 1)
+        generate_one(0);
+    for (unsigned int i = 0; i < nodes.size(); i++)
+    {
+        generated[i]->insert(generated[i]->end(),
+            m_node_particles[i].begin(), m_node_particles[i].end());
+    }
+
     for (auto& p : m_billboards_queue)
     {
         if (p.second.empty())
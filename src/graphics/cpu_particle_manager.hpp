@@ -104,10 +104,18 @@ private:
     std::unordered_map<std::string, std::unique_ptr<GLParticle> >
         m_gl_particles;
 
+    /** The particles generated by each particle node in generateAll(),
+     *  only kept as member to avoid reallocations. */
+    std::vector<std::vector<CPUParticle> > m_node_particles;
+
     std::unordered_map<std::string, Material*> m_material_map;
 
     std::unordered_set<std::string> m_flips_material;
 
+    /** Number of the current frame. Particle nodes visible in several views
+     *  of a frame are only simulated once. */
+    unsigned m_frame;
+
     static GLuint m_particle_quad;
 
     // ------------------------------------------------------------------------
@@ -130,6 +138,10 @@ public:
     // ------------------------------------------------------------------------
     void generateAll();
     // ------------------------------------------------------------------------
+    /** Starts a new frame, particles are simulated again in the next
+     *  generateAll(). */
+    void newFrame()                                             { m_frame++; }
+    // ------------------------------------------------------------------------
     void uploadAll();
     // ------------------------------------------------------------------------
     void drawAll();
@@ -185,6 +185,7 @@ void DrawCalls::parseSceneManager(core::list<scene::ISceneNode*> &List,
 DrawCalls::DrawCalls()
 {
     m_sync = 0;
+    m_multi_view = false;
 } //DrawCalls
 
 // ----------------------------------------------------------------------------
@@ -200,12 +201,15 @@ DrawCalls::~DrawCalls()
 void DrawCalls::prepareDrawCalls(scene::ICameraSceneNode *camnode)
 {
     CPUParticleManager::getInstance()->reset();
+    if (!m_multi_view)
+        CPUParticleManager::getInstance()->newFrame();
     TextBillboardDrawer::reset();
     PROFILER_PUSH_CPU_MARKER("- culling", 0xFF, 0xFF, 0x0);
     SP::prepareDrawCalls();
     parseSceneManager(
         irr_driver->getSceneManager()->getRootSceneNode()->getChildren(),
         camnode);
+    SP::cullObjects();
     SP::handleDynamicDrawCall();
     SP::updateModelMatrix();
     PROFILER_POP_CPU_MARKER();
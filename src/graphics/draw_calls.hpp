@@ -33,6 +33,10 @@ private:
     GLsync                                m_sync;
     std::vector<float>                    m_bounding_boxes;
 
+    /** True while several views of the same frame are rendered, a new
+     *  particle frame is then started by the renderer only once. */
+    bool                                  m_multi_view;
+
     void parseSceneManager(core::list<scene::ISceneNode*> &List,
                            const scene::ICameraSceneNode *cam);
 
@@ -54,6 +58,8 @@ public:
     void renderBoundingBoxes();
 
     void setFenceSync() { m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); }
+
+    void setMultiView(bool multi_view)          { m_multi_view = multi_view; }
 };
 
 #endif   // !SERVER_ONLY
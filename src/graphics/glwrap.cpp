@@ -227,8 +227,26 @@ void initGL()
 
 ScopedGPUTimer::ScopedGPUTimer(GPUTimer &t) : timer(t)
 {
+    if (!profiler.isEnabled()) return;
+    if (!timer.canSubmitQuery) return;
+#ifdef GL_TIME_ELAPSED
+    if (!timer.initialised)
+    {
+        glGenQueries(1, &timer.query);
+        timer.initialised = true;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, timer.query);
+    timer.m_running = true;
+#endif
 }
 ScopedGPUTimer::~ScopedGPUTimer() {
+    // The profiler can be disabled while the query is running
+    if (!timer.m_running) return;
+#ifdef GL_TIME_ELAPSED
+    glEndQuery(GL_TIME_ELAPSED);
+    timer.canSubmitQuery = false;
+    timer.m_running = false;
+#endif
 }
 
 GPUTimer::GPUTimer(const char* name)
@@ -51,16 +51,21 @@ class GPUTimer
     bool initialised;
     unsigned lastResult;
     bool canSubmitQuery;
+    /** True between begin and end of the query in ScopedGPUTimer. */
+    bool m_running;
     const char* m_name;
 public:
     GPUTimer(const char* name);
     unsigned elapsedTimeus();
     const char* getName() const { return m_name; }
+    /** True if a query was submitted and its result was not read yet. */
+    bool isQueryPending() const { return initialised && !canSubmitQuery; }
     void reset()
     {
         initialised = false;
         lastResult = 0;
         canSubmitQuery = true;
+        m_running = false;
     }
 };
 
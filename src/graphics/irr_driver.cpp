@@ -185,8 +185,8 @@ IrrDriver::~IrrDriver()
 #endif
     STKTexManager::getInstance()->kill();
     delete m_wind;
-    delete m_renderer;
 #ifndef SERVER_ONLY
+    delete m_renderer;
     for (unsigned i = 0; i < Q_LAST; i++)
     {
         delete m_perf_query[i];
@@ -1535,13 +1535,21 @@ void IrrDriver::clearLights()
 // ----------------------------------------------------------------------------
 GLuint IrrDriver::getRenderTargetTexture(TypeRTT which)
 {
+#ifdef SERVER_ONLY
+    return 0;
+#else
     return m_renderer->getRenderTargetTexture(which);
+#endif
 }   // getRenderTargetTexture
 
 // ----------------------------------------------------------------------------
 GLuint IrrDriver::getDepthStencilTexture()
 {
+#ifdef SERVER_ONLY
+    return 0;
+#else
     return m_renderer->getDepthStencilTexture();
+#endif
 }   // getDepthStencilTexture
 
 // ----------------------------------------------------------------------------
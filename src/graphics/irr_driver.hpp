@@ -310,13 +310,42 @@ public:
     unsigned int getRealTime() {return m_device->getTimer()->getRealTime(); }
     // ------------------------------------------------------------------------
     /** Use motion blur for a short time */
-    void giveBoost(unsigned int cam_index) { m_renderer->giveBoost(cam_index);}
+    void giveBoost(unsigned int cam_index)
+    {
+#ifndef SERVER_ONLY
+        m_renderer->giveBoost(cam_index);
+#endif
+    }
+    // ------------------------------------------------------------------------
+    /** Starts rendering several views of the same frame to textures, see
+     *  AbstractRenderer::beginMultiView(). */
+    void beginMultiView(float dt,
+                        const std::vector<scene::ICameraSceneNode*> &cameras)
+    {
+#ifndef SERVER_ONLY
+        m_renderer->beginMultiView(dt, cameras);
+#endif
+    }
+    // ------------------------------------------------------------------------
+    void endMultiView()
+    {
+#ifndef SERVER_ONLY
+        m_renderer->endMultiView();
+#endif
+    }
     // ------------------------------------------------------------------------
     inline core::vector3df getWind()  {return m_wind->getWind();}
 
     // -----------------------------------------------------------------------
     /** Returns a pointer to the spherical harmonics coefficients. */
-    inline const SHCoefficients* getSHCoefficients()  {return m_renderer->getSHCoefficients();}
+    inline const SHCoefficients* getSHCoefficients()
+    {
+#ifdef SERVER_ONLY
+        return NULL;
+#else
+        return m_renderer->getSHCoefficients();
+#endif
+    }
     // -----------------------------------------------------------------------
     const core::vector3df& getSunDirection() const { return m_sun_direction; };
     // -----------------------------------------------------------------------
@@ -371,10 +400,17 @@ public:
     void addGlowingNode(scene::ISceneNode *n, float r = 1.0f, float g = 1.0f,
                         float b = 1.0f)
     {
+#ifndef SERVER_ONLY
         m_renderer->addGlowingNode(n, r, g, b);
+#endif
     }
     // ------------------------------------------------------------------------
-    void clearGlowingNodes() { m_renderer->clearGlowingNodes(); }
+    void clearGlowingNodes()
+    {
+#ifndef SERVER_ONLY
+        m_renderer->clearGlowingNodes();
+#endif
+    }
     // ------------------------------------------------------------------------
     void addForcedBloomNode(scene::ISceneNode *n, float power = 1)
     {
@@ -446,7 +482,12 @@ public:
     // ------------------------------------------------------------------------
     const core::vector2df &getCurrentScreenSize() const
     {
+#ifdef SERVER_ONLY
+        static const core::vector2df no_screen(0.0f, 0.0f);
+        return no_screen;
+#else
         return m_renderer->getCurrentScreenSize();
+#endif
     }
     // ------------------------------------------------------------------------
     const core::dimension2du getActualScreenSize() const
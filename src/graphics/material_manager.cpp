@@ -285,6 +285,28 @@ void MaterialManager::addSharedMaterial(const std::string& filename, bool deprec
     m_shared_material_index = (int)m_materials.size();
 }   // addSharedMaterial
 
+//-----------------------------------------------------------------------------
+/** Loads the textures of all materials starting with the given index in
+ *  parallel, e.g. of a track's materials.xml before its geometry is loaded.
+ *  \param first_material Index of the first material to load textures for,
+ *         see getNumMaterials().
+ *  \return The textures of these materials, which must be kept to prevent
+ *          SP::SPTextureManager::removeUnusedTextures() from freeing them.
+ */
+std::vector<std::shared_ptr<SP::SPTexture> >
+    MaterialManager::prefetchTextures(unsigned int first_material)
+{
+#ifndef SERVER_ONLY
+    if (CVS->isGLSL() && first_material < m_materials.size())
+    {
+        std::vector<Material*> materials(m_materials.begin() + first_material,
+                                         m_materials.end());
+        return SP::SPTextureManager::get()->prefetchTextures(materials);
+    }
+#endif
+    return std::vector<std::shared_ptr<SP::SPTexture> >();
+}   // prefetchTextures
+
 //-----------------------------------------------------------------------------
 bool MaterialManager::pushTempMaterial(const std::string& filename, bool deprecated)
 {
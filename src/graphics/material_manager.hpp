@@ -30,10 +30,16 @@ namespace irr
 using namespace irr;
 
 #include <irrlicht.h>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
 
+namespace SP
+{
+    class SPTexture;
+}
+
 class Material;
 class XMLReader;
 class XMLNode;
@@ -82,6 +88,10 @@ public:
     bool      hasMaterial(const std::string& fname);
 
     void      unloadAllTextures();
+    std::vector<std::shared_ptr<SP::SPTexture> >
+              prefetchTextures(unsigned int first_material);
+    unsigned int getNumMaterials() const
+                                 { return (unsigned int)m_materials.size(); }
 
     Material* getDefaultSPMaterial(const std::string& shader_name,
                                    const std::string& layer_one_lc = "",
@@ -129,6 +129,10 @@ public:
         assert(m_frame_buffers[fbo] != NULL);
         return *m_frame_buffers[fbo];
     }
+    /** If false the track label pass is skipped and RTT_LABEL is not
+     *  updated. */
+    void setRenderLabels(bool render_labels) { m_render_labels = render_labels; }
+    bool getRenderLabels() const { return m_render_labels; }
 
 private:
     unsigned m_render_target_textures[RTT_COUNT] = {};
@@ -138,6 +142,8 @@ private:
     unsigned int m_width;
     unsigned int m_height;
 
+    bool m_render_labels = true;
+
     unsigned m_shadow_depth_tex = 0;
     FrameBufferLayer* m_shadow_fbo;
 
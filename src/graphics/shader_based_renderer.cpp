@@ -409,10 +409,11 @@ void ShaderBasedRenderer::renderSceneDeferred(scene::ICameraSceneNode * const ca
     m_lighting_passes.updateLightsInfo(camnode, dt);
     PROFILER_POP_CPU_MARKER();
 
-    // Shadows
-    if (CVS->isShadowEnabled() && hasShadow)
+    // Shadows, the other views of a multi-view frame reuse the shadow map
+    if (CVS->isShadowEnabled() && hasShadow && !SP::sp_reuse_shadow_map)
     {
         renderShadows();
+        SP::sp_reuse_shadow_map = m_multi_view;
     }
 
     glDepthMask(GL_TRUE);
@@ -434,7 +435,7 @@ void ShaderBasedRenderer::renderSceneDeferred(scene::ICameraSceneNode * const ca
         ScopedGPUTimer Timer(irr_driver->getGPUTimer(Q_SOLID_PASS));
         SP::draw(SP::RP_1ST, SP::DCT_NORMAL);
     }
-    {
+    if (m_rtts->getRenderLabels()) {
 		m_rtts->getFBO(FBO_LABEL).bind();
 		
 		GLuint CI[4] = { 0 };
@@ -636,7 +637,7 @@ void ShaderBasedRenderer::renderScene(scene::ICameraSceneNode * const camnode,
         ScopedGPUTimer Timer(irr_driver->getGPUTimer(Q_SOLID_PASS));
         SP::draw(SP::RP_1ST, SP::DCT_NORMAL);
     }
-	if (forceRTT) {
+	if (forceRTT && m_rtts->getRenderLabels()) {
 		m_rtts->getFBO(FBO_LABEL).bind();
 		
 		GLuint CI[4] = { 0 };
@@ -784,6 +785,7 @@ void ShaderBasedRenderer::renderPostProcessing(Camera * const camera,
 ShaderBasedRenderer::ShaderBasedRenderer()
 {
     m_dump_rtt              = false;
+    m_multi_view            = false;
     m_rtts                  = NULL;
     m_skybox                = NULL;
     m_spherical_harmonics   = new SphericalHarmonics(irr_driver->getAmbientLight().toSColor());
@@ -914,6 +916,43 @@ std::unique_ptr<RenderTarget> ShaderBasedRenderer::createRenderTarget(const irr:
     //return std::make_unique<GL3RenderTarget>(dimension, name, this); //require C++14
 }
 
+// ----------------------------------------------------------------------------
+/** Starts rendering several views of the same frame with renderToTexture().
+ *  The scene is animated, the lighting data is uploaded and particles are
+ *  simulated only once for all views, instead of once per view. The shadow
+ *  cascades are fitted once to the union of all view frustums, and the
+ *  shadow map is rendered by the first view and reused by the others.
+ *  Culling and draw call preparation depend on the camera (level of
+ *  detail, frustum), so they are still done for each view.
+ *  \param dt Time since the last frame.
+ *  \param cameras The cameras of all views that will be rendered.
+ */
+void ShaderBasedRenderer::beginMultiView(float dt,
+                        const std::vector<irr::scene::ICameraSceneNode*> &cameras)
+{
+    assert(!m_multi_view);
+    m_multi_view = true;
+    SP::sp_reuse_shadow_map = false;
+    Track *track = Track::getCurrentTrack();
+    if (CVS->isShadowEnabled() && track && track->hasShadows())
+        m_shadow_matrices.fitCascades(cameras);
+    static_cast<scene::CSceneManager *>(irr_driver->getSceneManager())
+        ->OnAnimate(os::Timer::getTime());
+    if (CVS->isARBUniformBufferObjectUsable())
+        uploadLightingData();
+    CPUParticleManager::getInstance()->newFrame();
+    m_draw_calls.setMultiView(true);
+}   // beginMultiView
+
+// ----------------------------------------------------------------------------
+void ShaderBasedRenderer::endMultiView()
+{
+    m_multi_view = false;
+    m_draw_calls.setMultiView(false);
+    m_shadow_matrices.releaseCascades();
+    SP::sp_reuse_shadow_map = false;
+}   // endMultiView
+
 // ----------------------------------------------------------------------------
 void ShaderBasedRenderer::renderToTexture(GL3RenderTarget *render_target,
                                           irr::scene::ICameraSceneNode* camera,
@@ -927,11 +966,15 @@ void ShaderBasedRenderer::renderToTexture(GL3RenderTarget *render_target,
 	m_rtts->getFBO(FBO_COLORS).bind();
 
     irr_driver->getSceneManager()->setActiveCamera(camera);
-    static_cast<scene::CSceneManager *>(irr_driver->getSceneManager())
-        ->OnAnimate(os::Timer::getTime());
+    // Animations and lighting are shared by all views of a frame
+    if (!m_multi_view)
+    {
+        static_cast<scene::CSceneManager *>(irr_driver->getSceneManager())
+            ->OnAnimate(os::Timer::getTime());
+        if (CVS->isARBUniformBufferObjectUsable())
+            uploadLightingData();
+    }
     computeMatrixesAndCameras(camera, m_rtts->getWidth(), m_rtts->getHeight());
-    if (CVS->isARBUniformBufferObjectUsable())
-        uploadLightingData();
 
     if (CVS->isDeferredEnabled())
     {
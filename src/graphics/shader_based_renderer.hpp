@@ -42,6 +42,8 @@ class ShaderBasedRenderer: public AbstractRenderer
 {
 private:
     bool                        m_dump_rtt;
+    /** True between beginMultiView() and endMultiView(). */
+    bool                        m_multi_view;
     RTT                        *m_rtts;
     Skybox                     *m_skybox;
     SphericalHarmonics         *m_spherical_harmonics;
@@ -112,6 +114,10 @@ public:
                          irr::scene::ICameraSceneNode* camera,
                          float dt);
 
+    void beginMultiView(float dt,
+                        const std::vector<irr::scene::ICameraSceneNode*> &cameras) OVERRIDE;
+    void endMultiView() OVERRIDE;
+
     void setRTT(RTT* rtts);
 
     RTT* getRTTs() { return m_rtts; }
@@ -83,6 +83,7 @@ ShadowMatrices::ShadowMatrices()
     m_shadow_cam_nodes[3] = NULL;
     m_rsm_map_available = false;
     m_rsm_matrix_initialized = false;
+    m_keep_cascades = false;
 }   // ShadowMatrices
 // ----------------------------------------------------------------------------
 ShadowMatrices::~ShadowMatrices()
@@ -186,7 +187,8 @@ core::matrix4 ShadowMatrices::getTighestFitOrthoProj(const core::matrix4 &transf
 // ----------------------------------------------------------------------------
 /** Generate View, Projection, Inverse View, Inverse Projection, ViewProjection
  *  and InverseProjection matrixes and matrixes and cameras for the four shadow
- *   cascade and RSM.
+ *   cascade and RSM. The cascades are not changed if they were fitted to
+ *   several views with fitCascades().
  *   \param camnode point of view used
  *   \param width of the rendering viewport
  *   \param height of the rendering viewport
@@ -201,16 +203,42 @@ void ShadowMatrices::computeMatrixesAndCameras(scene::ICameraSceneNode *const ca
                               ->getTransform(video::ETS_VIEW));
     irr_driver->genProjViewMatrix();
 
-
-    const float oldfar = camnode->getFarValue();
-    const float oldnear = camnode->getNearValue();
-
     memcpy(m_mat_ubo, irr_driver->getViewMatrix().pointer(),          16 * sizeof(float));
     memcpy(&m_mat_ubo[16], irr_driver->getProjMatrix().pointer(),     16 * sizeof(float));
     memcpy(&m_mat_ubo[32], irr_driver->getInvViewMatrix().pointer(),  16 * sizeof(float));
     memcpy(&m_mat_ubo[48], irr_driver->getInvProjMatrix().pointer(),  16 * sizeof(float));
     memcpy(&m_mat_ubo[64], irr_driver->getProjViewMatrix().pointer(), 16 * sizeof(float));
 
+    if (!m_keep_cascades)
+        computeCascades(std::vector<scene::ICameraSceneNode*>(1, camnode));
+
+    m_mat_ubo[144] = float(width);
+    m_mat_ubo[145] = float(height);
+}   // computeMatrixesAndCameras
+
+// ----------------------------------------------------------------------------
+/** Fits the four shadow cascades to the union of the view frustums of
+ *  several cameras, e.g. all views of a frame, so that they can share one
+ *  shadow map. The cascades are kept by computeMatrixesAndCameras() until
+ *  releaseCascades() is called.
+ *  \param camnodes The cameras whose frustums the cascades must contain.
+ */
+void ShadowMatrices::fitCascades(const std::vector<scene::ICameraSceneNode*> &camnodes)
+{
+    if (camnodes.empty())
+        return;
+    computeCascades(camnodes);
+    m_keep_cascades = true;
+}   // fitCascades
+
+// ----------------------------------------------------------------------------
+/** Computes the matrixes and cameras of the four shadow cascades. Each
+ *  cascade is the tightest orthographic projection along the sun direction
+ *  that contains the corresponding slice of all frustums.
+ *  \param camnodes The cameras whose frustums the cascades must contain.
+ */
+void ShadowMatrices::computeCascades(const std::vector<scene::ICameraSceneNode*> &camnodes)
+{
     m_sun_cam->render();
     for (unsigned i = 0; i < 4; i++)
     {
@@ -239,47 +267,65 @@ void ShadowMatrices::computeMatrixesAndCameras(scene::ICameraSceneNode *const ca
             ShadowMatrices::m_shadow_split[3]
         };
 
-        // Shadow Matrixes and cameras
-        for (unsigned i = 0; i < 4; i++)
+        // Corners of the slice of each cascade in all frustums
+        std::vector<vector3df> vectors[4];
+        for (unsigned j = 0; j < camnodes.size(); j++)
         {
-            core::matrix4 tmp_matrix;
-
-            camnode->setFarValue(FarValues[i]);
-            camnode->setNearValue(NearValues[i]);
+            scene::ICameraSceneNode *camnode = camnodes[j];
+            const float oldfar = camnode->getFarValue();
+            const float oldnear = camnode->getNearValue();
+            for (unsigned i = 0; i < 4; i++)
+            {
+                camnode->setFarValue(FarValues[i]);
+                camnode->setNearValue(NearValues[i]);
+                camnode->render();
+                const scene::SViewFrustum *frustrum = camnode->getViewFrustum();
+                // Only the frustum of the first view is kept for debugging
+                if (j == 0)
+                {
+                    float tmp[24] = {
+                        frustrum->getFarLeftDown().X,
+                        frustrum->getFarLeftDown().Y,
+                        frustrum->getFarLeftDown().Z,
+                        frustrum->getFarLeftUp().X,
+                        frustrum->getFarLeftUp().Y,
+                        frustrum->getFarLeftUp().Z,
+                        frustrum->getFarRightDown().X,
+                        frustrum->getFarRightDown().Y,
+                        frustrum->getFarRightDown().Z,
+                        frustrum->getFarRightUp().X,
+                        frustrum->getFarRightUp().Y,
+                        frustrum->getFarRightUp().Z,
+                        frustrum->getNearLeftDown().X,
+                        frustrum->getNearLeftDown().Y,
+                        frustrum->getNearLeftDown().Z,
+                        frustrum->getNearLeftUp().X,
+                        frustrum->getNearLeftUp().Y,
+                        frustrum->getNearLeftUp().Z,
+                        frustrum->getNearRightDown().X,
+                        frustrum->getNearRightDown().Y,
+                        frustrum->getNearRightDown().Z,
+                        frustrum->getNearRightUp().X,
+                        frustrum->getNearRightUp().Y,
+                        frustrum->getNearRightUp().Z,
+                    };
+                    memcpy(m_shadows_cam[i], tmp, 24 * sizeof(float));
+                }
+                std::vector<vector3df> corners = getFrustrumVertex(*frustrum);
+                vectors[i].insert(vectors[i].end(), corners.begin(),
+                                  corners.end());
+            }
+            // reset normal camera
+            camnode->setNearValue(oldnear);
+            camnode->setFarValue(oldfar);
             camnode->render();
-            const scene::SViewFrustum *frustrum = camnode->getViewFrustum();
-            float tmp[24] = {
-                frustrum->getFarLeftDown().X,
-                frustrum->getFarLeftDown().Y,
-                frustrum->getFarLeftDown().Z,
-                frustrum->getFarLeftUp().X,
-                frustrum->getFarLeftUp().Y,
-                frustrum->getFarLeftUp().Z,
-                frustrum->getFarRightDown().X,
-                frustrum->getFarRightDown().Y,
-                frustrum->getFarRightDown().Z,
-                frustrum->getFarRightUp().X,
-                frustrum->getFarRightUp().Y,
-                frustrum->getFarRightUp().Z,
-                frustrum->getNearLeftDown().X,
-                frustrum->getNearLeftDown().Y,
-                frustrum->getNearLeftDown().Z,
-                frustrum->getNearLeftUp().X,
-                frustrum->getNearLeftUp().Y,
-                frustrum->getNearLeftUp().Z,
-                frustrum->getNearRightDown().X,
-                frustrum->getNearRightDown().Y,
-                frustrum->getNearRightDown().Z,
-                frustrum->getNearRightUp().X,
-                frustrum->getNearRightUp().Y,
-                frustrum->getNearRightUp().Z,
-            };
-            memcpy(m_shadows_cam[i], tmp, 24 * sizeof(float));
-
-            std::vector<vector3df> vectors = getFrustrumVertex(*frustrum);
-            tmp_matrix = getTighestFitOrthoProj(sun_cam_view_matrix, vectors,
-                                                m_shadow_scales[i]);
+        }
 
+        // Shadow Matrixes and cameras
+        for (unsigned i = 0; i < 4; i++)
+        {
+            core::matrix4 tmp_matrix = getTighestFitOrthoProj(
+                sun_cam_view_matrix, vectors[i], m_shadow_scales[i]);
 
             m_shadow_cam_nodes[i]->setProjectionMatrix(tmp_matrix, true);
             m_shadow_cam_nodes[i]->render();
@@ -289,10 +335,8 @@ void ShadowMatrices::computeMatrixesAndCameras(scene::ICameraSceneNode *const ca
                 * irr_driver->getVideoDriver()->getTransform(video::ETS_VIEW)       );
         }
         assert(m_sun_ortho_matrices.size() == 4);
-        // reset normal camera
-        camnode->setNearValue(oldnear);
-        camnode->setFarValue(oldfar);
-        camnode->render();
+        // The shadow cameras changed the transforms of the driver
+        camnodes.back()->render();
 
         size_t size = m_sun_ortho_matrices.size();
         for (unsigned i = 0; i < size; i++)
@@ -300,10 +344,7 @@ void ShadowMatrices::computeMatrixesAndCameras(scene::ICameraSceneNode *const ca
                    m_sun_ortho_matrices[i].pointer(),
                    16 * sizeof(float));
     }
-
-    m_mat_ubo[144] = float(width);
-    m_mat_ubo[145] = float(height);
-}   // computeMatrixesAndCameras
+}   // computeCascades
 
 // ----------------------------------------------------------------------------
 void ShadowMatrices::renderWireFrameFrustrum(float *tmp, unsigned i)
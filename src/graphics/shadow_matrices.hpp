@@ -51,11 +51,15 @@ private:
     float                      m_shadows_cam[4][24];
     bool                       m_rsm_map_available;
     float                      m_mat_ubo[16 * 9 + 2];
+    /** True if the cascades were fitted to several views with fitCascades(),
+     *  computeMatrixesAndCameras() then keeps them. */
+    bool                       m_keep_cascades;
 
     core::matrix4 getTighestFitOrthoProj(const core::matrix4 &transform,
                               const std::vector<core::vector3df> &pointsInside,
                               std::pair<float, float> &size);
     void renderWireFrameFrustrum(float *tmp, unsigned i);
+    void computeCascades(const std::vector<scene::ICameraSceneNode*> &camnodes);
 public:
 
     ShadowMatrices();
@@ -63,6 +67,12 @@ public:
 
     void computeMatrixesAndCameras(scene::ICameraSceneNode *const camnode,
                                    unsigned int width, unsigned int height);
+    void fitCascades(const std::vector<scene::ICameraSceneNode*> &camnodes);
+    // ------------------------------------------------------------------------
+    /** Lets computeMatrixesAndCameras() fit the cascades to its camera
+     *  again. */
+    void releaseCascades() { m_keep_cascades = false; }
+    // ------------------------------------------------------------------------
     void addLight(const core::vector3df &pos);
     void updateSunOrthoMatrices();
     void renderShadowsDebug(const FrameBuffer* shadow_framebuffer,
@@ -35,6 +35,7 @@
 #include "tracks/quad.hpp"
 #include "utils/constants.hpp"
 #include "utils/mini_glm.hpp"
+#include "utils/state_buffer.hpp"
 
 /** Creates the slip stream object
  *  \param kart Pointer to the kart to which the slip stream
@@ -180,6 +181,37 @@ void SlipStream::reset()
     m_kart->increaseMaxSpeed(MaxSpeed::MS_INCREASE_SLIPSTREAM, 0, 0, 0, 0);
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the slipstream collection and bonus state. The speed increase
+ *  itself is part of MaxSpeed.
+ */
+void SlipStream::saveState(StateBuffer *buffer) const
+{
+    buffer->add<int>(m_slipstream_mode);
+    buffer->add<float>(m_slipstream_time);
+    buffer->add<float>(m_bonus_time);
+    buffer->add<bool>(m_bonus_active);
+    buffer->add<int>(m_current_target_id);
+    buffer->add<int>(m_previous_target_id);
+    buffer->add<int>(m_speed_increase_ticks);
+    buffer->add<int>(m_speed_increase_duration);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void SlipStream::restoreState(StateBuffer *buffer)
+{
+    m_slipstream_mode = buffer->get<int>() == SS_COLLECT ? SS_COLLECT
+                                                         : SS_NONE;
+    m_slipstream_time         = buffer->get<float>();
+    m_bonus_time              = buffer->get<float>();
+    m_bonus_active            = buffer->get<bool>();
+    m_current_target_id       = buffer->get<int>();
+    m_previous_target_id      = buffer->get<int>();
+    m_speed_increase_ticks    = buffer->get<int>();
+    m_speed_increase_duration = buffer->get<int>();
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Creates the mesh for the slipstream effect. This function creates a
  *  first a series of circles (with a certain number of vertices each and
@@ -40,6 +40,7 @@ namespace SP
 class AbstractKart;
 class Quad;
 class Material;
+class StateBuffer;
 
 /**
   * \ingroup graphics
@@ -124,6 +125,8 @@ public:
                  SlipStream  (AbstractKart* kart);
                  ~SlipStream  ();
     void         reset();
+    void         saveState(StateBuffer *buffer) const;
+    void         restoreState(StateBuffer *buffer);
     void         update(int ticks);
     bool         isSlipstreamReady() const;
     void         updateSpeedIncrease();
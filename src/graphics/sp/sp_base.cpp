@@ -51,11 +51,16 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
+#include <functional>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#if __SSE2__ || _M_X64 || _M_IX86_FP >= 2
+ #include <emmintrin.h>
+ #define SIMD_SSE2_SUPPORT (1)
+#endif
+
 namespace SP
 {
 
@@ -76,20 +81,91 @@ SPShader* g_normal_visualizer = NULL;
 // ----------------------------------------------------------------------------
 SPShader* g_glow_shader = NULL;
 // ----------------------------------------------------------------------------
-// std::string is layer_1 and layer_2 texture name combined
-typedef std::unordered_map<SPShader*, std::unordered_map<std::string,
-    std::unordered_set<SPMeshBuffer*> > > DrawCall;
-
-DrawCall g_draw_calls[DCT_FOR_VAO];
+/** A mesh buffer drawn with a shader and texture combination. m_texture
+ *  points to a key of SPMeshBuffer::getTextureCompare() (layer_1 and
+ *  layer_2 texture name combined), or to g_no_texture for sampler-less
+ *  shaders. The same mesh buffer can be added more than once if it is
+ *  instanced, duplicates are removed in updateModelMatrix(). */
+struct DrawCall
+{
+    SPShader* m_shader;
+    const std::string* m_texture;
+    SPMeshBuffer* m_mb;
+};
+// ----------------------------------------------------------------------------
+const std::string g_no_texture;
+// ----------------------------------------------------------------------------
+std::vector<DrawCall> g_draw_calls[DCT_FOR_VAO];
 // ----------------------------------------------------------------------------
 std::vector<std::pair<SPShader*, std::vector<std::pair<std::array<GLuint, 6>,
     std::vector<std::pair<SPMeshBuffer*, int/*material_id*/> > > > > >
     g_final_draw_calls[DCT_FOR_VAO];
 // ----------------------------------------------------------------------------
-std::unordered_map<unsigned, std::pair<core::vector3df,
-    std::unordered_set<SPMeshBuffer*> > > g_glow_meshes;
+/** A mesh buffer drawn in the glow pass, m_key is the glow color as
+ *  SColor. Sorted by color and without duplicates after
+ *  updateModelMatrix(). */
+struct GlowMesh
+{
+    unsigned m_key;
+    core::vector3df m_color;
+    SPMeshBuffer* m_mb;
+};
+std::vector<GlowMesh> g_glow_meshes;
+// ----------------------------------------------------------------------------
+/** Mesh buffers whose instance data needs to be uploaded, can contain
+ *  duplicates until uploadAll(). */
+std::vector<SPMeshBuffer*> g_instances;
+// ----------------------------------------------------------------------------
+/** World space bounding boxes to cull, stored as one array per component
+ *  (min x, y, z and max x, y, z) so that cullBoxes() can test 4 boxes at a
+ *  time. */
+struct CullBoxes
+{
+    std::vector<float> m_edge[6];
+    /** Bit i is set if the box is completely outside of g_frustums[i]. */
+    std::vector<uint8_t> m_culled;
+    // ------------------------------------------------------------------------
+    void clear()
+    {
+        for (std::vector<float>& e : m_edge)
+            e.clear();
+        m_culled.clear();
+    }
+    // ------------------------------------------------------------------------
+    void add(const core::aabbox3df& bb)
+    {
+        m_edge[0].push_back(bb.MinEdge.X);
+        m_edge[1].push_back(bb.MinEdge.Y);
+        m_edge[2].push_back(bb.MinEdge.Z);
+        m_edge[3].push_back(bb.MaxEdge.X);
+        m_edge[4].push_back(bb.MaxEdge.Y);
+        m_edge[5].push_back(bb.MaxEdge.Z);
+    }
+    // ------------------------------------------------------------------------
+    unsigned size() const                 { return (unsigned)m_edge[0].size(); }
+    // ------------------------------------------------------------------------
+    core::aabbox3df get(unsigned i) const
+    {
+        return core::aabbox3df(m_edge[0][i], m_edge[1][i], m_edge[2][i],
+                               m_edge[3][i], m_edge[4][i], m_edge[5][i]);
+    }
+};
+// ----------------------------------------------------------------------------
+/** A mesh buffer of a mesh node added by addObject(), which is culled and
+ *  turned into draw calls in cullObjects(). */
+struct CullObject
+{
+    SPMeshNode* m_node;
+    unsigned m_mesh_buffer;
+    bool m_handle_shadow;
+};
+std::vector<CullObject> g_cull_objects;
+// ----------------------------------------------------------------------------
+CullBoxes g_cull_boxes;
+// ----------------------------------------------------------------------------
+std::vector<SPDynamicDrawCall*> g_cull_dy_dc;
 // ----------------------------------------------------------------------------
-std::unordered_set<SPMeshBuffer*> g_instances;
+CullBoxes g_cull_dy_dc_boxes;
 // ----------------------------------------------------------------------------
 std::array<GLuint, ST_COUNT> g_samplers;
 // ----------------------------------------------------------------------------
@@ -118,6 +194,10 @@ std::vector<SPMeshNode*> g_skinning_mesh;
 // ----------------------------------------------------------------------------
 int sp_cur_shadow_cascade = 0;
 // ----------------------------------------------------------------------------
+/** True if the shadow map was already rendered for another view of this
+ *  frame, no shadow draw calls are generated then. */
+bool sp_reuse_shadow_map = false;
+// ----------------------------------------------------------------------------
 void initSTKRenderer(ShaderBasedRenderer* sbr)
 {
     g_stk_sbr = sbr;
@@ -751,7 +831,7 @@ void prepareDrawCalls()
     g_skinning_offset = 1;
     g_skinning_mesh.clear();
     mathPlaneFrustumf(g_frustums[0], irr_driver->getProjViewMatrix());
-    g_handle_shadow = Track::getCurrentTrack() &&
+    g_handle_shadow = !sp_reuse_shadow_map && Track::getCurrentTrack() &&
         Track::getCurrentTrack()->hasShadows() && CVS->isDeferredEnabled() &&
         CVS->isShadowEnabled();
 
@@ -767,19 +847,158 @@ void prepareDrawCalls()
             g_stk_sbr->getShadowMatrices()->getSunOrthoMatrices()[3]);
     }
 
+    // Only the sizes are reset, the capacity is reused in the next frame
     for (auto& p : g_draw_calls)
     {
         p.clear();
     }
-    for (auto& p : g_final_draw_calls)
-    {
-        p.clear();
-    }
     g_glow_meshes.clear();
     g_instances.clear();
+    g_cull_objects.clear();
+    g_cull_boxes.clear();
 }
 
 // ----------------------------------------------------------------------------
+/** Tests all boxes against the frustums in g_frustums, 4 boxes at a time if
+ *  SSE2 is available. A box is outside of a frustum if it is completely on
+ *  the negative side of one of its planes, which is the case if the box
+ *  corner furthest along the plane normal is.
+ *  \param boxes The boxes to test, the result is stored in boxes->m_culled.
+ *  \param num_frustums Number of frustums to test (1, or 5 with shadows).
+ */
+void cullBoxes(CullBoxes* boxes, int num_frustums)
+{
+    const unsigned count = boxes->size();
+    boxes->m_culled.assign(count, 0);
+    const float* edge[6];
+    for (int e = 0; e < 6; e++)
+        edge[e] = boxes->m_edge[e].data();
+    uint8_t* culled = boxes->m_culled.data();
+
+    unsigned n = 0;
+#ifdef SIMD_SSE2_SUPPORT
+    for (; n + 4 <= count; n += 4)
+    {
+        __m128 box[6];
+        for (int e = 0; e < 6; e++)
+            box[e] = _mm_loadu_ps(edge[e] + n);
+        for (int f = 0; f < num_frustums; f++)
+        {
+            __m128 outside = _mm_setzero_ps();
+            for (int i = 0; i < 24; i += 4)
+            {
+                const float* plane = &g_frustums[f][i];
+                // Use the max edge for positive normal components
+                const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(box[plane[0] >= 0.0f ? 3 : 0],
+                               _mm_set1_ps(plane[0])),
+                    _mm_mul_ps(box[plane[1] >= 0.0f ? 4 : 1],
+                               _mm_set1_ps(plane[1]))),
+                    _mm_mul_ps(box[plane[2] >= 0.0f ? 5 : 2],
+                               _mm_set1_ps(plane[2]))),
+                    _mm_set1_ps(plane[3]));
+                outside = _mm_or_ps(outside,
+                                    _mm_cmplt_ps(dist, _mm_setzero_ps()));
+            }
+            const int mask = _mm_movemask_ps(outside);
+            for (int k = 0; k < 4; k++)
+            {
+                if (mask & (1 << k))
+                    culled[n + k] |= (uint8_t)(1 << f);
+            }
+        }
+    }
+#endif
+    for (; n < count; n++)
+    {
+        for (int f = 0; f < num_frustums; f++)
+        {
+            for (int i = 0; i < 24; i += 4)
+            {
+                const float* plane = &g_frustums[f][i];
+                const float dist =
+                    edge[plane[0] >= 0.0f ? 3 : 0][n] * plane[0] +
+                    edge[plane[1] >= 0.0f ? 4 : 1][n] * plane[1] +
+                    edge[plane[2] >= 0.0f ? 5 : 2][n] * plane[2] +
+                    plane[3];
+                if (dist < 0.0f)
+                {
+                    culled[n] |= (uint8_t)(1 << f);
+                    break;
+                }
+            }
+        }
+    }
+}   // cullBoxes
+
+// ----------------------------------------------------------------------------
+/** Returns the bits of the frustums a box is culled in, bits of the shadow
+ *  frustums are set if shadows are not handled for it. */
+inline uint8_t getCulledFrustums(const CullBoxes& boxes, unsigned i,
+                                 bool handle_shadow)
+{
+    return boxes.m_culled[i] | (handle_shadow ? 0 : 0x1e);
+}   // getCulledFrustums
+
+// ----------------------------------------------------------------------------
+void addBoundingBoxForViz(const core::aabbox3df& bb)
+{
+    addEdgeForViz(getCorner(bb, 0), getCorner(bb, 1));
+    addEdgeForViz(getCorner(bb, 1), getCorner(bb, 5));
+    addEdgeForViz(getCorner(bb, 5), getCorner(bb, 4));
+    addEdgeForViz(getCorner(bb, 4), getCorner(bb, 0));
+    addEdgeForViz(getCorner(bb, 2), getCorner(bb, 3));
+    addEdgeForViz(getCorner(bb, 3), getCorner(bb, 7));
+    addEdgeForViz(getCorner(bb, 7), getCorner(bb, 6));
+    addEdgeForViz(getCorner(bb, 6), getCorner(bb, 2));
+    addEdgeForViz(getCorner(bb, 0), getCorner(bb, 2));
+    addEdgeForViz(getCorner(bb, 1), getCorner(bb, 3));
+    addEdgeForViz(getCorner(bb, 5), getCorner(bb, 7));
+    addEdgeForViz(getCorner(bb, 4), getCorner(bb, 6));
+}   // addBoundingBoxForViz
+
+// ----------------------------------------------------------------------------
+/** Adds the draw calls of a mesh buffer for one draw call type.
+ *  \return False if the mesh buffer is not drawn for this type
+ *          (transparent shaders are only drawn in DCT_NORMAL).
+ */
+bool addDrawCall(SPShader* shader, SPMeshBuffer* mb, int dc_type)
+{
+    if (shader->isTransparent())
+    {
+        // Transparent shader should always uses mesh samplers
+        // All transparent draw calls go DCT_TRANSPARENT
+        if (dc_type != DCT_NORMAL)
+        {
+            return false;
+        }
+        for (auto& p : mb->getTextureCompare())
+        {
+            g_draw_calls[DCT_TRANSPARENT].push_back({ shader, &p.first, mb });
+        }
+        return true;
+    }
+    // Check if shader for render pass uses mesh samplers
+    const RenderPass check_pass =
+        dc_type == DCT_NORMAL ? RP_1ST : RP_SHADOW;
+    if (shader->samplerLess(check_pass))
+    {
+        g_draw_calls[dc_type].push_back({ shader, &g_no_texture, mb });
+    }
+    else
+    {
+        for (auto& p : mb->getTextureCompare())
+        {
+            g_draw_calls[dc_type].push_back({ shader, &p.first, mb });
+        }
+    }
+    return true;
+}   // addDrawCall
+
+// ----------------------------------------------------------------------------
+/** Adds the mesh buffers of a mesh node for culling. They are culled and
+ *  turned into draw calls together with all other nodes in cullObjects().
+ */
 void addObject(SPMeshNode* node)
 {
     if (!sp_culling)
@@ -793,70 +1012,67 @@ void addObject(SPMeshNode* node)
     }
 
     const core::matrix4& model_matrix = node->getAbsoluteTransformation();
-    bool added_for_skinning = false;
     for (unsigned m = 0; m < mesh->getMeshBufferCount(); m++)
     {
-        SPMeshBuffer* mb = mesh->getSPMeshBuffer(m);
         SPShader* shader = node->getShader(m);
         if (shader == NULL)
         {
             continue;
         }
-        core::aabbox3df bb = mb->getBoundingBox();
+        core::aabbox3df bb = mesh->getSPMeshBuffer(m)->getBoundingBox();
         model_matrix.transformBoxEx(bb);
-        std::vector<bool> discard;
         const bool handle_shadow = node->isInShadowPass() &&
             g_handle_shadow && shader->hasShader(RP_SHADOW);
-        discard.resize((handle_shadow ? 5 : 1), false);
+        g_cull_objects.push_back({ node, m, handle_shadow });
+        g_cull_boxes.add(bb);
+    }
+}   // addObject
 
-        for (int dc_type = 0; dc_type < (handle_shadow ? 5 : 1); dc_type++)
+// ----------------------------------------------------------------------------
+/** Culls all mesh buffers added by addObject() in one batch, and adds the
+ *  draw calls and instance data of the visible ones in the order they were
+ *  added.
+ */
+void cullObjects()
+{
+    if (!sp_culling)
+    {
+        return;
+    }
+    cullBoxes(&g_cull_boxes, g_handle_shadow ? 5 : 1);
+
+    SPMeshNode* cur_node = NULL;
+    bool added_for_skinning = false;
+    bool skip_node = false;
+    for (unsigned i = 0; i < g_cull_objects.size(); i++)
+    {
+        const CullObject& obj = g_cull_objects[i];
+        SPMeshNode* node = obj.m_node;
+        if (node != cur_node)
         {
-            for (int i = 0; i < 24; i += 4)
-            {
-                bool outside = true;
-                for (int j = 0; j < 8; j++)
-                {
-                    const float dist =
-                        getCorner(bb, j).X * g_frustums[dc_type][i] +
-                        getCorner(bb, j).Y * g_frustums[dc_type][i + 1] +
-                        getCorner(bb, j).Z * g_frustums[dc_type][i + 2] +
-                        g_frustums[dc_type][i + 3];
-                    outside = outside && dist < 0.0f;
-                    if (!outside)
-                    {
-                        break;
-                    }
-                }
-                if (outside)
-                {
-                    discard[dc_type] = true;
-                    break;
-                }
-            }
+            cur_node = node;
+            added_for_skinning = false;
+            skip_node = false;
+        }
+        if (skip_node)
+        {
+            continue;
         }
-        if (handle_shadow ?
-            (discard[0] && discard[1] && discard[2] && discard[3] &&
-            discard[4]) : discard[0])
+        const uint8_t culled =
+            getCulledFrustums(g_cull_boxes, i, obj.m_handle_shadow);
+        if ((culled & 0x1f) == 0x1f)
         {
             continue;
         }
 
         if (irr_driver->getBoundingBoxesViz())
         {
-            addEdgeForViz(getCorner(bb, 0), getCorner(bb, 1));
-            addEdgeForViz(getCorner(bb, 1), getCorner(bb, 5));
-            addEdgeForViz(getCorner(bb, 5), getCorner(bb, 4));
-            addEdgeForViz(getCorner(bb, 4), getCorner(bb, 0));
-            addEdgeForViz(getCorner(bb, 2), getCorner(bb, 3));
-            addEdgeForViz(getCorner(bb, 3), getCorner(bb, 7));
-            addEdgeForViz(getCorner(bb, 7), getCorner(bb, 6));
-            addEdgeForViz(getCorner(bb, 6), getCorner(bb, 2));
-            addEdgeForViz(getCorner(bb, 0), getCorner(bb, 2));
-            addEdgeForViz(getCorner(bb, 1), getCorner(bb, 3));
-            addEdgeForViz(getCorner(bb, 5), getCorner(bb, 7));
-            addEdgeForViz(getCorner(bb, 4), getCorner(bb, 6));
+            addBoundingBoxForViz(g_cull_boxes.get(i));
         }
 
+        const unsigned m = obj.m_mesh_buffer;
+        SPMeshBuffer* mb = node->getSPM()->getSPMeshBuffer(m);
+        SPShader* shader = node->getShader(m);
         mb->uploadGLMesh();
         // For first frame only need the vbo to be initialized
         if (!added_for_skinning && node->getAnimationState())
@@ -868,7 +1084,8 @@ void addObject(SPMeshNode* node)
                 Log::error("SPBase", "No enough space to render skinned"
                     " mesh %s! Max joints can hold: %d",
                     node->getName(), stk_config->m_max_skinning_bones);
-                return;
+                skip_node = true;
+                continue;
             }
             node->setSkinningOffset(g_skinning_offset);
             g_skinning_mesh.push_back(node);
@@ -882,9 +1099,10 @@ void addObject(SPMeshNode* node)
             node->getTextureMatrix(m)[1], hue,
             (short)node->getSkinningOffset(), node->objectId());
 
-        for (int dc_type = 0; dc_type < (handle_shadow ? 5 : 1); dc_type++)
+        for (int dc_type = 0; dc_type < (obj.m_handle_shadow ? 5 : 1);
+             dc_type++)
         {
-            if (discard[dc_type])
+            if (culled & (1 << dc_type))
             {
                 continue;
             }
@@ -896,66 +1114,35 @@ void addObject(SPMeshNode* node)
             {
                 sp_shadow_poly_count += mb->getIndexCount() / 3;
             }
+            if (!addDrawCall(shader, mb, dc_type))
+            {
+                continue;
+            }
             if (shader->isTransparent())
             {
-                // Transparent shader should always uses mesh samplers
-                // All transparent draw calls go DCT_TRANSPARENT
-                if (dc_type == 0)
-                {
-                    auto& ret = g_draw_calls[DCT_TRANSPARENT][shader];
-                    for (auto& p : mb->getTextureCompare())
-                    {
-                        ret[p.first].insert(mb);
-                    }
-                    mb->addInstanceData(id, DCT_TRANSPARENT);
-                }
-                else
-                {
-                    continue;
-                }
+                mb->addInstanceData(id, DCT_TRANSPARENT);
             }
             else
             {
-                // Check if shader for render pass uses mesh samplers
-                const RenderPass check_pass =
-                    dc_type == DCT_NORMAL ? RP_1ST : RP_SHADOW;
-                const bool sampler_less = shader->samplerLess(check_pass);
-                auto& ret = g_draw_calls[dc_type][shader];
-                if (sampler_less)
-                {
-                    ret[""].insert(mb);
-                }
-                else
-                {
-                    for (auto& p : mb->getTextureCompare())
-                    {
-                        ret[p.first].insert(mb);
-                    }
-                }
                 mb->addInstanceData(id, (DrawCallType)dc_type);
                 if (UserConfigParams::m_glow && node->hasGlowColor() &&
                     CVS->isDeferredEnabled() && dc_type == DCT_NORMAL)
                 {
                     video::SColorf gc = node->getGlowColor();
-                    unsigned key = gc.toSColor().color;
-                    auto ret = g_glow_meshes.find(key);
-                    if (ret == g_glow_meshes.end())
-                    {
-                        g_glow_meshes[key] = std::make_pair(
-                            core::vector3df(gc.r, gc.g, gc.b),
-                            std::unordered_set<SPMeshBuffer*>());
-                    }
-                    g_glow_meshes.at(key).second.insert(mb);
+                    g_glow_meshes.push_back({ gc.toSColor().color,
+                        core::vector3df(gc.r, gc.g, gc.b), mb });
                 }
             }
-            g_instances.insert(mb);
+            g_instances.push_back(mb);
         }
     }
-}
+}   // cullObjects
 
 // ----------------------------------------------------------------------------
 void handleDynamicDrawCall()
 {
+    g_cull_dy_dc.clear();
+    g_cull_dy_dc_boxes.clear();
     for (unsigned dc_num = 0; dc_num < g_dy_dc.size(); dc_num++)
     {
         SPDynamicDrawCall* dydc = g_dy_dc[dc_num].get();
@@ -963,72 +1150,45 @@ void handleDynamicDrawCall()
         {
             // They need to be updated independent of culling result
             // otherwise some data will be missed if offset update is used
-            g_instances.insert(dydc);
+            g_instances.push_back(dydc);
         }
         if (!dydc->isVisible() || dydc->notReadyFromDrawing() ||
             dydc->isRemoving() || !sp_culling)
         {
             continue;
         }
-
-        SPShader* shader = dydc->getShader();
         core::aabbox3df bb = dydc->getBoundingBox();
         dydc->getAbsoluteTransformation().transformBoxEx(bb);
-        std::vector<bool> discard;
+        g_cull_dy_dc.push_back(dydc);
+        g_cull_dy_dc_boxes.add(bb);
+    }
+    if (g_cull_dy_dc.empty())
+    {
+        return;
+    }
+    cullBoxes(&g_cull_dy_dc_boxes, g_handle_shadow ? 5 : 1);
+
+    for (unsigned i = 0; i < g_cull_dy_dc.size(); i++)
+    {
+        SPDynamicDrawCall* dydc = g_cull_dy_dc[i];
+        SPShader* shader = dydc->getShader();
         const bool handle_shadow =
             g_handle_shadow && shader->hasShader(RP_SHADOW);
-        discard.resize((handle_shadow ? 5 : 1), false);
-        for (int dc_type = 0; dc_type < (handle_shadow ? 5 : 1); dc_type++)
-        {
-            for (int i = 0; i < 24; i += 4)
-            {
-                bool outside = true;
-                for (int j = 0; j < 8; j++)
-                {
-                    const float dist =
-                        getCorner(bb, j).X * g_frustums[dc_type][i] +
-                        getCorner(bb, j).Y * g_frustums[dc_type][i + 1] +
-                        getCorner(bb, j).Z * g_frustums[dc_type][i + 2] +
-                        g_frustums[dc_type][i + 3];
-                    outside = outside && dist < 0.0f;
-                    if (!outside)
-                    {
-                        break;
-                    }
-                }
-                if (outside)
-                {
-                    discard[dc_type] = true;
-                    break;
-                }
-            }
-        }
-        if (handle_shadow ?
-            (discard[0] && discard[1] && discard[2] && discard[3] &&
-            discard[4]) : discard[0])
+        const uint8_t culled =
+            getCulledFrustums(g_cull_dy_dc_boxes, i, handle_shadow);
+        if ((culled & 0x1f) == 0x1f)
         {
             continue;
         }
 
         if (irr_driver->getBoundingBoxesViz())
         {
-            addEdgeForViz(getCorner(bb, 0), getCorner(bb, 1));
-            addEdgeForViz(getCorner(bb, 1), getCorner(bb, 5));
-            addEdgeForViz(getCorner(bb, 5), getCorner(bb, 4));
-            addEdgeForViz(getCorner(bb, 4), getCorner(bb, 0));
-            addEdgeForViz(getCorner(bb, 2), getCorner(bb, 3));
-            addEdgeForViz(getCorner(bb, 3), getCorner(bb, 7));
-            addEdgeForViz(getCorner(bb, 7), getCorner(bb, 6));
-            addEdgeForViz(getCorner(bb, 6), getCorner(bb, 2));
-            addEdgeForViz(getCorner(bb, 0), getCorner(bb, 2));
-            addEdgeForViz(getCorner(bb, 1), getCorner(bb, 3));
-            addEdgeForViz(getCorner(bb, 5), getCorner(bb, 7));
-            addEdgeForViz(getCorner(bb, 4), getCorner(bb, 6));
+            addBoundingBoxForViz(g_cull_dy_dc_boxes.get(i));
         }
 
         for (int dc_type = 0; dc_type < (handle_shadow ? 5 : 1); dc_type++)
         {
-            if (discard[dc_type])
+            if (culled & (1 << dc_type))
             {
                 continue;
             }
@@ -1040,42 +1200,7 @@ void handleDynamicDrawCall()
             {
                 sp_shadow_poly_count += dydc->getVertexCount();
             }
-            if (shader->isTransparent())
-            {
-                // Transparent shader should always uses mesh samplers
-                // All transparent draw calls go DCT_TRANSPARENT
-                if (dc_type == 0)
-                {
-                    auto& ret = g_draw_calls[DCT_TRANSPARENT][shader];
-                    for (auto& p : dydc->getTextureCompare())
-                    {
-                        ret[p.first].insert(dydc);
-                    }
-                }
-                else
-                {
-                    continue;
-                }
-            }
-            else
-            {
-                // Check if shader for render pass uses mesh samplers
-                const RenderPass check_pass =
-                    dc_type == DCT_NORMAL ? RP_1ST : RP_SHADOW;
-                const bool sampler_less = shader->samplerLess(check_pass);
-                auto& ret = g_draw_calls[dc_type][shader];
-                if (sampler_less)
-                {
-                    ret[""].insert(dydc);
-                }
-                else
-                {
-                    for (auto& p : dydc->getTextureCompare())
-                    {
-                        ret[p.first].insert(dydc);
-                    }
-                }
-            }
+            addDrawCall(shader, dydc, dc_type);
         }
     }
 }
@@ -1092,47 +1217,64 @@ void updateModelMatrix()
 
     for (unsigned i = 0; i < DCT_FOR_VAO; i++)
     {
-        DrawCall* dc = &g_draw_calls[(DrawCallType)i];
+        std::vector<DrawCall>& dc = g_draw_calls[i];
         // Sort dc based on the drawing priority of shaders
         // The larger the drawing priority int, the last it will be drawn
-        using DrawCallPair = std::pair<SPShader*,
-            std::unordered_map<std::string,
-            std::unordered_set<SPMeshBuffer*> > >;
-        std::vector<DrawCallPair> sorted_dc;
-        for (auto& p : *dc)
-        {
-            sorted_dc.push_back(p);
-        }
-        std::sort(sorted_dc.begin(), sorted_dc.end(),
-            [](const DrawCallPair& a, const DrawCallPair& b)->bool
+        // Then group by shader and texture, and remove duplicated mesh
+        // buffers of instanced meshes
+        std::sort(dc.begin(), dc.end(),
+            [](const DrawCall& a, const DrawCall& b)->bool
             {
-                return a.first->getDrawingPriority() <
-                    b.first->getDrawingPriority();
+                if (a.m_shader != b.m_shader)
+                {
+                    if (a.m_shader->getDrawingPriority() !=
+                        b.m_shader->getDrawingPriority())
+                    {
+                        return a.m_shader->getDrawingPriority() <
+                            b.m_shader->getDrawingPriority();
+                    }
+                    return std::less<SPShader*>()(a.m_shader, b.m_shader);
+                }
+                const int cmp = a.m_texture->compare(*b.m_texture);
+                if (cmp != 0)
+                {
+                    return cmp < 0;
+                }
+                return std::less<SPMeshBuffer*>()(a.m_mb, b.m_mb);
             });
-        for (unsigned dc = 0; dc < sorted_dc.size(); dc++)
+        dc.erase(std::unique(dc.begin(), dc.end(),
+            [](const DrawCall& a, const DrawCall& b)->bool
+            {
+                return a.m_shader == b.m_shader && a.m_mb == b.m_mb &&
+                    *a.m_texture == *b.m_texture;
+            }), dc.end());
+
+        // Resize instead of clear so the vectors of the previous frame are
+        // reused
+        auto& final_dc = g_final_draw_calls[i];
+        unsigned shader_count = 0;
+        unsigned j = 0;
+        while (j < dc.size())
         {
-            auto& p = sorted_dc[dc];
-            g_final_draw_calls[i].emplace_back(p.first,
-            std::vector<std::pair<std::array<GLuint, 6>,
-                std::vector<std::pair<SPMeshBuffer*, int> > > >());
-
-            unsigned texture = 0;
-            for (auto& q : p.second)
+            SPShader* shader = dc[j].m_shader;
+            if (shader_count == final_dc.size())
             {
-                if (q.second.empty())
-                {
-                    continue;
-                }
+                final_dc.emplace_back();
+            }
+            auto& shader_dc = final_dc[shader_count++];
+            shader_dc.first = shader;
+            unsigned texture_count = 0;
+            while (j < dc.size() && dc[j].m_shader == shader)
+            {
+                const std::string& texture = *dc[j].m_texture;
                 std::array<GLuint, 6> texture_names =
                     {{ 0, 0, 0, 0, 0, 0 }};
-                int material_id =
-                    (*(q.second.begin()))->getMaterialID(q.first);
+                int material_id = dc[j].m_mb->getMaterialID(texture);
 
                 if (material_id != -1)
                 {
                     const std::array<std::shared_ptr<SPTexture>, 6>& textures =
-                        (*(q.second.begin()))->getSPTexturesByMaterialID
-                        (material_id);
+                        dc[j].m_mb->getSPTexturesByMaterialID(material_id);
                     texture_names =
                         {{
                             textures[0]->getOpenGLTextureName(),
@@ -1143,19 +1285,42 @@ void updateModelMatrix()
                             textures[5]->getOpenGLTextureName()
                         }};
                 }
-                g_final_draw_calls[i][dc].second.emplace_back
-                    (texture_names,
-                    std::vector<std::pair<SPMeshBuffer*, int> >());
-                for (SPMeshBuffer* spmb : q.second)
+                if (texture_count == shader_dc.second.size())
+                {
+                    shader_dc.second.emplace_back();
+                }
+                auto& texture_dc = shader_dc.second[texture_count++];
+                texture_dc.first = texture_names;
+                texture_dc.second.clear();
+                while (j < dc.size() && dc[j].m_shader == shader &&
+                    *dc[j].m_texture == texture)
                 {
-                    g_final_draw_calls[i][dc].second[texture].second.push_back
-                        (std::make_pair(spmb, material_id == -1 ?
-                        -1 : spmb->getMaterialID(q.first)));
+                    SPMeshBuffer* spmb = dc[j].m_mb;
+                    texture_dc.second.push_back(std::make_pair(spmb,
+                        material_id == -1 ?
+                        -1 : spmb->getMaterialID(texture)));
+                    j++;
                 }
-                texture++;
             }
+            shader_dc.second.resize(texture_count);
         }
+        final_dc.resize(shader_count);
     }
+
+    std::sort(g_glow_meshes.begin(), g_glow_meshes.end(),
+        [](const GlowMesh& a, const GlowMesh& b)->bool
+        {
+            if (a.m_key != b.m_key)
+            {
+                return a.m_key < b.m_key;
+            }
+            return std::less<SPMeshBuffer*>()(a.m_mb, b.m_mb);
+        });
+    g_glow_meshes.erase(std::unique(g_glow_meshes.begin(),
+        g_glow_meshes.end(), [](const GlowMesh& a, const GlowMesh& b)->bool
+        {
+            return a.m_key == b.m_key && a.m_mb == b.m_mb;
+        }), g_glow_meshes.end());
 }
 
 // ----------------------------------------------------------------------------
@@ -1222,6 +1387,11 @@ void uploadAll()
         g_stk_sbr->getShadowMatrices()->getMatricesData());
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
+    // Instanced mesh buffers are added once per draw call
+    std::sort(g_instances.begin(), g_instances.end(),
+        std::less<SPMeshBuffer*>());
+    g_instances.erase(std::unique(g_instances.begin(), g_instances.end()),
+        g_instances.end());
     for (SPMeshBuffer* spmb : g_instances)
     {
         spmb->uploadInstanceData();
@@ -1289,13 +1459,13 @@ void drawGlow()
     SPUniformAssigner* glow_color_assigner =
         g_glow_shader->getUniformAssigner("col");
     assert(glow_color_assigner != NULL);
-    for (auto& p : g_glow_meshes)
+    for (unsigned i = 0; i < g_glow_meshes.size(); i++)
     {
-        glow_color_assigner->setValue(p.second.first);
-        for (SPMeshBuffer* spmb : p.second.second)
+        if (i == 0 || g_glow_meshes[i].m_key != g_glow_meshes[i - 1].m_key)
         {
-            spmb->draw(DCT_NORMAL, -1/*material_id*/);
+            glow_color_assigner->setValue(g_glow_meshes[i].m_color);
         }
+        g_glow_meshes[i].m_mb->draw(DCT_NORMAL, -1/*material_id*/);
     }
     g_glow_shader->unuse();
 }
@@ -93,6 +93,7 @@ extern std::atomic<uint32_t> sp_max_texture_size;
 extern unsigned sp_solid_poly_count;
 extern unsigned sp_shadow_poly_count;
 extern int sp_cur_shadow_cascade;
+extern bool sp_reuse_shadow_map;
 extern bool sp_culling;
 extern bool sp_debug_view;
 extern bool sp_apitrace;
@@ -120,6 +121,8 @@ void drawSPDebugView();
 // ----------------------------------------------------------------------------
 void addObject(SPMeshNode*);
 // ----------------------------------------------------------------------------
+void cullObjects();
+// ----------------------------------------------------------------------------
 void initSTKRenderer(ShaderBasedRenderer*);
 // ----------------------------------------------------------------------------
 void prepareScene();
@@ -29,6 +29,8 @@
 #include "utils/log.hpp"
 #include "utils/string_utils.hpp"
 
+#include <IImageLoader.h>
+
 #if !(defined(SERVER_ONLY) || defined(MOBILE_STK))
 #include <squish.h>
 static_assert(squish::kColourClusterFit == (1 << 5), "Wrong header");
@@ -434,46 +436,75 @@ std::shared_ptr<video::IImage> SPTexture::getTextureCache(const std::string& p,
 }   // getTextureCache
 
 // ----------------------------------------------------------------------------
-bool SPTexture::load()
+/** Does the CPU side of loading this texture: decodes the image or reads it
+ *  from the texture cache, applies the mask and compresses it if texture
+ *  compression is used. This function does not use OpenGL, so textures can
+ *  be prepared in parallel in worker threads, see
+ *  SPTextureManager::prefetchTextures().
+ */
+SPTexture::LoadedData SPTexture::prepareLoad()
 {
+    LoadedData data;
 #ifndef SERVER_ONLY
     std::string cache_loc;
     if (useTextureCache(m_path, &cache_loc))
     {
-        std::vector<std::pair<core::dimension2du, unsigned> > sizes;
-        std::shared_ptr<video::IImage> cache = getTextureCache(cache_loc,
-            &sizes);
-        if (cache)
-            return compressedTexImage2d(cache, sizes);
+        data.m_image = getTextureCache(cache_loc, &data.m_mipmap_sizes);
+        if (data.m_image)
+        {
+            data.m_compressed = true;
+            return data;
+        }
+        data.m_mipmap_sizes.clear();
     }
 
     std::shared_ptr<video::IImage> image = getTextureImage();
     if (!image)
-    {
-        m_width.store(2);
-        m_height.store(2);
-        return true;
-    }
+        return data;
+
     std::shared_ptr<video::IImage> mask = getMask(image->getDimension());
     if (mask)
     {
         applyMask(image.get(), mask.get());
     }
-    std::shared_ptr<video::IImage> mipmaps;
 
     if (!m_cache_directory.empty() && CVS->isTextureCompressionEnabled() &&
         image->getDimension().Width >= 4 && image->getDimension().Height >= 4)
     {
-        auto r = compressTexture(image);
-        compressedTexImage2d(image, r);
+        data.m_mipmap_sizes = compressTexture(image);
+        data.m_compressed = true;
         if (!cache_loc.empty())
-            saveCompressedTexture(image, r, cache_loc);
-    } else {
-        texImage2d(image, mipmaps);
+            saveCompressedTexture(image, data.m_mipmap_sizes, cache_loc);
     }
-
+    data.m_image = image;
 #endif
+    return data;
+}   // prepareLoad
+
+// ----------------------------------------------------------------------------
+/** Uploads the data from prepareLoad() to OpenGL, so it must be called in
+ *  the thread owning the GL context. */
+bool SPTexture::upload(const LoadedData& data)
+{
+#ifndef SERVER_ONLY
+    if (!data.m_image)
+    {
+        m_width.store(2);
+        m_height.store(2);
+        return true;
+    }
+    if (data.m_compressed)
+        return compressedTexImage2d(data.m_image, data.m_mipmap_sizes);
+    return texImage2d(data.m_image, NULL);
+#else
     return true;
+#endif
+}   // upload
+
+// ----------------------------------------------------------------------------
+bool SPTexture::load()
+{
+    return upload(prepareLoad());
 }   // load
 
 // ----------------------------------------------------------------------------
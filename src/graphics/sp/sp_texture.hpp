@@ -26,6 +26,7 @@
 #include <cassert>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <dimension2d.h>
 
@@ -43,6 +44,19 @@ namespace SP
 
 class SPTexture : public NoCopy
 {
+public:
+    /** The result of prepareLoad(), which is uploaded by upload(). */
+    struct LoadedData
+    {
+        /** The decoded image, or the compressed blocks of all mipmap levels
+         *  if m_compressed is set. NULL if the texture failed to load. */
+        std::shared_ptr<video::IImage> m_image;
+        /** Size and byte count of each compressed mipmap level. */
+        std::vector<std::pair<core::dimension2du, unsigned> > m_mipmap_sizes;
+        bool m_compressed;
+        LoadedData() : m_compressed(false) {}
+    };
+
 private:
     std::string m_path;
 
@@ -191,7 +205,10 @@ public:
     unsigned getHeight() const                      { return m_height.load(); }
     // ------------------------------------------------------------------------
     bool load();
-
+    // ------------------------------------------------------------------------
+    LoadedData prepareLoad();
+    // ------------------------------------------------------------------------
+    bool upload(const LoadedData& data);
 
 };
 
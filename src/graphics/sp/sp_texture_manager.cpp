@@ -19,10 +19,14 @@
 
 #include "graphics/sp/sp_texture_manager.hpp"
 #include "graphics/sp/sp_base.hpp"
+#include "graphics/sp/sp_shader.hpp"
+#include "graphics/sp/sp_shader_manager.hpp"
 #include "graphics/sp/sp_texture.hpp"
 #include "graphics/central_settings.hpp"
 #include "graphics/irr_driver.hpp"
+#include "graphics/material.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/thread_pool.hpp"
 #include "utils/vs.hpp"
 
 #include <string>
@@ -67,6 +71,79 @@ std::shared_ptr<SPTexture> SPTextureManager::getTexture(const std::string& p,
     return t;
 }   // getTexture
 
+// ----------------------------------------------------------------------------
+/** Loads all textures used by the given materials which are not loaded yet,
+ *  with the same parameters SPMeshBuffer uses when it requests them later.
+ *  Decoding, masking and compression of the textures run in parallel in the
+ *  thread pool, only the OpenGL upload is done in the calling thread, which
+ *  must own the GL context.
+ *  \param materials The materials whose textures should be loaded.
+ *  \return All textures of the materials. removeUnusedTextures() frees
+ *          textures no mesh uses, so the caller must keep these as long as
+ *          the materials can still be used.
+ */
+std::vector<std::shared_ptr<SPTexture> >
+    SPTextureManager::prefetchTextures(const std::vector<Material*>& materials)
+{
+    std::vector<std::shared_ptr<SPTexture> > all_textures;
+    std::vector<std::shared_ptr<SPTexture> > textures;
+    for (Material* m : materials)
+    {
+        // Same shader selection as SPMeshBuffer::setSTKMaterial(). Mesh
+        // buffers only merge materials with the same shader name, so this is
+        // the shader SPMeshBuffer::uploadGLMesh() uses for this material.
+        std::shared_ptr<SPShader> sps =
+            SPShaderManager::get()->getSPShader(m->getShaderName());
+        if (!sps)
+            sps = SPShaderManager::get()->getSPShader("solid");
+        if (!sps)
+            continue;
+        for (unsigned j = 0; j < 6; j++)
+        {
+            if (!sps->hasTextureLayer(j))
+                continue;
+            const std::string& p = m->getSamplerPath(j);
+            if (p.empty())
+                continue;
+            auto it = m_textures.find(p);
+            if (it != m_textures.end())
+            {
+                all_textures.push_back(it->second);
+                continue;
+            }
+            // Creating the texture needs OpenGL, so do it here
+            std::shared_ptr<SPTexture> t = std::make_shared<SPTexture>(p,
+                j == 0 ? m : NULL, sps->isSrgbForTextureLayer(j),
+                m->getContainerId());
+            m_textures[p] = t;
+            textures.push_back(t);
+            all_textures.push_back(t);
+        }
+    }
+    if (textures.empty())
+        return all_textures;
+
+    // Decode in batches, so that not all decoded images of a track are kept
+    // in memory at the same time
+    ThreadPool* pool = ThreadPool::get();
+    const unsigned batch_size = (pool->getNumThreads() + 1) * 2;
+    std::vector<SPTexture::LoadedData> data;
+    for (unsigned first = 0; first < textures.size(); first += batch_size)
+    {
+        const unsigned n = std::min(batch_size,
+                                    (unsigned)textures.size() - first);
+        data.clear();
+        data.resize(n);
+        pool->parallelFor(n, [&textures, &data, first](unsigned i)
+            {
+                data[i] = textures[first + i]->prepareLoad();
+            });
+        for (unsigned i = 0; i < n; i++)
+            textures[first + i]->upload(data[i]);
+    }
+    return all_textures;
+}   // prefetchTextures
+
 // ----------------------------------------------------------------------------
 void SPTextureManager::removeUnusedTextures()
 {
@@ -32,6 +32,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "irrString.h"
 
@@ -75,6 +76,9 @@ public:
                                           Material* m, bool undo_srgb,
                                           const std::string& container_id);
     // ------------------------------------------------------------------------
+    std::vector<std::shared_ptr<SPTexture> >
+                 prefetchTextures(const std::vector<Material*>& materials);
+    // ------------------------------------------------------------------------
     void dumpAllTextures();
     // ------------------------------------------------------------------------
     irr::core::stringw reloadTexture(const irr::core::stringw& name);
@@ -30,9 +30,15 @@ const uint8_t VERSION_NOW = 1;
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <IVideoDriver.h>
 #include <IFileSystem.h>
 
+#if __SSE2__ || _M_X64 || _M_IX86_FP >= 2
+ #include <emmintrin.h>
+ #define SIMD_SSE2_SUPPORT (1)
+#endif
+
 // ----------------------------------------------------------------------------
 bool SPMeshLoader::isALoadableFileExtension(const io::path& filename) const
 {
@@ -40,7 +46,42 @@ bool SPMeshLoader::isALoadableFileExtension(const io::path& filename) const
 }   // isALoadableFileExtension
 
 // ----------------------------------------------------------------------------
+/** Reads the whole file into memory and loads the mesh from there. Reading
+ *  every vertex field separately from a file is slow, especially on network
+ *  file systems.
+ */
 scene::IAnimatedMesh* SPMeshLoader::createMesh(io::IReadFile* f)
+{
+    if (f == NULL)
+    {
+        return NULL;
+    }
+    const long size = f->getSize() - f->getPos();
+    if (size <= 0)
+    {
+        Log::error("SPMeshLoader", "Empty spm file %s.",
+            f->getFileName().c_str());
+        return NULL;
+    }
+    m_file_data.resize(size);
+    if (f->read(m_file_data.data(), (s32)size) != (s32)size)
+    {
+        Log::error("SPMeshLoader", "Failed to read %s.",
+            f->getFileName().c_str());
+        std::vector<uint8_t>().swap(m_file_data);
+        return NULL;
+    }
+    io::IReadFile* mem = m_scene_manager->getFileSystem()
+        ->createMemoryReadFile(m_file_data.data(), (s32)size,
+        f->getFileName(), /*deleteMemoryWhenDropped*/false);
+    scene::IAnimatedMesh* mesh = loadMesh(mem);
+    mem->drop();
+    std::vector<uint8_t>().swap(m_file_data);
+    return mesh;
+}   // createMesh
+
+// ----------------------------------------------------------------------------
+scene::IAnimatedMesh* SPMeshLoader::loadMesh(io::IReadFile* f)
 {
 #ifndef SERVER_ONLY
     const bool real_spm = CVS->isGLSL();
@@ -52,10 +93,6 @@ scene::IAnimatedMesh* SPMeshLoader::createMesh(io::IReadFile* f)
         Log::error("SPMeshLoader", "Not little endian machine.");
         return NULL;
     }
-    if (f == NULL)
-    {
-        return NULL;
-    }
     m_bind_frame = 0;
     m_joint_count = 0;
     m_frame_count = 0;
@@ -266,9 +303,36 @@ scene::IAnimatedMesh* SPMeshLoader::createMesh(io::IReadFile* f)
     m_to_bind_pose_matrices.clear();
     m_joints.clear();
     return m_mesh;
-}   // createMesh
+}   // loadMesh
 
 // ----------------------------------------------------------------------------
+/** Converts 8 bit indices to 16 bit.
+ *  \param src The 8 bit indices.
+ *  \param dst Array of at least count 16 bit indices.
+ *  \param count Number of indices.
+ */
+static void widenIndices(const uint8_t* src, uint16_t* dst, unsigned count)
+{
+    unsigned i = 0;
+#ifdef SIMD_SSE2_SUPPORT
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i idx = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(idx, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 8),
+            _mm_unpackhi_epi8(idx, zero));
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = src[i];
+}   // widenIndices
+
+// ----------------------------------------------------------------------------
+/** Decodes the vertices and indices of a mesh buffer directly from
+ *  m_file_data into the layout used by SPMeshBuffer, starting at the
+ *  current position of spm. Afterwards spm is moved behind the mesh buffer.
+ */
 void SPMeshLoader::decompressSPM(irr::io::IReadFile* spm,
                                  unsigned vertices_count,
                                  unsigned indices_count, bool read_normal,
@@ -283,53 +347,60 @@ void SPMeshLoader::decompressSPM(irr::io::IReadFile* spm,
     SPMeshBuffer* mb = new SPMeshBuffer();
     static_cast<SPMesh*>(m_mesh)->m_buffer.push_back(mb);
     const unsigned idx_size = vertices_count > 255 ? 2 : 1;
+
+    const uint8_t* data = m_file_data.data();
+    const size_t data_size = m_file_data.size();
+    size_t pos = (size_t)spm->getPos();
+    bool truncated = false;
+    // Copies the next n bytes of the file, a truncated file leaves the
+    // remaining values unchanged like a short read would do
+    auto read = [&](void* dst, size_t n)
+    {
+        if (pos + n <= data_size)
+            memcpy(dst, data + pos, n);
+        else
+            truncated = true;
+        pos += n;
+    };
+
+    std::vector<video::S3DVertexSkinnedMesh> vertices(vertices_count);
     for (unsigned i = 0; i < vertices_count; i++)
     {
-        video::S3DVertexSkinnedMesh vertex = {};
+        video::S3DVertexSkinnedMesh& vertex = vertices[i];
         // 3 * float position
-        spm->read(&vertex.m_position, 12);
+        read(&vertex.m_position, 12);
         if (read_normal)
         {
-            spm->read(&vertex.m_normal, 4);
+            read(&vertex.m_normal, 4);
         }
         else
         {
             // 0, 1, 0
             vertex.m_normal = 0x1FF << 10;
         }
+        // The default color is all white
         if (read_vcolor)
         {
             // Color identifier
-            uint8_t ci;
-            spm->read(&ci, 1);
-            if (ci == 128)
-            {
-                // All white
-                vertex.m_color = video::SColor(255, 255, 255, 255);
-            }
-            else
+            uint8_t ci = 128;
+            read(&ci, 1);
+            if (ci != 128)
             {
-                uint8_t r, g, b;
-                spm->read(&r, 1);
-                spm->read(&g, 1);
-                spm->read(&b, 1);
-                vertex.m_color = video::SColor(255, r, g, b);
+                uint8_t rgb[3] = {};
+                read(rgb, 3);
+                vertex.m_color = video::SColor(255, rgb[0], rgb[1], rgb[2]);
             }
         }
-        else
-        {
-            vertex.m_color = video::SColor(255, 255, 255, 255);
-        }
         if (uv_one)
         {
-            spm->read(&vertex.m_all_uvs[0], 4);
+            read(&vertex.m_all_uvs[0], 4);
             if (uv_two)
             {
-                spm->read(&vertex.m_all_uvs[2], 4);
+                read(&vertex.m_all_uvs[2], 4);
             }
             if (read_tangent)
             {
-                spm->read(&vertex.m_tangent, 4);
+                read(&vertex.m_tangent, 4);
             }
             else
             {
@@ -338,7 +409,7 @@ void SPMeshLoader::decompressSPM(irr::io::IReadFile* spm,
         }
         if (vt == SPVT_SKINNED)
         {
-            spm->read(&vertex.m_joint_idx[0], 16);
+            read(&vertex.m_joint_idx[0], 16);
             if (vertex.m_joint_idx[0] == -1 ||
                 vertex.m_weight[0] == 0 ||
                 // -0.0 in half float (16bit)
@@ -350,28 +421,34 @@ void SPMeshLoader::decompressSPM(irr::io::IReadFile* spm,
                 vertex.m_weight[0] = 15360;
             }
         }
-        mb->addSPMVertex(vertex);
     }
+    mb->setSPMVertices(vertices);
 
     std::vector<uint16_t> indices;
     indices.resize(indices_count);
-    if (idx_size == 2)
+    if (pos + indices_count * idx_size > data_size)
     {
-        spm->read(indices.data(), indices_count * 2);
+        truncated = true;
+    }
+    else if (idx_size == 2)
+    {
+        memcpy(indices.data(), data + pos, indices_count * 2);
     }
     else
     {
-        std::vector<uint8_t> tmp_idx;
-        tmp_idx.resize(indices_count);
-        spm->read(tmp_idx.data(), indices_count);
-        for (unsigned i = 0; i < indices_count; i++)
-        {
-            indices[i] = tmp_idx[i];
-        }
+        widenIndices(data + pos, indices.data(), indices_count);
     }
+    pos += indices_count * idx_size;
     mb->setIndices(indices);
     mb->setSTKMaterial(m);
 
+    if (truncated)
+    {
+        Log::error("SPMeshLoader", "Unexpected end of file in %s.",
+            spm->getFileName().c_str());
+        pos = data_size;
+    }
+    spm->seek((long)pos);
 }   // decompressSPM
 
 // ----------------------------------------------------------------------------
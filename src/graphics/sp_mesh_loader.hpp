@@ -59,6 +59,8 @@ private:
                        bool uv_two, SPVertexType vt,
                        Material* m);
     // ------------------------------------------------------------------------
+    scene::IAnimatedMesh* loadMesh(io::IReadFile* f);
+    // ------------------------------------------------------------------------
     void createAnimationData(irr::io::IReadFile* spm);
     // ------------------------------------------------------------------------
     void convertIrrlicht();
@@ -70,6 +72,10 @@ private:
     std::vector<std::vector<
         std::pair<std::array<short, 4>, std::array<float, 4> > > > m_joints;
 
+    /** The whole content of the file being loaded. It is read with a single
+     *  call, and the vertices are decoded directly from it. */
+    std::vector<uint8_t> m_file_data;
+
 public:
     // ------------------------------------------------------------------------
     SPMeshLoader(scene::ISceneManager* smgr) : m_scene_manager(smgr) {}
@@ -25,6 +25,11 @@
 #include <cmath>
 #include "../../lib/irrlicht/source/Irrlicht/os.h"
 
+#if __SSE2__ || _M_X64 || _M_IX86_FP >= 2
+ #include <emmintrin.h>
+ #define SIMD_SSE2_SUPPORT (1)
+#endif
+
 // ----------------------------------------------------------------------------
 std::vector<float> STKParticle::m_flips_data;
 GLuint STKParticle::m_flips_buffer = 0;
@@ -48,6 +53,7 @@ STKParticle::STKParticle(bool randomize_initial_y, ISceneNode* parent, s32 id,
     m_randomize_initial_y = randomize_initial_y;
     m_flips = false;
     m_max_count = 0;
+    m_simulated_frame = 0;
     m_y_min = -10000;
     drop();
 }   // STKParticle
@@ -83,23 +89,21 @@ static void generateLifetimeSizeDirection(scene::IParticleEmitter *emitter,
 void STKParticle::generateParticlesFromPointEmitter
     (scene::IParticlePointEmitter *emitter)
 {
-    m_particles_generating.clear();
-    m_initial_particles.clear();
     m_particles_generating.resize(m_max_count);
     m_initial_particles.resize(m_max_count);
     for (unsigned i = 0; i < m_max_count; i++)
     {
         // Initial lifetime is > 1
-        m_particles_generating[i].m_lifetime = 2.0f;
+        m_particles_generating.m_lifetime[i] = 2.0f;
 
+        core::vector3df direction;
         generateLifetimeSizeDirection(emitter,
-            m_initial_particles[i].m_lifetime,
-            m_particles_generating[i].m_size,
-            m_particles_generating[i].m_direction);
+            m_initial_particles.m_lifetime[i],
+            m_particles_generating.m_size[i], direction);
 
-        m_initial_particles[i].m_direction =
-            m_particles_generating[i].m_direction;
-        m_initial_particles[i].m_size = m_particles_generating[i].m_size;
+        m_particles_generating.setDirection(i, direction);
+        m_initial_particles.setDirection(i, direction);
+        m_initial_particles.m_size[i] = m_particles_generating.m_size[i];
     }
 }   // generateParticlesFromPointEmitter
 
@@ -107,41 +111,40 @@ void STKParticle::generateParticlesFromPointEmitter
 void STKParticle::generateParticlesFromBoxEmitter
     (scene::IParticleBoxEmitter *emitter)
 {
-    m_particles_generating.clear();
-    m_initial_particles.clear();
     m_particles_generating.resize(m_max_count);
     m_initial_particles.resize(m_max_count);
     const core::vector3df& extent = emitter->getBox().getExtent();
     for (unsigned i = 0; i < m_max_count; i++)
     {
-        m_particles_generating[i].m_position.X =
+        core::vector3df position;
+        position.X =
             emitter->getBox().MinEdge.X + os::Randomizer::frand() * extent.X;
-        m_particles_generating[i].m_position.Y =
+        position.Y =
             emitter->getBox().MinEdge.Y + os::Randomizer::frand() * extent.Y;
-        m_particles_generating[i].m_position.Z =
+        position.Z =
             emitter->getBox().MinEdge.Z + os::Randomizer::frand() * extent.Z;
+        m_particles_generating.setPosition(i, position);
 
         // Initial lifetime is random
-        m_particles_generating[i].m_lifetime = os::Randomizer::frand();
+        m_particles_generating.m_lifetime[i] = os::Randomizer::frand();
         if (!m_randomize_initial_y)
         {
-            m_particles_generating[i].m_lifetime += 1.0f;
+            m_particles_generating.m_lifetime[i] += 1.0f;
         }
-        m_initial_particles[i].m_position =
-            m_particles_generating[i].m_position;
+        m_initial_particles.setPosition(i, position);
 
+        core::vector3df direction;
         generateLifetimeSizeDirection(emitter,
-            m_initial_particles[i].m_lifetime,
-            m_particles_generating[i].m_size,
-            m_particles_generating[i].m_direction);
+            m_initial_particles.m_lifetime[i],
+            m_particles_generating.m_size[i], direction);
 
-        m_initial_particles[i].m_direction =
-            m_particles_generating[i].m_direction;
-        m_initial_particles[i].m_size = m_particles_generating[i].m_size;
+        m_particles_generating.setDirection(i, direction);
+        m_initial_particles.setDirection(i, direction);
+        m_initial_particles.m_size[i] = m_particles_generating.m_size[i];
 
         if (m_randomize_initial_y)
         {
-            m_initial_particles[i].m_position.Y =
+            m_initial_particles.m_position[1][i] =
                 os::Randomizer::frand() * 50.0f; // -100.0f;
         }
     }
@@ -151,8 +154,6 @@ void STKParticle::generateParticlesFromBoxEmitter
 void STKParticle::generateParticlesFromSphereEmitter
     (scene::IParticleSphereEmitter *emitter)
 {
-    m_particles_generating.clear();
-    m_initial_particles.clear();
     m_particles_generating.resize(m_max_count);
     m_initial_particles.resize(m_max_count);
     for (unsigned i = 0; i < m_max_count; i++)
@@ -166,21 +167,20 @@ void STKParticle::generateParticlesFromSphereEmitter
         pos.rotateYZBy(os::Randomizer::frand() * 360.f, emitter->getCenter());
         pos.rotateXZBy(os::Randomizer::frand() * 360.f, emitter->getCenter());
 
-        m_particles_generating[i].m_position = pos;
+        m_particles_generating.setPosition(i, pos);
 
         // Initial lifetime is > 1
-        m_particles_generating[i].m_lifetime = 2.0f;
-        m_initial_particles[i].m_position =
-            m_particles_generating[i].m_position;
+        m_particles_generating.m_lifetime[i] = 2.0f;
+        m_initial_particles.setPosition(i, pos);
 
+        core::vector3df direction;
         generateLifetimeSizeDirection(emitter,
-            m_initial_particles[i].m_lifetime,
-            m_particles_generating[i].m_size,
-            m_particles_generating[i].m_direction);
+            m_initial_particles.m_lifetime[i],
+            m_particles_generating.m_size[i], direction);
 
-        m_initial_particles[i].m_direction =
-            m_particles_generating[i].m_direction;
-        m_initial_particles[i].m_size = m_particles_generating[i].m_size;
+        m_particles_generating.setDirection(i, direction);
+        m_initial_particles.setDirection(i, direction);
+        m_initial_particles.m_size[i] = m_particles_generating.m_size[i];
     }
 }   // generateParticlesFromSphereEmitter
 
@@ -232,12 +232,24 @@ void STKParticle::setEmitter(scene::IParticleEmitter* emitter)
 }   // setEmitter
 
 // ----------------------------------------------------------------------------
-void STKParticle::generate(std::vector<CPUParticle>* out, float dt_in_sec)
+/** Simulates the particles and adds them to out.
+ *  \param out The particles to draw, NULL to only simulate them.
+ *  \param dt_in_sec Time step of the simulation.
+ *  \param simulate If false the particles of the last simulation are added
+ *         again, used if the node is drawn in several views of a frame.
+ */
+void STKParticle::generate(std::vector<CPUParticle>* out, float dt_in_sec,
+                           bool simulate)
 {
     if (!getEmitter())
     {
         return;
     }
+    if (!simulate)
+    {
+        addParticles(out);
+        return;
+    }
 
     Buffer->BoundingBox.reset(AbsoluteTransformation.getTranslation());
     int active_count = getEmitter()->getMaxLifeTime() *
@@ -250,11 +262,11 @@ void STKParticle::generate(std::vector<CPUParticle>* out, float dt_in_sec)
         {
             if (m_y_min > -10000)
             {
-                stimulateHeightMap((float)i, active_count, NULL);
+                stimulateHeightMap((float)i);
             }
             else
             {
-                stimulateNormal((float)i, active_count, NULL);
+                stimulateNormal((float)i, active_count);
             }
         }
         m_first_execution = false;
@@ -263,12 +275,13 @@ void STKParticle::generate(std::vector<CPUParticle>* out, float dt_in_sec)
     float dt = dt_in_sec * 1000.f;
     if (m_y_min > -10000)
     {
-        stimulateHeightMap(dt, active_count, out);
+        stimulateHeightMap(dt);
     }
     else
     {
-        stimulateNormal(dt, active_count, out);
+        stimulateNormal(dt, active_count);
     }
+    addParticles(out);
     m_previous_frame_matrix = AbsoluteTransformation;
 
     core::matrix4 inv(AbsoluteTransformation, core::matrix4::EM4CONST_INVERSE);
@@ -288,161 +301,365 @@ inline float glslMix(float x, float y, float a)
     return x * (1.0f - a) + y * a;
 }   // glslMix
 
+#ifdef SIMD_SSE2_SUPPORT
+// ----------------------------------------------------------------------------
+/** Loads the values of 4 particles with the given indices. */
+static inline __m128 gather4(const std::vector<float>& v, const unsigned* idx)
+{
+    return _mm_setr_ps(v[idx[0]], v[idx[1]], v[idx[2]], v[idx[3]]);
+}   // gather4
+
+// ----------------------------------------------------------------------------
+/** Stores the values of 4 particles with the given indices. */
+static inline void scatter4(std::vector<float>& v, const unsigned* idx,
+                            __m128 value)
+{
+    float tmp[4];
+    _mm_storeu_ps(tmp, value);
+    for (int k = 0; k < 4; k++)
+        v[idx[k]] = tmp[k];
+}   // scatter4
+
 // ----------------------------------------------------------------------------
-void STKParticle::stimulateHeightMap(float dt, unsigned int active_count,
-                                     std::vector<CPUParticle>* out)
+/** Transforms 4 vectors by the matrix m like core::matrix4::transformVect,
+ *  or like core::matrix4::rotateVect if translate is false.
+ */
+static inline void transform4(const core::matrix4& m, const __m128* in,
+                              bool translate, __m128* out)
+{
+    for (int r = 0; r < 3; r++)
+    {
+        __m128 v = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(in[0], _mm_set1_ps(m[r])),
+            _mm_mul_ps(in[1], _mm_set1_ps(m[4 + r]))),
+            _mm_mul_ps(in[2], _mm_set1_ps(m[8 + r])));
+        out[r] = translate ? _mm_add_ps(v, _mm_set1_ps(m[12 + r])) : v;
+    }
+}   // transform4
+#endif
+
+// ----------------------------------------------------------------------------
+/** Moves all particles for weather effects, which are respawned when they
+ *  fall below m_y_min. Particles are moved 4 at a time with SSE if
+ *  available, the particles to respawn are collected and then respawned 4
+ *  at a time as well.
+ */
+void STKParticle::stimulateHeightMap(float dt)
 {
     const core::matrix4 cur_matrix = AbsoluteTransformation;
-    for (unsigned i = 0; i < m_max_count; i++)
+    ParticleData& particles = m_particles_generating;
+    const ParticleData& initial = m_initial_particles;
+    m_respawn.clear();
+    unsigned i = 0;
+#ifdef SIMD_SSE2_SUPPORT
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 y_min = _mm_set1_ps(m_y_min);
+    const __m128 factor = _mm_set1_ps(m_size_increase_factor);
+    for (; i + 4 <= m_max_count; i += 4)
     {
-        core::vector3df new_particle_direction = m_particles_generating[i].m_direction;
-        core::vector3df new_particle_position = m_particles_generating[i].m_position + dt * new_particle_direction;
-
-        const float lifetime = m_particles_generating[i].m_lifetime;
-        float new_lifetime = lifetime + (dt / m_initial_particles[i].m_lifetime);
-        float new_size = 0.0f;
-
-        if (new_particle_position.Y < m_y_min || lifetime < 0.0f || new_lifetime > 1.0f) {
-            core::vector3df initial_position, initial_new_position;
-            cur_matrix.transformVect(initial_position, m_initial_particles[i].m_position);
-            cur_matrix.transformVect(initial_new_position,
-                m_initial_particles[i].m_position + m_initial_particles[i].m_direction);
-
-            new_particle_position = initial_position;
-            new_lifetime = 0.f;
-            new_particle_direction = initial_new_position - initial_position;
+        __m128 position[3];
+        for (int j = 0; j < 3; j++)
+        {
+            position[j] = _mm_add_ps(_mm_loadu_ps(&particles.m_position[j][i]),
+                _mm_mul_ps(vdt, _mm_loadu_ps(&particles.m_direction[j][i])));
+            _mm_storeu_ps(&particles.m_position[j][i], position[j]);
         }
-        else {
-            const float size_initial = m_initial_particles[i].m_size;
-            new_size = size_initial * glslMix(1, m_size_increase_factor, new_lifetime);
+        const __m128 lifetime = _mm_loadu_ps(&particles.m_lifetime[i]);
+        const __m128 new_lifetime = _mm_add_ps(lifetime,
+            _mm_div_ps(vdt, _mm_loadu_ps(&initial.m_lifetime[i])));
+        _mm_storeu_ps(&particles.m_lifetime[i], new_lifetime);
+        // size_initial * glslMix(1, m_size_increase_factor, new_lifetime)
+        const __m128 mix = _mm_add_ps(_mm_sub_ps(one, new_lifetime),
+                                      _mm_mul_ps(factor, new_lifetime));
+        _mm_storeu_ps(&particles.m_size[i],
+                      _mm_mul_ps(_mm_loadu_ps(&initial.m_size[i]), mix));
+
+        const int respawn = _mm_movemask_ps(_mm_or_ps(_mm_or_ps(
+            _mm_cmplt_ps(position[1], y_min), _mm_cmplt_ps(lifetime, zero)),
+            _mm_cmpgt_ps(new_lifetime, one)));
+        for (int k = 0; k < 4; k++)
+        {
+            if (respawn & (1 << k))
+                m_respawn.push_back(i + k);
         }
+    }
+#endif
+    for (; i < m_max_count; i++)
+    {
+        for (int j = 0; j < 3; j++)
+            particles.m_position[j][i] += dt * particles.m_direction[j][i];
+        const float lifetime = particles.m_lifetime[i];
+        const float new_lifetime = lifetime + (dt / initial.m_lifetime[i]);
+        particles.m_lifetime[i] = new_lifetime;
+        particles.m_size[i] = initial.m_size[i] *
+            glslMix(1, m_size_increase_factor, new_lifetime);
+        if (particles.m_position[1][i] < m_y_min || lifetime < 0.0f ||
+            new_lifetime > 1.0f)
+            m_respawn.push_back(i);
+    }
 
-        m_particles_generating[i].m_position = new_particle_position;
-        m_particles_generating[i].m_lifetime = new_lifetime;
-        m_particles_generating[i].m_direction = new_particle_direction;
-        m_particles_generating[i].m_size = new_size;
-        if (out != NULL)
+    // Respawn at the initial position relative to the emitter
+    unsigned k = 0;
+#ifdef SIMD_SSE2_SUPPORT
+    for (; k + 4 <= m_respawn.size(); k += 4)
+    {
+        const unsigned* idx = &m_respawn[k];
+        __m128 position[3], new_position[3], end[3], new_end[3];
+        for (int j = 0; j < 3; j++)
         {
-            if (m_flips || new_size != 0.0f)
-            {
-                if (new_size != 0.0f)
-                {
-                    Buffer->BoundingBox.addInternalPoint
-                        (new_particle_position);
-                }
-                out->emplace_back(new_particle_position, m_color_from,
-                    m_color_to, new_lifetime, new_size);
-            }
+            position[j] = gather4(initial.m_position[j], idx);
+            end[j] = _mm_add_ps(position[j],
+                                gather4(initial.m_direction[j], idx));
+        }
+        transform4(cur_matrix, position, /*translate*/true, new_position);
+        transform4(cur_matrix, end, /*translate*/true, new_end);
+        for (int j = 0; j < 3; j++)
+        {
+            scatter4(particles.m_position[j], idx, new_position[j]);
+            scatter4(particles.m_direction[j], idx,
+                     _mm_sub_ps(new_end[j], new_position[j]));
         }
+        scatter4(particles.m_lifetime, idx, zero);
+        scatter4(particles.m_size, idx, zero);
+    }
+#endif
+    for (; k < m_respawn.size(); k++)
+    {
+        const unsigned n = m_respawn[k];
+        core::vector3df initial_position, initial_new_position;
+        cur_matrix.transformVect(initial_position, initial.getPosition(n));
+        cur_matrix.transformVect(initial_new_position,
+            initial.getPosition(n) + initial.getDirection(n));
+
+        particles.setPosition(n, initial_position);
+        particles.setDirection(n, initial_new_position - initial_position);
+        particles.m_lifetime[n] = 0.0f;
+        particles.m_size[n] = 0.0f;
     }
 }   // stimulateHeightMap
 
 // ----------------------------------------------------------------------------
-void STKParticle::stimulateNormal(float dt, unsigned int active_count,
-                                  std::vector<CPUParticle>* out)
+/** Respawns the particle i, whose lifetime is over, at the emitter. The
+ *  position is interpolated between the emitter positions of the previous
+ *  and current frame, depending on when in this frame the particle was
+ *  spawned.
+ *  \param i Index of the particle.
+ *  \param updated_lifetime The lifetime of the particle after this update,
+ *         which is larger than 1.
+ *  \param dt Time step in ms.
+ */
+void STKParticle::respawnNormal(unsigned i, float updated_lifetime, float dt)
 {
-    const core::matrix4 cur_matrix = AbsoluteTransformation;
+    const ParticleData& initial = m_initial_particles;
+    const float lifetime_initial = initial.m_lifetime[i];
+    const float size_initial = initial.m_size[i];
+    const core::vector3df particle_position_initial = initial.getPosition(i);
+    const core::vector3df particle_direction_initial = initial.getDirection(i);
+
+    float dt_from_last_frame = glslFract(updated_lifetime) * lifetime_initial;
+    float coeff = dt_from_last_frame / dt;
+
     core::vector3df previous_frame_position, current_frame_position,
         previous_frame_direction, current_frame_direction;
-    for (unsigned i = 0; i < m_max_count; i++)
+    m_previous_frame_matrix.transformVect(previous_frame_position,
+        particle_position_initial);
+    AbsoluteTransformation.transformVect(current_frame_position,
+        particle_position_initial);
+
+    core::vector3df updated_position = previous_frame_position
+        .getInterpolated(current_frame_position, coeff);
+
+    m_previous_frame_matrix.rotateVect(previous_frame_direction,
+        particle_direction_initial);
+    AbsoluteTransformation.rotateVect(current_frame_direction,
+        particle_direction_initial);
+
+    core::vector3df updated_direction = previous_frame_direction
+        .getInterpolated(current_frame_direction, coeff);
+    // + (current_frame_position - previous_frame_position) / dt;
+
+    // To be accurate, emitter speed should be added.
+    // But the simple formula
+    // ( (current_frame_position - previous_frame_position) / dt )
+    // with a constant speed between 2 frames creates visual
+    // artifacts when the framerate is low, and a more accurate
+    // formula would need more complex computations.
+
+    m_particles_generating.setPosition(i, updated_position +
+        dt_from_last_frame * updated_direction);
+    m_particles_generating.setDirection(i, updated_direction);
+    m_particles_generating.m_lifetime[i] = glslFract(updated_lifetime);
+    m_particles_generating.m_size[i] = glslMix(size_initial,
+        size_initial * m_size_increase_factor, glslFract(updated_lifetime));
+}   // respawnNormal
+
+// ----------------------------------------------------------------------------
+/** Moves all particles of the emitter. Particles are moved 4 at a time with
+ *  SSE if available. Particles whose lifetime is over are respawned if they
+ *  are among the first active_count particles, otherwise they are hidden.
+ *  The particles to respawn are collected and respawned 4 at a time as well,
+ *  so that each matrix transform is computed for 4 particles at once.
+ */
+void STKParticle::stimulateNormal(float dt, unsigned int active_count)
+{
+    ParticleData& particles = m_particles_generating;
+    const ParticleData& initial = m_initial_particles;
+    m_respawn.clear();
+    unsigned i = 0;
+#ifdef SIMD_SSE2_SUPPORT
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 factor = _mm_set1_ps(m_size_increase_factor);
+    for (; i + 4 <= m_max_count; i += 4)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            _mm_storeu_ps(&particles.m_position[j][i], _mm_add_ps(
+                _mm_loadu_ps(&particles.m_position[j][i]),
+                _mm_mul_ps(_mm_loadu_ps(&particles.m_direction[j][i]), vdt)));
+        }
+        const __m128 size_initial = _mm_loadu_ps(&initial.m_size[i]);
+        const __m128 updated_lifetime = _mm_add_ps(
+            _mm_loadu_ps(&particles.m_lifetime[i]),
+            _mm_div_ps(vdt, _mm_loadu_ps(&initial.m_lifetime[i])));
+        _mm_storeu_ps(&particles.m_lifetime[i], updated_lifetime);
+        // glslMix(size_initial, size_initial * m_size_increase_factor,
+        //         updated_lifetime), or 0 if the particle is hidden
+        const __m128 size = _mm_loadu_ps(&particles.m_size[i]);
+        const __m128 new_size = _mm_add_ps(
+            _mm_mul_ps(size_initial, _mm_sub_ps(one, updated_lifetime)),
+            _mm_mul_ps(_mm_mul_ps(size_initial, factor), updated_lifetime));
+        _mm_storeu_ps(&particles.m_size[i],
+                      _mm_andnot_ps(_mm_cmpeq_ps(size, zero), new_size));
+
+        const int respawn =
+            _mm_movemask_ps(_mm_cmpgt_ps(updated_lifetime, one));
+        for (int k = 0; k < 4; k++)
+        {
+            if (respawn & (1 << k))
+                m_respawn.push_back(i + k);
+        }
+    }
+#endif
+    for (; i < m_max_count; i++)
     {
-        core::vector3df new_particle_position;
-        core::vector3df new_particle_direction;
-        float new_size = 0.0f;
-        float new_lifetime = 0.0f;
-
-        const core::vector3df particle_position =
-            m_particles_generating[i].m_position;
-        const float lifetime = m_particles_generating[i].m_lifetime;
-        const core::vector3df particle_direction =
-            m_particles_generating[i].m_direction;
-        const float size = m_particles_generating[i].m_size;
-
-        const core::vector3df particle_position_initial =
-            m_initial_particles[i].m_position;
-        const float lifetime_initial = m_initial_particles[i].m_lifetime;
-        const core::vector3df particle_direction_initial =
-            m_initial_particles[i].m_direction;
-        const float size_initial = m_initial_particles[i].m_size;
-
-        float updated_lifetime = lifetime + (dt / lifetime_initial);
+        const float updated_lifetime = particles.m_lifetime[i] +
+            (dt / initial.m_lifetime[i]);
         if (updated_lifetime > 1.0f)
         {
-            if (i < active_count)
-            {
-                float dt_from_last_frame =
-                    glslFract(updated_lifetime) * lifetime_initial;
-                float coeff = dt_from_last_frame / dt;
-
-                m_previous_frame_matrix.transformVect(previous_frame_position,
-                    particle_position_initial);
-                cur_matrix.transformVect(current_frame_position,
-                    particle_position_initial);
-
-                core::vector3df updated_position = previous_frame_position
-                    .getInterpolated(current_frame_position, coeff);
-
-                m_previous_frame_matrix.rotateVect(previous_frame_direction,
-                    particle_direction_initial);
-                cur_matrix.rotateVect(current_frame_direction,
-                    particle_direction_initial);
-
-                core::vector3df updated_direction = previous_frame_direction
-                    .getInterpolated(current_frame_direction, coeff);
-                // + (current_frame_position - previous_frame_position) / dt;
-
-                // To be accurate, emitter speed should be added.
-                // But the simple formula
-                // ( (current_frame_position - previous_frame_position) / dt )
-                // with a constant speed between 2 frames creates visual
-                // artifacts when the framerate is low, and a more accurate
-                // formula would need more complex computations.
-
-                new_particle_position = updated_position + dt_from_last_frame *
-                    updated_direction;
-                new_particle_direction = updated_direction;
-
-                new_lifetime = glslFract(updated_lifetime);
-                new_size = glslMix(size_initial,
-                    size_initial * m_size_increase_factor,
-                    glslFract(updated_lifetime));
-            }
-            else
-            {
-                new_lifetime = glslFract(updated_lifetime);
-                new_size = 0.0f;
-            }
+            m_respawn.push_back(i);
+            particles.m_lifetime[i] = updated_lifetime;
+            continue;
+        }
+        for (int j = 0; j < 3; j++)
+            particles.m_position[j][i] += particles.m_direction[j][i] * dt;
+        const float size_initial = initial.m_size[i];
+        particles.m_lifetime[i] = updated_lifetime;
+        particles.m_size[i] = (particles.m_size[i] == 0.0f) ? 0.0f :
+            glslMix(size_initial, size_initial * m_size_increase_factor,
+            updated_lifetime);
+    }
+
+    // Inactive particles are hidden, they are removed from m_respawn so
+    // that it only contains particles to respawn
+    unsigned num_respawn = 0;
+    for (unsigned n : m_respawn)
+    {
+        if (n < active_count)
+        {
+            m_respawn[num_respawn++] = n;
+            continue;
+        }
+        particles.setPosition(n, core::vector3df(0.0f));
+        particles.setDirection(n, core::vector3df(0.0f));
+        particles.m_lifetime[n] = glslFract(particles.m_lifetime[n]);
+        particles.m_size[n] = 0.0f;
+    }
+    m_respawn.resize(num_respawn);
+
+    unsigned k = 0;
+#ifdef SIMD_SSE2_SUPPORT
+    const core::matrix4& cur_matrix = AbsoluteTransformation;
+    for (; k + 4 <= m_respawn.size(); k += 4)
+    {
+        const unsigned* idx = &m_respawn[k];
+        const __m128 updated_lifetime = gather4(particles.m_lifetime, idx);
+        // The lifetime is > 1, so truncating is the same as floor
+        const __m128 fract = _mm_sub_ps(updated_lifetime,
+            _mm_cvtepi32_ps(_mm_cvttps_epi32(updated_lifetime)));
+        const __m128 dt_from_last_frame =
+            _mm_mul_ps(fract, gather4(initial.m_lifetime, idx));
+        const __m128 coeff = _mm_div_ps(dt_from_last_frame, vdt);
+        const __m128 inv_coeff = _mm_sub_ps(one, coeff);
+
+        __m128 position[3], direction[3], previous[3], current[3];
+        for (int j = 0; j < 3; j++)
+        {
+            position[j] = gather4(initial.m_position[j], idx);
+            direction[j] = gather4(initial.m_direction[j], idx);
         }
-        else
+        // Same as core::vector3df::getInterpolated, i.e. the position in
+        // the current frame is weighted with (1 - coeff)
+        transform4(m_previous_frame_matrix, direction, /*translate*/false,
+                   previous);
+        transform4(cur_matrix, direction, /*translate*/false, current);
+        for (int j = 0; j < 3; j++)
         {
-            new_particle_position = particle_position +
-                particle_direction * dt;
-            new_particle_direction = particle_direction;
-            new_lifetime = updated_lifetime;
-            new_size = (size == 0.0f) ? 0.0f :
-                glslMix(size_initial, size_initial * m_size_increase_factor,
-                updated_lifetime);
+            direction[j] = _mm_add_ps(_mm_mul_ps(current[j], inv_coeff),
+                                      _mm_mul_ps(previous[j], coeff));
         }
-        m_particles_generating[i].m_position = new_particle_position;
-        m_particles_generating[i].m_lifetime = new_lifetime;
-        m_particles_generating[i].m_direction = new_particle_direction;
-        m_particles_generating[i].m_size = new_size;
-        if (out != NULL)
+        transform4(m_previous_frame_matrix, position, /*translate*/true,
+                   previous);
+        transform4(cur_matrix, position, /*translate*/true, current);
+        for (int j = 0; j < 3; j++)
         {
-            if (m_flips || new_size != 0.0f)
-            {
-                if (new_size != 0.0f)
-                {
-                    Buffer->BoundingBox.addInternalPoint
-                        (new_particle_position);
-                }
-                out->emplace_back(new_particle_position, m_color_from,
-                    m_color_to, new_lifetime, new_size);
-            }
+            position[j] = _mm_add_ps(_mm_mul_ps(current[j], inv_coeff),
+                                     _mm_mul_ps(previous[j], coeff));
+            scatter4(particles.m_position[j], idx, _mm_add_ps(position[j],
+                _mm_mul_ps(dt_from_last_frame, direction[j])));
+            scatter4(particles.m_direction[j], idx, direction[j]);
         }
+        const __m128 size_initial = gather4(initial.m_size, idx);
+        scatter4(particles.m_lifetime, idx, fract);
+        scatter4(particles.m_size, idx, _mm_add_ps(
+            _mm_mul_ps(size_initial, _mm_sub_ps(one, fract)),
+            _mm_mul_ps(_mm_mul_ps(size_initial, factor), fract)));
+    }
+#endif
+    for (; k < m_respawn.size(); k++)
+    {
+        const unsigned n = m_respawn[k];
+        respawnNormal(n, particles.m_lifetime[n], dt);
     }
 }   // stimulateNormal
 
+// ----------------------------------------------------------------------------
+/** Adds all visible particles to out and updates the bounding box.
+ *  \param out The particles to draw, can be NULL.
+ */
+void STKParticle::addParticles(std::vector<CPUParticle>* out)
+{
+    if (out == NULL)
+        return;
+    const ParticleData& particles = m_particles_generating;
+    for (unsigned i = 0; i < m_max_count; i++)
+    {
+        const float size = particles.m_size[i];
+        if (!m_flips && size == 0.0f)
+            continue;
+        const core::vector3df position = particles.getPosition(i);
+        if (size != 0.0f)
+        {
+            Buffer->BoundingBox.addInternalPoint(position);
+        }
+        out->emplace_back(position, m_color_from, m_color_to,
+            particles.m_lifetime[i], size);
+    }
+}   // addParticles
+
 // ----------------------------------------------------------------------------
 void STKParticle::updateFlips(unsigned maximum_particle_count)
 {
@@ -478,9 +695,10 @@ void STKParticle::OnRegisterSceneNode()
     generate(NULL);
     Particles.clear();
     Buffer->BoundingBox.reset(AbsoluteTransformation.getTranslation());
-    for (unsigned i = 0; i < m_particles_generating.size(); i++)
+    for (unsigned i = 0; i < m_particles_generating.m_size.size(); i++)
     {
-        if (m_particles_generating[i].m_size == 0.0f)
+        const float size = m_particles_generating.m_size[i];
+        if (size == 0.0f)
         {
             continue;
         }
@@ -489,12 +707,11 @@ void STKParticle::OnRegisterSceneNode()
         p.endTime = 0;
         p.color = 0;
         p.startColor = 0;
-        p.pos = m_particles_generating[i].m_position;
+        p.pos = m_particles_generating.getPosition(i);
         Buffer->BoundingBox.addInternalPoint(p.pos);
-        p.size = core::dimension2df(m_particles_generating[i].m_size,
-            m_particles_generating[i].m_size);
+        p.size = core::dimension2df(size, size);
         core::vector3df ret = m_color_from + (m_color_to - m_color_from) *
-            m_particles_generating[i].m_lifetime;
+            m_particles_generating.m_lifetime[i];
         p.color.setRed(core::clamp((int)(ret.X * 255.0f), 0, 255));
         p.color.setBlue(core::clamp((int)(ret.Y * 255.0f), 0, 255));
         p.color.setGreen(core::clamp((int)(ret.Z * 255.0f), 0, 255));
@@ -33,17 +33,61 @@ class STKParticle : public scene::CParticleSystemSceneNode
 {
 private:
     // ------------------------------------------------------------------------
+    /** The state of all particles of a node, stored as one array per
+     *  component so that the particles can be updated 4 at a time with
+     *  SSE. */
     struct ParticleData
     {
-        core::vector3df m_position;
-        float m_lifetime;
-        core::vector3df m_direction;
-        float m_size;
+        std::vector<float> m_position[3];
+        std::vector<float> m_lifetime;
+        std::vector<float> m_direction[3];
+        std::vector<float> m_size;
+        // --------------------------------------------------------------------
+        void resize(unsigned n)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                m_position[j].assign(n, 0.0f);
+                m_direction[j].assign(n, 0.0f);
+            }
+            m_lifetime.assign(n, 0.0f);
+            m_size.assign(n, 0.0f);
+        }
+        // --------------------------------------------------------------------
+        core::vector3df getPosition(unsigned i) const
+        {
+            return core::vector3df(m_position[0][i], m_position[1][i],
+                                   m_position[2][i]);
+        }
+        // --------------------------------------------------------------------
+        void setPosition(unsigned i, const core::vector3df& position)
+        {
+            m_position[0][i] = position.X;
+            m_position[1][i] = position.Y;
+            m_position[2][i] = position.Z;
+        }
+        // --------------------------------------------------------------------
+        core::vector3df getDirection(unsigned i) const
+        {
+            return core::vector3df(m_direction[0][i], m_direction[1][i],
+                                   m_direction[2][i]);
+        }
+        // --------------------------------------------------------------------
+        void setDirection(unsigned i, const core::vector3df& direction)
+        {
+            m_direction[0][i] = direction.X;
+            m_direction[1][i] = direction.Y;
+            m_direction[2][i] = direction.Z;
+        }
     };
     // ------------------------------------------------------------------------
     float m_y_min;
 
-    std::vector<ParticleData> m_particles_generating, m_initial_particles;
+    ParticleData m_particles_generating, m_initial_particles;
+
+    /** Indices of the particles to respawn in the current update, only
+     *  kept as member to avoid reallocations. */
+    std::vector<unsigned> m_respawn;
 
     core::vector3df m_color_from, m_color_to;
 
@@ -57,6 +101,10 @@ private:
     /** Maximum count of particles. */
     unsigned m_max_count;
 
+    /** Frame (counted by CPUParticleManager::newFrame()) in which the
+     *  particles were last simulated. */
+    unsigned m_simulated_frame;
+
     static std::vector<float> m_flips_data;
 
     static GLuint m_flips_buffer;
@@ -68,9 +116,13 @@ private:
     // ------------------------------------------------------------------------
     void generateParticlesFromSphereEmitter(scene::IParticleSphereEmitter*);
     // ------------------------------------------------------------------------
-    void stimulateHeightMap(float, unsigned int, std::vector<CPUParticle>*);
+    void stimulateHeightMap(float);
     // ------------------------------------------------------------------------
-    void stimulateNormal(float, unsigned int, std::vector<CPUParticle>*);
+    void stimulateNormal(float, unsigned int);
+    // ------------------------------------------------------------------------
+    void respawnNormal(unsigned, float, float);
+    // ------------------------------------------------------------------------
+    void addParticles(std::vector<CPUParticle>*);
 
 public:
     // ------------------------------------------------------------------------
@@ -109,7 +161,18 @@ public:
         m_y_min = y_min;
     }
     // ------------------------------------------------------------------------
-    void generate(std::vector<CPUParticle>* out, float dt=0.1);
+    void generate(std::vector<CPUParticle>* out, float dt=0.1,
+                  bool simulate=true);
+    // ------------------------------------------------------------------------
+    /** Returns true if the particles were not simulated in the given frame
+     *  yet, and marks them as simulated. */
+    bool simulateInFrame(unsigned frame)
+    {
+        if (m_simulated_frame == frame)
+            return false;
+        m_simulated_frame = frame;
+        return true;
+    }   // simulateInFrame
     // ------------------------------------------------------------------------
     void setFlips()                                         { m_flips = true; }
     // ------------------------------------------------------------------------
@@ -38,6 +38,7 @@
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
 #include "utils/objecttype.h"
+#include "utils/state_buffer.hpp"
 
 #include "irrMath.h"
 #include <IAnimatedMeshSceneNode.h>
@@ -158,6 +159,45 @@ void Attachment::clear()
     m_initial_speed = 0;
 }   // clear
 
+// -----------------------------------------------------------------------------
+/** Saves the attachment type, remaining time and previous owner. The state
+ *  of attachment plugins (e.g. the swatter animation) is not saved.
+ */
+void Attachment::saveState(StateBuffer *buffer) const
+{
+    buffer->add<AttachmentType>(m_type);
+    buffer->add<int16_t>(m_ticks_left);
+    buffer->add<int16_t>(m_initial_speed);
+    buffer->add<int>(m_previous_owner ?
+                     (int)m_previous_owner->getWorldKartId() : -1);
+}   // saveState
+
+// -----------------------------------------------------------------------------
+/** Restores the state written by saveState(). A different attachment type
+ *  is set with set(), so the plugin is (re-)created.
+ */
+void Attachment::restoreState(StateBuffer *buffer)
+{
+    AttachmentType type = buffer->get<AttachmentType>();
+    int16_t ticks_left  = buffer->get<int16_t>();
+    int16_t initial_speed = buffer->get<int16_t>();
+    int previous_owner  = buffer->get<int>();
+    AbstractKart *owner = previous_owner == -1 ? NULL
+                        : World::getWorld()->getKart(previous_owner);
+    if (type == ATTACH_NOTHING)
+    {
+        if (m_type != ATTACH_NOTHING)
+            clear();
+    }
+    else if (type != m_type)
+    {
+        set(type, ticks_left, owner, /*set_by_rewind_parachute*/true);
+    }
+    m_ticks_left     = ticks_left;
+    m_initial_speed  = initial_speed;
+    m_previous_owner = owner;
+}   // restoreState
+
 // -----------------------------------------------------------------------------
 /** Selects the new attachment. In order to simplify synchronisation with the
  *  server, the new item is based on the current world time. 
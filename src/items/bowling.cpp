@@ -23,6 +23,7 @@
 #include "io/xml_node.hpp"
 #include "karts/abstract_kart.hpp"
 #include "modes/linear_world.hpp"
+#include "utils/state_buffer.hpp"
 
 #include "utils/log.hpp" //TODO: remove after debugging is done
 
@@ -192,7 +193,7 @@ void Bowling::onFireFlyable()
 
     const Vec3& normal = m_owner->getNormal();
     createPhysics(y_offset, btVector3(0.0f, 0.0f, m_speed*2),
-                  new btSphereShape(0.5f*m_extend.getY()),
+                  createShape(),
                   0.4f /*restitution*/,
                   -70.0f*normal /*gravity*/,
                   true /*rotates*/);
@@ -212,3 +213,23 @@ void Bowling::onFireFlyable()
     // should not live forever, auto-destruct after 20 seconds
     m_max_lifespan = stk_config->time2Ticks(20);
 }   // onFireFlyable
+
+// ----------------------------------------------------------------------------
+btCollisionShape *Bowling::createShape() const
+{
+    return new btSphereShape(0.5f*m_extend.getY());
+}   // createShape
+
+// ----------------------------------------------------------------------------
+void Bowling::saveState(StateBuffer *buffer) const
+{
+    Flyable::saveState(buffer);
+    buffer->add<bool>(m_has_hit_kart);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void Bowling::restoreState(StateBuffer *buffer)
+{
+    Flyable::restoreState(buffer);
+    m_has_hit_kart = buffer->get<bool>();
+}   // restoreState
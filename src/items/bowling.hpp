@@ -45,6 +45,8 @@ private:
      *  kart was hit. */
     bool m_has_hit_kart;
 
+    virtual btCollisionShape *createShape() const OVERRIDE;
+
 public:
              Bowling(AbstractKart* kart);
     virtual ~Bowling();
@@ -54,6 +56,10 @@ public:
     virtual HitEffect *getHitEffect() const OVERRIDE;
     // ------------------------------------------------------------------------
     virtual void onFireFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
 
 };   // Bowling
 
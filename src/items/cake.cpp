@@ -23,7 +23,9 @@
 
 #include "io/xml_node.hpp"
 #include "karts/abstract_kart.hpp"
+#include "modes/world.hpp"
 #include "utils/constants.hpp"
+#include "utils/state_buffer.hpp"
 
 #include "utils/log.hpp" //TODO: remove after debugging is done
 
@@ -141,8 +143,7 @@ void Cake::onFireFlyable()
         trans.setRotation(q);
         m_initial_velocity = Vec3(0.0f, up_velocity, m_speed);
 
-        createPhysics(forward_offset, m_initial_velocity,
-                      new btCylinderShape(0.5f*m_extend),
+        createPhysics(forward_offset, m_initial_velocity, createShape(),
                       0.5f /* restitution */, gravity_vector,
                       true /* rotation */, false /* backwards */, &trans);
     }
@@ -155,8 +156,7 @@ void Cake::onFireFlyable()
 
         m_initial_velocity = Vec3(0.0f, up_velocity, m_speed);
 
-        createPhysics(forward_offset, m_initial_velocity,
-                      new btCylinderShape(0.5f*m_extend),
+        createPhysics(forward_offset, m_initial_velocity, createShape(),
                       0.5f /* restitution */, gravity_vector,
                       true /* rotation */, backwards, &trans);
     }
@@ -167,3 +167,26 @@ void Cake::onFireFlyable()
     m_body->clearForces();
     m_body->applyTorque(btVector3(5.0f, -3.0f, 7.0f));
 }   // onFireFlyable
+
+// ----------------------------------------------------------------------------
+btCollisionShape *Cake::createShape() const
+{
+    return new btCylinderShape(0.5f*m_extend);
+}   // createShape
+
+// ----------------------------------------------------------------------------
+void Cake::saveState(StateBuffer *buffer) const
+{
+    Flyable::saveState(buffer);
+    buffer->addVec3(m_initial_velocity);
+    buffer->add<int>(m_target ? (int)m_target->getWorldKartId() : -1);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void Cake::restoreState(StateBuffer *buffer)
+{
+    Flyable::restoreState(buffer);
+    m_initial_velocity = buffer->getVec3();
+    int target = buffer->get<int>();
+    m_target = target >= 0 ? World::getWorld()->getKart(target) : NULL;
+}   // restoreState
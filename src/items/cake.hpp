@@ -45,7 +45,9 @@ private:
     btVector3    m_initial_velocity;
 
     /** Which kart is targeted by this projectile (NULL if none). */
-    Moveable*    m_target;
+    AbstractKart* m_target;
+
+    virtual btCollisionShape *createShape() const OVERRIDE;
 
 public:
                  Cake (AbstractKart *kart);
@@ -74,6 +76,10 @@ public:
                                                     { m_initial_velocity = v; }
     // ------------------------------------------------------------------------
     virtual void onFireFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
 };   // Cake
 
 #endif
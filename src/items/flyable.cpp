@@ -46,6 +46,7 @@
 #include "utils/vs.hpp"
 #include "utils/objecttype.h"
 #include "utils/mini_glm.hpp"
+#include "utils/state_buffer.hpp"
 
 #include <typeinfo>
 
@@ -244,6 +245,65 @@ void Flyable::removePhysics()
     }
 }   // removePhysics
 
+//-----------------------------------------------------------------------------
+/** Saves the state of this flyable: the configuration and state of its
+ *  physical body and the values set when it was fired. Subclasses append
+ *  their type specific state (e.g. the target of a rubber ball). A flyable
+ *  inside a cannon is saved without its cannon animation.
+ */
+void Flyable::saveState(StateBuffer *buffer) const
+{
+    buffer->add<float>(m_body->getRestitution());
+    buffer->add<int>(m_body->getCollisionFlags());
+    buffer->addVec3(m_body->getAngularFactor());
+    saveBodyState(buffer);
+    buffer->add<int>(m_created_ticks);
+    buffer->add<uint16_t>(m_ticks_since_thrown);
+    buffer->add<bool>(m_has_hit_something);
+    buffer->add<bool>(m_owner_has_temporary_immunity);
+    buffer->add<bool>(m_adjust_up_velocity);
+    buffer->add<bool>(m_do_terrain_info);
+    buffer->add<uint32_t>(m_compressed_gravity_vector);
+    buffer->add<float>(m_speed);
+    buffer->add<int>(m_max_lifespan);
+    buffer->addVec3(m_position_offset);
+    buffer->add<uint32_t>(getObjectId());
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). This is used instead of
+ *  onFireFlyable(), i.e. the flyable is not fired again: the physical body
+ *  is created from the saved state without aiming or any other side effect
+ *  of firing.
+ */
+void Flyable::restoreState(StateBuffer *buffer)
+{
+    float restitution = buffer->get<float>();
+    if (!m_body)
+    {
+        btTransform trans = m_owner->getTrans();
+        m_shape = createShape();
+        createBody(m_mass, trans, m_shape, restitution);
+        m_user_pointer.set(this);
+        Physics::get()->addBody(getBody());
+    }
+    m_body->setRestitution(restitution);
+    m_body->setCollisionFlags(buffer->get<int>());
+    m_body->setAngularFactor(buffer->getVec3());
+    restoreBodyState(buffer);
+    m_created_ticks                = buffer->get<int>();
+    m_ticks_since_thrown           = buffer->get<uint16_t>();
+    m_has_hit_something            = buffer->get<bool>();
+    m_owner_has_temporary_immunity = buffer->get<bool>();
+    m_adjust_up_velocity           = buffer->get<bool>();
+    m_do_terrain_info              = buffer->get<bool>();
+    m_compressed_gravity_vector    = buffer->get<uint32_t>();
+    m_speed                        = buffer->get<float>();
+    m_max_lifespan                 = buffer->get<int>();
+    m_position_offset              = buffer->getVec3();
+    setObjectId(buffer->get<uint32_t>());
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Returns information on what is the closest kart and at what distance it is.
  *  All 3 parameters first are of type 'out'. 'inFrontOf' can be set if you
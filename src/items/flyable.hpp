@@ -38,6 +38,7 @@ using namespace irr;
 class AbstractKart;
 class AbstractKartAnimation;
 class HitEffect;
+class StateBuffer;
 class PhysicalObject;
 class XMLNode;
 class RenderInfo;
@@ -186,6 +187,9 @@ protected:
 
     void              moveToInfinity(bool set_moveable_trans = true);
     void              removePhysics();
+    // ------------------------------------------------------------------------
+    /** Returns a new collision shape for this type of flyable. */
+    virtual btCollisionShape *createShape() const = 0;
 public:
 
                  Flyable     (AbstractKart* kart,
@@ -232,6 +236,10 @@ public:
     /** Resets this flyable. */
     void         reset() OVERRIDE { Moveable::reset();          }
     // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(StateBuffer *buffer);
+    // ------------------------------------------------------------------------
     /** Returns the type of flyable. */
     PowerupManager::PowerupType getType() const {return m_type;}
 
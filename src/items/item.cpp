@@ -33,6 +33,7 @@
 #include "tracks/drive_graph.hpp"
 #include "tracks/drive_node.hpp"
 #include "utils/constants.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/objecttype.h"
 
@@ -113,6 +114,31 @@ void ItemState::update(int ticks)
 
 }   // update
 
+// ----------------------------------------------------------------------------
+/** Saves the changing state of this item. Position and owner are constant
+ *  and saved by the ItemManager, since they are needed to re-create dropped
+ *  items.
+ */
+void ItemState::saveState(StateBuffer *buffer) const
+{
+    buffer->add<ItemType>(m_type);
+    buffer->add<ItemType>(m_original_type);
+    buffer->add<int>(m_ticks_till_return);
+    buffer->add<int>(m_deactive_ticks);
+    buffer->add<int>(m_used_up_counter);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void ItemState::restoreState(StateBuffer *buffer)
+{
+    setType(buffer->get<ItemType>());
+    m_original_type     = buffer->get<ItemType>();
+    m_ticks_till_return = buffer->get<int>();
+    m_deactive_ticks    = buffer->get<int>();
+    m_used_up_counter   = buffer->get<int>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Called when the item is collected.
  *  \param kart The kart that collected the item.
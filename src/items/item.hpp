@@ -36,6 +36,7 @@
 class AbstractKart;
 class LODNode;
 class RenderInfo;
+class StateBuffer;
 
 namespace irr
 {
@@ -152,6 +153,8 @@ public:
     void update(int ticks);
     void setDisappearCounter();
     virtual void collected(const AbstractKart *kart);
+    void saveState(StateBuffer *buffer) const;
+    void restoreState(StateBuffer *buffer);
     // ------------------------------------------------------------------------
     virtual ~ItemState() {}
          
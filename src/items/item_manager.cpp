@@ -30,6 +30,7 @@
 #include "tracks/arena_graph.hpp"
 #include "tracks/arena_node.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <IMesh.h>
@@ -45,8 +46,8 @@ std::vector<scene::IMesh *>  ItemManager::m_item_mesh;
 std::vector<scene::IMesh *>  ItemManager::m_item_lowres_mesh;
 std::vector<video::SColorf>  ItemManager::m_glow_color;
 bool                         ItemManager::m_disable_item_collection = false;
-std::mt19937                 ItemManager::m_random_engine;
-uint32_t                     ItemManager::m_random_seed = 0;
+std::mt19937                 ItemManager::m_random_engine[STK_MAX_PROCESS_SLOTS];
+uint32_t                     ItemManager::m_random_seed[STK_MAX_PROCESS_SLOTS] = {};
 
 
 //-----------------------------------------------------------------------------
@@ -442,6 +443,93 @@ void ItemManager::reset()
     m_switch_ticks = -1;
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the state of all items and of the random generator used for bonus
+ *  boxes.
+ *  \param buffer The buffer to append the state to.
+ */
+void ItemManager::saveState(StateBuffer *buffer) const
+{
+    buffer->add<int>(m_switch_ticks);
+    std::stringstream random_engine;
+    random_engine << m_random_engine[STKProcess::getSlot()];
+    buffer->addString(random_engine.str());
+
+    buffer->add<uint32_t>((uint32_t)m_all_items.size());
+    for (const ItemState *item : m_all_items)
+    {
+        buffer->add<bool>(item != NULL);
+        if (!item)
+            continue;
+        buffer->add<ItemState::ItemType>(item->getType());
+        buffer->addVec3(item->getXYZ());
+        buffer->addQuaternion(item->getOriginalRotation());
+        const AbstractKart *owner = item->getPreviousOwner();
+        buffer->add<int>(owner ? (int)owner->getWorldKartId() : -1);
+        item->saveState(buffer);
+    }
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). Items dropped since the state
+ *  was saved are removed, and dropped items that were used up since then are
+ *  created again at their original index.
+ *  \param buffer The buffer to read the state from.
+ */
+void ItemManager::restoreState(StateBuffer *buffer)
+{
+    m_switch_ticks = buffer->get<int>();
+    std::stringstream random_engine(buffer->getString());
+    random_engine >> m_random_engine[STKProcess::getSlot()];
+
+    unsigned int num_items = buffer->get<uint32_t>();
+    for (unsigned int i = num_items; i < m_all_items.size(); i++)
+    {
+        if (m_all_items[i])
+            deleteItem(m_all_items[i]);
+    }
+    m_all_items.resize(num_items, NULL);
+
+    for (unsigned int i = 0; i < num_items; i++)
+    {
+        ItemState *item = m_all_items[i];
+        if (!buffer->get<bool>())
+        {
+            if (item)
+                deleteItem(item);
+            continue;
+        }
+        ItemState::ItemType type = buffer->get<ItemState::ItemType>();
+        Vec3 xyz                 = buffer->getVec3();
+        btQuaternion rotation    = buffer->getQuaternion();
+        int owner_id             = buffer->get<int>();
+        const AbstractKart *owner = owner_id == -1 ? NULL
+                                  : World::getWorld()->getKart(owner_id);
+        if (item && (item->getXYZ() != xyz ||
+                     item->getPreviousOwner() != owner))
+        {
+            deleteItem(item);
+            item = NULL;
+        }
+        if (!item)
+        {
+            ItemState::ItemType mesh_type = type;
+            if (type == ItemState::ITEM_BUBBLEGUM && owner &&
+                owner->getIdent() == "nolok")
+                mesh_type = ItemState::ITEM_BUBBLEGUM_NOLOK;
+            Vec3 normal = quatRotate(rotation, Vec3(0.0f, 1.0f, 0.0f));
+            Item *new_item = new Item(type, xyz, normal,
+                                      m_item_mesh[mesh_type],
+                                      m_item_lowres_mesh[mesh_type], owner);
+            m_all_items[i] = new_item;
+            new_item->setItemId(i);
+            insertItemInQuad(new_item);
+            item = new_item;
+        }
+        item->restoreState(buffer);
+    }
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Updates all items, and handles switching items back if the switch time
  *  is over.
@@ -598,7 +686,7 @@ bool ItemManager::randomItemsForArena(const AlignedArray<btTransform>& pos)
                     "Use default item location.");
                 return false;
             }
-            uint32_t number = m_random_engine();
+            uint32_t number = m_random_engine[STKProcess::getSlot()]();
             Log::debug("[ItemManager]", "%u from random engine.", number);
             const int node = number % ALL_NODES;
 
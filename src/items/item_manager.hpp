@@ -24,6 +24,7 @@
 #include "items/item.hpp"
 #include "utils/aligned_array.hpp"
 #include "utils/no_copy.hpp"
+#include "utils/stk_process.hpp"
 #include "utils/vec3.hpp"
 
 #include <SColor.h>
@@ -38,6 +39,7 @@
 #include <vector>
 
 class Kart;
+class StateBuffer;
 class STKPeer;
 
 /**
@@ -53,9 +55,11 @@ private:
     /** Disable item collection (for debugging purposes). */
     static bool m_disable_item_collection;
 
-    static std::mt19937 m_random_engine;
+    /** Random engine and seed used to place random arena items, one for
+     *  each simulation slot. */
+    static std::mt19937 m_random_engine[STK_MAX_PROCESS_SLOTS];
 
-    static uint32_t m_random_seed;
+    static uint32_t m_random_seed[STK_MAX_PROCESS_SLOTS];
 protected:
     /** The instance of ItemManager while a race is on. */
     static std::shared_ptr<ItemManager> m_item_manager;
@@ -65,13 +69,13 @@ public:
     static void removeTextures();
     static void updateRandomSeed(uint32_t seed_number)
     {
-        m_random_engine.seed(seed_number);
-        m_random_seed = seed_number;
+        m_random_engine[STKProcess::getSlot()].seed(seed_number);
+        m_random_seed[STKProcess::getSlot()] = seed_number;
     }   // updateRandomSeed
     // ------------------------------------------------------------------------
     static uint32_t getRandomSeed()
     {
-        return m_random_seed;
+        return m_random_seed[STKProcess::getSlot()];
     }   // getRandomSeed
 
     // ------------------------------------------------------------------------
@@ -141,6 +145,8 @@ public:
     void           updateGraphics  (float dt);
     void           checkItemHit    (AbstractKart* kart);
     void           reset           ();
+    void           saveState       (StateBuffer *buffer) const;
+    void           restoreState    (StateBuffer *buffer);
     virtual void   collectedItem   (ItemState *item, AbstractKart *kart);
     virtual void   switchItems     ();
     bool           randomItemsForArena(const AlignedArray<btTransform>& pos);
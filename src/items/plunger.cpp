@@ -34,6 +34,7 @@
 #include "physics/physics.hpp"
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 // -----------------------------------------------------------------------------
@@ -95,15 +96,14 @@ void Plunger::onFireFlyable()
 
         m_initial_velocity = btVector3(0.0f, up_velocity, plunger_speed);
 
-        createPhysics(forward_offset, m_initial_velocity,
-                      new btCylinderShape(0.5f*m_extend),
+        createPhysics(forward_offset, m_initial_velocity, createShape(),
                       0.5f /* restitution */ , btVector3(.0f,gravity,.0f),
                       /* rotates */false , /*turn around*/false, &trans);
     }
     else
     {
         createPhysics(forward_offset, btVector3(pitch, 0.0f, plunger_speed),
-                      new btCylinderShape(0.5f*m_extend),
+                      createShape(),
                       0.5f /* restitution */, btVector3(.0f,gravity,.0f),
                       false /* rotates */, m_reverse_mode, &kart_transform);
     }
@@ -250,3 +250,43 @@ void Plunger::onDeleteFlyable()
     if (m_rubber_band)
         m_rubber_band->remove();
 }   // onDeleteFlyable
+
+// ----------------------------------------------------------------------------
+btCollisionShape *Plunger::createShape() const
+{
+    return new btCylinderShape(0.5f*m_extend);
+}   // createShape
+
+// ----------------------------------------------------------------------------
+/** Saves the plunger and, if it has one, the state of its rubber band. */
+void Plunger::saveState(StateBuffer *buffer) const
+{
+    Flyable::saveState(buffer);
+    buffer->add<int16_t>(m_keep_alive);
+    buffer->addVec3(m_initial_velocity);
+    buffer->add<bool>(m_reverse_mode);
+    buffer->add<bool>(m_moved_to_infinity);
+    buffer->add<bool>(m_rubber_band != NULL);
+    if (m_rubber_band)
+        m_rubber_band->saveState(buffer);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void Plunger::restoreState(StateBuffer *buffer)
+{
+    Flyable::restoreState(buffer);
+    m_keep_alive        = buffer->get<int16_t>();
+    m_initial_velocity  = buffer->getVec3();
+    m_reverse_mode      = buffer->get<bool>();
+    m_moved_to_infinity = buffer->get<bool>();
+    bool has_rubber_band = buffer->get<bool>();
+    if (has_rubber_band && !m_rubber_band)
+        m_rubber_band = new RubberBand(this, m_owner);
+    else if (!has_rubber_band && m_rubber_band)
+    {
+        delete m_rubber_band;
+        m_rubber_band = NULL;
+    }
+    if (m_rubber_band)
+        m_rubber_band->restoreState(buffer);
+}   // restoreState
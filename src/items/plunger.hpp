@@ -48,6 +48,8 @@ private:
 
     bool m_reverse_mode, m_moved_to_infinity;
 
+    virtual btCollisionShape *createShape() const OVERRIDE;
+
 public:
                  Plunger(AbstractKart *kart);
                 ~Plunger();
@@ -70,6 +72,10 @@ public:
     virtual void onFireFlyable() OVERRIDE;
     // ------------------------------------------------------------------------
     virtual void onDeleteFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
 
 };   // Plunger
 
@@ -30,6 +30,7 @@
 
 #include "physics/triangle_mesh.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/log.hpp" //TODO: remove after debugging is done
 
@@ -63,6 +64,23 @@ void Powerup::reset()
     set( (PowerupManager::PowerupType)type, number );
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the type and number of the collected powerup. */
+void Powerup::saveState(StateBuffer *buffer) const
+{
+    buffer->add<PowerupManager::PowerupType>(m_type);
+    buffer->add<int>(m_number);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). Unlike set() this does not
+ *  play any sound. */
+void Powerup::restoreState(StateBuffer *buffer)
+{
+    m_type   = buffer->get<PowerupManager::PowerupType>();
+    m_number = buffer->get<int>();
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 void Powerup::update(int ticks)
 {
@@ -28,6 +28,7 @@
 
 class AbstractKart;
 class ItemState;
+class StateBuffer;
 
 /**
   * \ingroup items
@@ -49,6 +50,8 @@ public:
                    ~Powerup      ();
     void            set          (PowerupManager::PowerupType _type, int n=1);
     void            reset        ();
+    void            saveState    (StateBuffer *buffer) const;
+    void            restoreState (StateBuffer *buffer);
     Material*       getIcon      () const;
     void            use          ();
     void            hitBonusBox (const ItemState &item);
@@ -45,7 +45,8 @@ PowerupManager* powerup_manager=0;
 /** The constructor initialises everything to zero. */
 PowerupManager::PowerupManager()
 {
-    m_random_seed.store(0);
+    for (unsigned int i = 0; i < STK_MAX_PROCESS_SLOTS; i++)
+        m_random_seed[i].store(0);
     for(int i=0; i<POWERUP_MAX; i++)
     {
         m_all_meshes[i] = NULL;
@@ -545,25 +546,27 @@ void PowerupManager::computeWeightsForRace(int num_karts)
 
     // Check if we have exactly one entry (e.g. either class with only one
     // set of data specified, or an exact match):
-    m_current_item_weights.reset();
+    WeightsData& current_item_weights =
+        m_current_item_weights[STKProcess::getSlot()];
+    current_item_weights.reset();
     if(prev_index == next_index)
     {
         // Just create a copy of this entry:
-        m_current_item_weights = *wd[prev_index];
+        current_item_weights = *wd[prev_index];
         // The number of karts might need to be increased to make
         // sure enough weight list for all ranks are created: e.g.
         // in soccer mode there is only one weight list (for 1 kart)
         // but we still need to make sure to create rank weight list
         // for all possible ranks
-        m_current_item_weights.setNumKarts(num_karts);
+        current_item_weights.setNumKarts(num_karts);
     }
     else
     {
         // We need to interpolate between prev_index and next_index
-        m_current_item_weights.interpolate(wd[prev_index], wd[next_index],
-                                           num_karts                      );
+        current_item_weights.interpolate(wd[prev_index], wd[next_index],
+                                         num_karts                      );
     }
-    m_current_item_weights.precomputeWeights();
+    current_item_weights.precomputeWeights();
 }   // computeWeightsForRace
 
 // ----------------------------------------------------------------------------
@@ -581,7 +584,8 @@ PowerupManager::PowerupType PowerupManager::getRandomPowerup(unsigned int pos,
                                                              unsigned int *n,
                                                              uint64_t random_number)
 {
-    int powerup = m_current_item_weights.getRandomItem(pos-1, random_number);
+    int powerup = m_current_item_weights[STKProcess::getSlot()]
+                      .getRandomItem(pos-1, random_number);
     if(powerup > POWERUP_LAST)
     {
         powerup -= (POWERUP_LAST-POWERUP_FIRST+1);
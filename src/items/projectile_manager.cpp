@@ -29,32 +29,33 @@
 #include "karts/abstract_kart.hpp"
 #include "karts/controller/controller.hpp"
 #include "modes/world.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <typeinfo>
 
 //=============================================================================================
-ProjectileManager* g_projectile_manager[PT_COUNT];
+ProjectileManager* g_projectile_manager[STK_MAX_PROCESS_SLOTS];
 //---------------------------------------------------------------------------------------------
 ProjectileManager* ProjectileManager::get()
 {
-    ProcessType type = STKProcess::getType();
-    return g_projectile_manager[type];
+    unsigned int slot = STKProcess::getSlot();
+    return g_projectile_manager[slot];
 }   // get
 
 //---------------------------------------------------------------------------------------------
 void ProjectileManager::create()
 {
-    ProcessType type = STKProcess::getType();
-    g_projectile_manager[type] = new ProjectileManager();
+    unsigned int slot = STKProcess::getSlot();
+    g_projectile_manager[slot] = new ProjectileManager();
 }   // create
 
 //---------------------------------------------------------------------------------------------
 void ProjectileManager::destroy()
 {
-    ProcessType type = STKProcess::getType();
-    delete g_projectile_manager[type];
-    g_projectile_manager[type] = NULL;
+    unsigned int slot = STKProcess::getSlot();
+    delete g_projectile_manager[slot];
+    g_projectile_manager[slot] = NULL;
 }   // destroy
 
 //---------------------------------------------------------------------------------------------
@@ -89,6 +90,41 @@ void ProjectileManager::cleanup()
     m_active_hit_effects.clear();
 }   // cleanup
 
+// -----------------------------------------------------------------------------
+/** Saves the type, owner and state of all active projectiles. Hit effects
+ *  are purely graphical and not saved.
+ */
+void ProjectileManager::saveState(StateBuffer *buffer) const
+{
+    buffer->add<uint32_t>((uint32_t)m_active_projectiles.size());
+    for (auto p : m_active_projectiles)
+    {
+        buffer->add<PowerupManager::PowerupType>(p->getType());
+        buffer->add<int>((int)p->getOwner()->getWorldKartId());
+        p->saveState(buffer);
+    }
+}   // saveState
+
+// -----------------------------------------------------------------------------
+/** Restores the state written by saveState(). All current projectiles are
+ *  removed, and the saved ones are created again from their saved state
+ *  without being fired (so e.g. a rubber ball keeps its target).
+ */
+void ProjectileManager::restoreState(StateBuffer *buffer)
+{
+    cleanup();
+    unsigned int n = buffer->get<uint32_t>();
+    for (unsigned int i = 0; i < n; i++)
+    {
+        PowerupManager::PowerupType type =
+            buffer->get<PowerupManager::PowerupType>();
+        AbstractKart *owner = World::getWorld()->getKart(buffer->get<int>());
+        std::shared_ptr<Flyable> f = createProjectile(owner, type);
+        f->restoreState(buffer);
+        m_active_projectiles.push_back(f);
+    }
+}   // restoreState
+
 // -----------------------------------------------------------------------------
 /** Called once per rendered frame. It is used to only update any graphical
  *  effects, and calls updateGraphics in any flyable objects.
@@ -141,13 +177,13 @@ void ProjectileManager::update(int ticks)
 }   // update
 
 // -----------------------------------------------------------------------------
-/** Creates a new projectile of the given type.
- *  \param kart The kart which shoots the projectile.
+/** Creates a projectile of the given type without firing it.
+ *  \param kart The kart which owns the projectile.
  *  \param type Type of projectile.
  */
 std::shared_ptr<Flyable>
-    ProjectileManager::newProjectile(AbstractKart *kart,
-                                     PowerupManager::PowerupType type)
+    ProjectileManager::createProjectile(AbstractKart *kart,
+                                        PowerupManager::PowerupType type)
 {
     std::shared_ptr<Flyable> f;
     switch(type)
@@ -167,6 +203,21 @@ std::shared_ptr<Flyable>
         default:
             return nullptr;
     }
+    return f;
+}   // createProjectile
+
+// -----------------------------------------------------------------------------
+/** Creates a new projectile of the given type.
+ *  \param kart The kart which shoots the projectile.
+ *  \param type Type of projectile.
+ */
+std::shared_ptr<Flyable>
+    ProjectileManager::newProjectile(AbstractKart *kart,
+                                     PowerupManager::PowerupType type)
+{
+    std::shared_ptr<Flyable> f = createProjectile(kart, type);
+    if (!f)
+        return nullptr;
     // This cannot be done in constructor because of virtual function
     f->onFireFlyable();
     m_active_projectiles.push_back(f);
@@ -36,6 +36,7 @@ namespace irr
 class AbstractKart;
 class Flyable;
 class HitEffect;
+class StateBuffer;
 class Track;
 class Vec3;
 
@@ -54,6 +55,9 @@ private:
     /** All active hit effects, i.e. hit effects which are currently
      *  being shown or have a sfx playing. */
     HitEffects       m_active_hit_effects;
+
+    std::shared_ptr<Flyable> createProjectile(AbstractKart *kart,
+                                              PowerupManager::PowerupType type);
 public:
     // ----------------------------------------------------------------------------------------
     static ProjectileManager* get();
@@ -71,6 +75,8 @@ public:
     void             update           (int ticks);
     void             updateGraphics   (float dt);
     void             removeTextures   ();
+    void             saveState        (StateBuffer *buffer) const;
+    void             restoreState     (StateBuffer *buffer);
     bool             projectileIsClose(const AbstractKart * const kart,
                                        float radius);
 
@@ -32,6 +32,7 @@
 #include "tracks/drive_graph.hpp"
 #include "tracks/drive_node.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/stk_process.hpp"
 
 #include "utils/log.hpp" //TODO: remove after debugging is done
@@ -61,10 +62,17 @@ RubberBall::RubberBall(AbstractKart *kart)
     // For debugging purpose: pre-fix each debugging line with the id of
     // the ball so that it's easy to collect all debug output for one
     // particular ball only.
-    static int next_id[PT_COUNT] = {};
-    m_id = next_id[STKProcess::getType()]++;
-
-    m_target = NULL;
+    static int next_id[STK_MAX_PROCESS_SLOTS] = {};
+    m_id = next_id[STKProcess::getSlot()]++;
+
+    m_target                = NULL;
+    m_last_aimed_graph_node = 0;
+    m_length_cp_1_2         = 0.0f;
+    m_length_cp_2_3         = 0.0f;
+    m_t                     = 0.0f;
+    m_t_increase            = 0.0f;
+    m_distance_to_target    = 0.0f;
+    m_restoring_state       = false;
 }   // RubberBall
 
 // ----------------------------------------------------------------------------
@@ -79,7 +87,7 @@ void RubberBall::onFireFlyable()
         0.5f * m_owner->getKartLength() + m_extend.getZ() * 0.5f + 5.0f;
 
     createPhysics(forw_offset, btVector3(0.0f, 0.0f, m_speed*2),
-                  new btSphereShape(0.5f*m_extend.getY()), -70.0f,
+                  createShape(), -70.0f,
                   btVector3(.0f,.0f,.0f) /*gravity*/,
                   true /*rotates*/);
 
@@ -116,6 +124,72 @@ void RubberBall::onFireFlyable()
     initializeControlPoints(m_owner->getXYZ());
 }   // onFireFlyable
 
+// ----------------------------------------------------------------------------
+btCollisionShape *RubberBall::createShape() const
+{
+    return new btSphereShape(0.5f*m_extend.getY());
+}   // createShape
+
+// ----------------------------------------------------------------------------
+/** Saves the ball, its track sector, its target and the spline it follows.
+ */
+void RubberBall::saveState(StateBuffer *buffer) const
+{
+    Flyable::saveState(buffer);
+    TrackSector::saveState(buffer);
+    buffer->add<int>(m_target ? (int)m_target->getWorldKartId() : -1);
+    buffer->add<int>(m_last_aimed_graph_node);
+    for (unsigned int i = 0; i < 4; i++)
+        buffer->addVec3(m_control_points[i]);
+    buffer->addVec3(m_previous_xyz);
+    buffer->add<float>(m_previous_height);
+    buffer->add<float>(m_length_cp_1_2);
+    buffer->add<float>(m_length_cp_2_3);
+    buffer->add<float>(m_t);
+    buffer->add<float>(m_t_increase);
+    buffer->add<float>(m_interval);
+    buffer->add<float>(m_distance_to_target);
+    buffer->add<float>(m_height_timer);
+    buffer->add<float>(m_current_max_height);
+    buffer->add<int16_t>(m_delete_ticks);
+    buffer->add<uint8_t>(m_tunnel_count);
+    buffer->add<bool>(m_fast_ping);
+    buffer->add<bool>(m_aiming_at_target);
+    buffer->add<bool>(m_restoring_state);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). Unlike onFireFlyable() this
+ *  does not compute a new target, it only registers the ball with the
+ *  cannons again.
+ */
+void RubberBall::restoreState(StateBuffer *buffer)
+{
+    Flyable::restoreState(buffer);
+    Track::getCurrentTrack()->getCheckManager()->addFlyableToCannons(this);
+    TrackSector::restoreState(buffer);
+    int target = buffer->get<int>();
+    m_target = target >= 0 ? World::getWorld()->getKart(target) : NULL;
+    m_last_aimed_graph_node = buffer->get<int>();
+    for (unsigned int i = 0; i < 4; i++)
+        m_control_points[i] = buffer->getVec3();
+    m_previous_xyz       = buffer->getVec3();
+    m_previous_height    = buffer->get<float>();
+    m_length_cp_1_2      = buffer->get<float>();
+    m_length_cp_2_3      = buffer->get<float>();
+    m_t                  = buffer->get<float>();
+    m_t_increase         = buffer->get<float>();
+    m_interval           = buffer->get<float>();
+    m_distance_to_target = buffer->get<float>();
+    m_height_timer       = buffer->get<float>();
+    m_current_max_height = buffer->get<float>();
+    m_delete_ticks       = buffer->get<int16_t>();
+    m_tunnel_count       = buffer->get<uint8_t>();
+    m_fast_ping          = buffer->get<bool>();
+    m_aiming_at_target   = buffer->get<bool>();
+    m_restoring_state    = buffer->get<bool>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Destructor, removes any playing sfx.
  */
@@ -204,6 +204,7 @@ private:
     float        getTunnelHeight(const Vec3 &next_xyz, 
                                      const float vertical_offset) const;
     bool         checkTunneling();
+    virtual btCollisionShape *createShape() const OVERRIDE;
 
 public:
                  RubberBall  (AbstractKart* kart);
@@ -218,6 +219,10 @@ public:
     //virtual HitEffect *getHitEffect() const {return NULL; }
     // ------------------------------------------------------------------------
     virtual void onFireFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
 
 };   // RubberBall
 
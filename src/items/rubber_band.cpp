@@ -33,6 +33,7 @@
 #include "physics/physics.hpp"
 #include "race/race_manager.hpp"
 #include "utils/mini_glm.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 /** RubberBand constructor. It creates a simple quad and attaches it to the
@@ -319,3 +320,24 @@ void RubberBand::set8BitState(uint8_t bit_state)
         m_hit_kart = World::getWorld()->getKart(kart);
     }
 }   // set8BitState
+
+// ----------------------------------------------------------------------------
+/** Saves what the rubber band is attached to, and where. */
+void RubberBand::saveState(StateBuffer *buffer) const
+{
+    buffer->add<uint8_t>((uint8_t)m_attached_state);
+    buffer->add<int>(m_hit_kart ? (int)m_hit_kart->getWorldKartId() : -1);
+    buffer->addVec3(m_hit_position);
+    buffer->addVec3(m_end_position);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void RubberBand::restoreState(StateBuffer *buffer)
+{
+    m_attached_state = (RubberBandTo)buffer->get<uint8_t>();
+    int hit_kart     = buffer->get<int>();
+    m_hit_kart       = hit_kart >= 0 ? World::getWorld()->getKart(hit_kart)
+                                     : NULL;
+    m_hit_position   = buffer->getVec3();
+    m_end_position   = buffer->getVec3();
+}   // restoreState
@@ -32,6 +32,7 @@ namespace SP
 
 class AbstractKart;
 class Plunger;
+class StateBuffer;
 
 /** This class is used together with the pluger to display a rubber band from
  *  the shooting kart to the plunger.
@@ -77,6 +78,8 @@ public:
     void hit(AbstractKart *kart_hit, const Vec3 *track_xyz=NULL);
     uint8_t get8BitState() const;
     void set8BitState(uint8_t bit_state);
+    void saveState(StateBuffer *buffer) const;
+    void restoreState(StateBuffer *buffer);
     void remove();
 };   // RubberBand
 #endif
@@ -83,6 +83,13 @@ void AbstractKart::loadKartProperties(const std::string& new_ident,
 {
     m_kart_properties.reset(new KartProperties());
     const KartProperties* kp = kart_properties_manager->getKart(new_ident);
+    // Karts created after the start of a race (e.g. when changing the
+    // kart) might not have their models loaded yet
+    if (!kp->areModelsLoaded())
+    {
+        kart_properties_manager->loadKartModels(
+            std::vector<std::string>(1, new_ident));
+    }
     const KartProperties* kp_addon = NULL;
     m_kart_properties->copyForPlayer(kp, handicap);
     if (kp_addon)
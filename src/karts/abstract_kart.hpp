@@ -50,6 +50,7 @@ class RenderInfo;
 class Skidding;
 class SlipStream;
 class Stars;
+class StateBuffer;
 class TerrainInfo;
 
 
@@ -121,6 +122,12 @@ public:
     // ------------------------------------------------------------------------
     virtual void   reset();
     virtual void   init(RaceManager::KartType type) = 0;
+    // ------------------------------------------------------------------------
+    /** Saves the simulation state of this kart. */
+    virtual void   saveState(StateBuffer *buffer) const = 0;
+    // ------------------------------------------------------------------------
+    /** Restores the simulation state written by saveState(). */
+    virtual void   restoreState(StateBuffer *buffer) = 0;
     // ========================================================================
     // Functions related to controlling the kart
     // ------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 #include "physics/triangle_mesh.hpp"
 #include "tracks/track.hpp"
 #include "utils/mini_glm.hpp"
+#include "utils/state_buffer.hpp"
 
 #include <limits>
 
@@ -77,6 +78,28 @@ AbstractKartAnimation::AbstractKartAnimation(AbstractKart* kart,
         m_created_transform_compressed);
 }   // AbstractKartAnimation
 
+// ----------------------------------------------------------------------------
+/** Constructor used to restore an animation written by saveState(). It only
+ *  registers the animation with the kart, the kart restores its own body,
+ *  skidding and slipstream state, and if it is in the physics world.
+ *  \param kart Pointer to the kart that is animated.
+ *  \param name Name of the animation, used for debug prints only.
+ *  \param buffer The buffer to read the state from.
+ */
+AbstractKartAnimation::AbstractKartAnimation(AbstractKart* kart,
+                                             const std::string &name,
+                                             StateBuffer *buffer)
+{
+    m_kart = kart;
+    m_name = name;
+    m_created_ticks     = buffer->get<int>();
+    m_end_ticks         = buffer->get<int>();
+    m_created_transform = buffer->getTransform();
+    MiniGLM::compressbtTransform(m_created_transform,
+        m_created_transform_compressed);
+    kart->setKartAnimation(this);
+}   // AbstractKartAnimation
+
 // ----------------------------------------------------------------------------
 AbstractKartAnimation::~AbstractKartAnimation()
 {
@@ -154,6 +177,18 @@ float AbstractKartAnimation::getAnimationTimer() const
     return stk_config->ticks2Time(m_end_ticks - w->getTicksSinceStart());
 }   // getAnimationTimer
 
+// ----------------------------------------------------------------------------
+/** Saves the creation and end time and the transform at creation, read by
+ *  the state constructor of the animation.
+ *  \param buffer The buffer to write the state to.
+ */
+void AbstractKartAnimation::saveState(StateBuffer *buffer) const
+{
+    buffer->add<int>(m_created_ticks);
+    buffer->add<int>(m_end_ticks);
+    buffer->addTransform(m_created_transform);
+}   // saveState
+
 // ----------------------------------------------------------------------------
 /** Determine maximum rescue height with up-raycast
  */
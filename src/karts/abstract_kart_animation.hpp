@@ -30,6 +30,7 @@
 #include <string>
 
 class AbstractKart;
+class StateBuffer;
 
 enum KartAnimationType : uint8_t
 {
@@ -81,6 +82,10 @@ protected:
     void resetPowerUp();
     // ------------------------------------------------------------------------
     float getMaximumHeight(const Vec3& up_vector, float height_remove);
+    // ------------------------------------------------------------------------
+                 AbstractKartAnimation(AbstractKart* kart,
+                                       const std::string &name,
+                                       StateBuffer *buffer);
 
 public:
                  AbstractKartAnimation(AbstractKart* kart,
@@ -92,12 +97,24 @@ public:
     // ------------------------------------------------------------------------
     virtual float getAnimationTimer() const;
     // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const;
+    // ------------------------------------------------------------------------
     /** To easily allow printing the name of the animation being used atm.
      *  Used in AstractKart in case of an incorrect sequence of calls. */
     virtual const std::string &getName() const { return m_name; }
     // ------------------------------------------------------------------------
     virtual KartAnimationType getAnimationType() const = 0;
     // ------------------------------------------------------------------------
+    /** Returns the world ticks at which this animation was created. */
+    int getCreatedTicks() const                    { return m_created_ticks; }
+    // ------------------------------------------------------------------------
+    /** Returns the world ticks at which this animation ends. */
+    int getEndTicks() const                            { return m_end_ticks; }
+    // ------------------------------------------------------------------------
+    /** Returns the kart transform at the time the animation was created. */
+    const btTransform& getCreatedTransform() const
+                                               { return m_created_transform; }
+    // ------------------------------------------------------------------------
     /* Used to ignore adding karts back to physics when destroying world. */
     void handleResetRace()   { m_end_ticks = std::numeric_limits<int>::max(); }
 
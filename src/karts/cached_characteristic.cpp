@@ -18,44 +18,31 @@
 
 #include "karts/cached_characteristic.hpp"
 
-#include "utils/interpolation_array.hpp"
+#include "utils/log.hpp"
+
+#include <cmath>
 
 CachedCharacteristic::CachedCharacteristic(const AbstractCharacteristic *origin) :
-    m_values(CHARACTERISTIC_COUNT),
     m_origin(origin)
 {
     updateSource();
 }
 
 // ----------------------------------------------------------------------------
-/** Deletes all allocated values. */
-CachedCharacteristic::~CachedCharacteristic()
+/** Gets one value from the original source. All characteristics are set by
+ *  the base characteristic, so a missing value is an error.
+ *  \param type The characteristic to get.
+ *  \param value Where to store the value.
+ */
+template<typename T>
+void CachedCharacteristic::fetch(CharacteristicType type, T *value) const
 {
-    // Delete all not-null values
-    for (int i = 0; i < CHARACTERISTIC_COUNT; i++)
-    {
-        SaveValue &v = m_values[i];
-        if (v.content)
-        {
-            switch (getType(static_cast<CharacteristicType>(i)))
-            {
-            case TYPE_FLOAT:
-                delete static_cast<float*>(v.content);
-                break;
-            case TYPE_FLOAT_VECTOR:
-                delete static_cast<std::vector<float>*>(v.content);
-                break;
-            case TYPE_INTERPOLATION_ARRAY:
-                delete static_cast<InterpolationArray*>(v.content);
-                break;
-            case TYPE_BOOL:
-                delete static_cast<bool*>(v.content);
-                break;
-            }
-            v.content = nullptr;
-        }
-    }
-}   // ~CachedCharacteristic
+    bool is_set = false;
+    m_origin->process(type, value, &is_set);
+    if (!is_set)
+        Log::fatal("CachedCharacteristic", "Can't get characteristic %s",
+                   getName(type).c_str());
+}   // fetch
 
 // ----------------------------------------------------------------------------
 /** Recompute the values of all characteristics based on the list of
@@ -63,115 +50,127 @@ CachedCharacteristic::~CachedCharacteristic()
  */
 void CachedCharacteristic::updateSource()
 {
-    for (int i = 0; i < CHARACTERISTIC_COUNT; i++)
+    // Script-generated content generated by tools/create_kart_properties.py ccupdate
+    // Please don't change the following tag. It will be automatically detected
+    // by the script and replace the contained content.
+    // To update the code, use tools/update_characteristics.py
+    /* <characteristics-start ccupdate> */
+    fetch(SUSPENSION_STIFFNESS, &m_values.m_suspension_stiffness);
+    fetch(SUSPENSION_REST, &m_values.m_suspension_rest);
+    fetch(SUSPENSION_TRAVEL, &m_values.m_suspension_travel);
+    fetch(SUSPENSION_EXP_SPRING_RESPONSE, &m_values.m_suspension_exp_spring_response);
+    fetch(SUSPENSION_MAX_FORCE, &m_values.m_suspension_max_force);
+    fetch(STABILITY_ROLL_INFLUENCE, &m_values.m_stability_roll_influence);
+    fetch(STABILITY_CHASSIS_LINEAR_DAMPING, &m_values.m_stability_chassis_linear_damping);
+    fetch(STABILITY_CHASSIS_ANGULAR_DAMPING, &m_values.m_stability_chassis_angular_damping);
+    fetch(STABILITY_DOWNWARD_IMPULSE_FACTOR, &m_values.m_stability_downward_impulse_factor);
+    fetch(STABILITY_TRACK_CONNECTION_ACCEL, &m_values.m_stability_track_connection_accel);
+    fetch(STABILITY_ANGULAR_FACTOR, &m_values.m_stability_angular_factor);
+    fetch(STABILITY_SMOOTH_FLYING_IMPULSE, &m_values.m_stability_smooth_flying_impulse);
+    fetch(TURN_RADIUS, &m_values.m_turn_radius);
+    fetch(TURN_TIME_RESET_STEER, &m_values.m_turn_time_reset_steer);
+    fetch(TURN_TIME_FULL_STEER, &m_values.m_turn_time_full_steer);
+    fetch(ENGINE_POWER, &m_values.m_engine_power);
+    fetch(ENGINE_MAX_SPEED, &m_values.m_engine_max_speed);
+    fetch(ENGINE_GENERIC_MAX_SPEED, &m_values.m_engine_generic_max_speed);
+    fetch(ENGINE_BRAKE_FACTOR, &m_values.m_engine_brake_factor);
+    fetch(ENGINE_BRAKE_TIME_INCREASE, &m_values.m_engine_brake_time_increase);
+    fetch(ENGINE_MAX_SPEED_REVERSE_RATIO, &m_values.m_engine_max_speed_reverse_ratio);
+    fetch(GEAR_SWITCH_RATIO, &m_values.m_gear_switch_ratio);
+    fetch(GEAR_POWER_INCREASE, &m_values.m_gear_power_increase);
+    fetch(MASS, &m_values.m_mass);
+    fetch(WHEELS_DAMPING_RELAXATION, &m_values.m_wheels_damping_relaxation);
+    fetch(WHEELS_DAMPING_COMPRESSION, &m_values.m_wheels_damping_compression);
+    fetch(JUMP_ANIMATION_TIME, &m_values.m_jump_animation_time);
+    fetch(LEAN_MAX, &m_values.m_lean_max);
+    fetch(LEAN_SPEED, &m_values.m_lean_speed);
+    fetch(ANVIL_DURATION, &m_values.m_anvil_duration);
+    fetch(ANVIL_WEIGHT, &m_values.m_anvil_weight);
+    fetch(ANVIL_SPEED_FACTOR, &m_values.m_anvil_speed_factor);
+    fetch(PARACHUTE_FRICTION, &m_values.m_parachute_friction);
+    fetch(PARACHUTE_DURATION, &m_values.m_parachute_duration);
+    fetch(PARACHUTE_DURATION_OTHER, &m_values.m_parachute_duration_other);
+    fetch(PARACHUTE_DURATION_RANK_MULT, &m_values.m_parachute_duration_rank_mult);
+    fetch(PARACHUTE_DURATION_SPEED_MULT, &m_values.m_parachute_duration_speed_mult);
+    fetch(PARACHUTE_LBOUND_FRACTION, &m_values.m_parachute_lbound_fraction);
+    fetch(PARACHUTE_UBOUND_FRACTION, &m_values.m_parachute_ubound_fraction);
+    fetch(PARACHUTE_MAX_SPEED, &m_values.m_parachute_max_speed);
+    fetch(FRICTION_KART_FRICTION, &m_values.m_friction_kart_friction);
+    fetch(BUBBLEGUM_DURATION, &m_values.m_bubblegum_duration);
+    fetch(BUBBLEGUM_SPEED_FRACTION, &m_values.m_bubblegum_speed_fraction);
+    fetch(BUBBLEGUM_TORQUE, &m_values.m_bubblegum_torque);
+    fetch(BUBBLEGUM_FADE_IN_TIME, &m_values.m_bubblegum_fade_in_time);
+    fetch(BUBBLEGUM_SHIELD_DURATION, &m_values.m_bubblegum_shield_duration);
+    fetch(ZIPPER_DURATION, &m_values.m_zipper_duration);
+    fetch(ZIPPER_FORCE, &m_values.m_zipper_force);
+    fetch(ZIPPER_SPEED_GAIN, &m_values.m_zipper_speed_gain);
+    fetch(ZIPPER_MAX_SPEED_INCREASE, &m_values.m_zipper_max_speed_increase);
+    fetch(ZIPPER_FADE_OUT_TIME, &m_values.m_zipper_fade_out_time);
+    fetch(SWATTER_DURATION, &m_values.m_swatter_duration);
+    fetch(SWATTER_DISTANCE, &m_values.m_swatter_distance);
+    fetch(SWATTER_SQUASH_DURATION, &m_values.m_swatter_squash_duration);
+    fetch(SWATTER_SQUASH_SLOWDOWN, &m_values.m_swatter_squash_slowdown);
+    fetch(PLUNGER_BAND_MAX_LENGTH, &m_values.m_plunger_band_max_length);
+    fetch(PLUNGER_BAND_FORCE, &m_values.m_plunger_band_force);
+    fetch(PLUNGER_BAND_DURATION, &m_values.m_plunger_band_duration);
+    fetch(PLUNGER_BAND_SPEED_INCREASE, &m_values.m_plunger_band_speed_increase);
+    fetch(PLUNGER_BAND_FADE_OUT_TIME, &m_values.m_plunger_band_fade_out_time);
+    fetch(PLUNGER_IN_FACE_TIME, &m_values.m_plunger_in_face_time);
+    fetch(STARTUP_TIME, &m_values.m_startup_time);
+    fetch(STARTUP_BOOST, &m_values.m_startup_boost);
+    fetch(RESCUE_DURATION, &m_values.m_rescue_duration);
+    fetch(RESCUE_VERT_OFFSET, &m_values.m_rescue_vert_offset);
+    fetch(RESCUE_HEIGHT, &m_values.m_rescue_height);
+    fetch(EXPLOSION_DURATION, &m_values.m_explosion_duration);
+    fetch(EXPLOSION_RADIUS, &m_values.m_explosion_radius);
+    fetch(EXPLOSION_INVULNERABILITY_TIME, &m_values.m_explosion_invulnerability_time);
+    fetch(NITRO_DURATION, &m_values.m_nitro_duration);
+    fetch(NITRO_ENGINE_FORCE, &m_values.m_nitro_engine_force);
+    fetch(NITRO_ENGINE_MULT, &m_values.m_nitro_engine_mult);
+    fetch(NITRO_CONSUMPTION, &m_values.m_nitro_consumption);
+    fetch(NITRO_SMALL_CONTAINER, &m_values.m_nitro_small_container);
+    fetch(NITRO_BIG_CONTAINER, &m_values.m_nitro_big_container);
+    fetch(NITRO_MAX_SPEED_INCREASE, &m_values.m_nitro_max_speed_increase);
+    fetch(NITRO_FADE_OUT_TIME, &m_values.m_nitro_fade_out_time);
+    fetch(NITRO_MAX, &m_values.m_nitro_max);
+    fetch(SLIPSTREAM_DURATION_FACTOR, &m_values.m_slipstream_duration_factor);
+    fetch(SLIPSTREAM_BASE_SPEED, &m_values.m_slipstream_base_speed);
+    fetch(SLIPSTREAM_LENGTH, &m_values.m_slipstream_length);
+    fetch(SLIPSTREAM_WIDTH, &m_values.m_slipstream_width);
+    fetch(SLIPSTREAM_INNER_FACTOR, &m_values.m_slipstream_inner_factor);
+    fetch(SLIPSTREAM_MIN_COLLECT_TIME, &m_values.m_slipstream_min_collect_time);
+    fetch(SLIPSTREAM_MAX_COLLECT_TIME, &m_values.m_slipstream_max_collect_time);
+    fetch(SLIPSTREAM_ADD_POWER, &m_values.m_slipstream_add_power);
+    fetch(SLIPSTREAM_MIN_SPEED, &m_values.m_slipstream_min_speed);
+    fetch(SLIPSTREAM_MAX_SPEED_INCREASE, &m_values.m_slipstream_max_speed_increase);
+    fetch(SLIPSTREAM_FADE_OUT_TIME, &m_values.m_slipstream_fade_out_time);
+    fetch(SKID_INCREASE, &m_values.m_skid_increase);
+    fetch(SKID_DECREASE, &m_values.m_skid_decrease);
+    fetch(SKID_MAX, &m_values.m_skid_max);
+    fetch(SKID_TIME_TILL_MAX, &m_values.m_skid_time_till_max);
+    fetch(SKID_VISUAL, &m_values.m_skid_visual);
+    fetch(SKID_VISUAL_TIME, &m_values.m_skid_visual_time);
+    fetch(SKID_REVERT_VISUAL_TIME, &m_values.m_skid_revert_visual_time);
+    fetch(SKID_MIN_SPEED, &m_values.m_skid_min_speed);
+    fetch(SKID_TIME_TILL_BONUS, &m_values.m_skid_time_till_bonus);
+    fetch(SKID_BONUS_SPEED, &m_values.m_skid_bonus_speed);
+    fetch(SKID_BONUS_TIME, &m_values.m_skid_bonus_time);
+    fetch(SKID_BONUS_FORCE, &m_values.m_skid_bonus_force);
+    fetch(SKID_PHYSICAL_JUMP_TIME, &m_values.m_skid_physical_jump_time);
+    fetch(SKID_GRAPHICAL_JUMP_TIME, &m_values.m_skid_graphical_jump_time);
+    fetch(SKID_POST_SKID_ROTATE_FACTOR, &m_values.m_skid_post_skid_rotate_factor);
+    fetch(SKID_REDUCE_TURN_MIN, &m_values.m_skid_reduce_turn_min);
+    fetch(SKID_REDUCE_TURN_MAX, &m_values.m_skid_reduce_turn_max);
+    fetch(SKID_ENABLED, &m_values.m_skid_enabled);
+
+    /* <characteristics-end ccupdate> */
+
+    m_turn_angle_at_speed = m_values.m_turn_radius;
+    for (unsigned int i = 0; i < m_turn_angle_at_speed.size(); i++)
     {
-        SaveValue &v = m_values[i];
-        
-        bool is_set = false;
-        switch (getType(static_cast<CharacteristicType>(i)))
-        {
-        case TYPE_FLOAT:
-        {
-            float value;
-            float *ptr = static_cast<float*>(v.content);
-            m_origin->process(static_cast<CharacteristicType>(i), &value, &is_set);
-            if (is_set)
-            {
-                if (!ptr)
-                {
-                    float *newPtr = new float();
-                    v.content = newPtr;
-                    ptr = newPtr;
-                }
-                *ptr = value;
-            }
-            else
-            {
-                if (ptr)
-                {
-                    delete ptr;
-                    v.content = nullptr;
-                }
-            }
-            break;
-        }
-        case TYPE_FLOAT_VECTOR:
-        {
-            std::vector<float> value;
-            std::vector<float> *ptr = static_cast<std::vector<float>*>(v.content);
-            m_origin->process(static_cast<CharacteristicType>(i), &value, &is_set);
-            if (is_set)
-            {
-                if (!ptr)
-                {
-                    std::vector<float> *newPtr = new std::vector<float>();
-                    v.content = newPtr;
-                    ptr = newPtr;
-                }
-                *ptr = value;
-            }
-            else
-            {
-                if (ptr)
-                {
-                    delete ptr;
-                    v.content = nullptr;
-                }
-            }
-            break;
-        }
-        case TYPE_INTERPOLATION_ARRAY:
-        {
-            InterpolationArray value;
-            InterpolationArray *ptr = static_cast<InterpolationArray*>(v.content);
-            m_origin->process(static_cast<CharacteristicType>(i), &value, &is_set);
-            if (is_set)
-            {
-                if (!ptr)
-                {
-                    InterpolationArray *newPtr = new InterpolationArray();
-                    v.content = newPtr;
-                    ptr = newPtr;
-                }
-                *ptr = value;
-            }
-            else
-            {
-                if (ptr)
-                {
-                    delete ptr;
-                    v.content = nullptr;
-                }
-            }
-            break;
-        }
-        case TYPE_BOOL:
-        {
-            bool value;
-            bool *ptr = static_cast<bool*>(v.content);
-            m_origin->process(static_cast<CharacteristicType>(i), &value, &is_set);
-            if (is_set)
-            {
-                if (!ptr)
-                {
-                    bool *newPtr = new bool();
-                    v.content = newPtr;
-                    ptr = newPtr;
-                }
-                *ptr = value;
-            }
-            else
-            {
-                if (ptr)
-                {
-                    delete ptr;
-                    v.content = nullptr;
-                }
-            }
-            break;
-        }
-        }   // switch (type)
-    }   // foreach characteristic
+        m_turn_angle_at_speed.setY(i,
+            sinf(1.0f / m_turn_angle_at_speed.getY(i)));
+    }
 }   // updateSource
 
 // ----------------------------------------------------------------------------
@@ -179,25 +178,340 @@ void CachedCharacteristic::updateSource()
 void CachedCharacteristic::process(CharacteristicType type, Value value,
                                    bool *is_set) const
 {
-    void *v = m_values[type].content;
-    if (v)
+    switch (type)
     {
-        switch (getType(type))
-        {
-        case TYPE_FLOAT:
-            *value.f = *static_cast<float*>(v);
-            break;
-        case TYPE_FLOAT_VECTOR:
-            *value.fv = *static_cast<std::vector<float>*>(v);
-            break;
-        case TYPE_INTERPOLATION_ARRAY:
-            *value.ia = *static_cast<InterpolationArray*>(v);
-            break;
-        case TYPE_BOOL:
-            *value.b = *static_cast<bool*>(v);
-            break;
-        }
-        *is_set = true;
+    // Script-generated content generated by tools/create_kart_properties.py ccprocess
+    // Please don't change the following tag. It will be automatically detected
+    // by the script and replace the contained content.
+    // To update the code, use tools/update_characteristics.py
+    /* <characteristics-start ccprocess> */
+    case SUSPENSION_STIFFNESS:
+        *value.f = m_values.m_suspension_stiffness;
+        break;
+    case SUSPENSION_REST:
+        *value.f = m_values.m_suspension_rest;
+        break;
+    case SUSPENSION_TRAVEL:
+        *value.f = m_values.m_suspension_travel;
+        break;
+    case SUSPENSION_EXP_SPRING_RESPONSE:
+        *value.b = m_values.m_suspension_exp_spring_response;
+        break;
+    case SUSPENSION_MAX_FORCE:
+        *value.f = m_values.m_suspension_max_force;
+        break;
+    case STABILITY_ROLL_INFLUENCE:
+        *value.f = m_values.m_stability_roll_influence;
+        break;
+    case STABILITY_CHASSIS_LINEAR_DAMPING:
+        *value.f = m_values.m_stability_chassis_linear_damping;
+        break;
+    case STABILITY_CHASSIS_ANGULAR_DAMPING:
+        *value.f = m_values.m_stability_chassis_angular_damping;
+        break;
+    case STABILITY_DOWNWARD_IMPULSE_FACTOR:
+        *value.f = m_values.m_stability_downward_impulse_factor;
+        break;
+    case STABILITY_TRACK_CONNECTION_ACCEL:
+        *value.f = m_values.m_stability_track_connection_accel;
+        break;
+    case STABILITY_ANGULAR_FACTOR:
+        *value.fv = m_values.m_stability_angular_factor;
+        break;
+    case STABILITY_SMOOTH_FLYING_IMPULSE:
+        *value.f = m_values.m_stability_smooth_flying_impulse;
+        break;
+    case TURN_RADIUS:
+        *value.ia = m_values.m_turn_radius;
+        break;
+    case TURN_TIME_RESET_STEER:
+        *value.f = m_values.m_turn_time_reset_steer;
+        break;
+    case TURN_TIME_FULL_STEER:
+        *value.ia = m_values.m_turn_time_full_steer;
+        break;
+    case ENGINE_POWER:
+        *value.f = m_values.m_engine_power;
+        break;
+    case ENGINE_MAX_SPEED:
+        *value.f = m_values.m_engine_max_speed;
+        break;
+    case ENGINE_GENERIC_MAX_SPEED:
+        *value.f = m_values.m_engine_generic_max_speed;
+        break;
+    case ENGINE_BRAKE_FACTOR:
+        *value.f = m_values.m_engine_brake_factor;
+        break;
+    case ENGINE_BRAKE_TIME_INCREASE:
+        *value.f = m_values.m_engine_brake_time_increase;
+        break;
+    case ENGINE_MAX_SPEED_REVERSE_RATIO:
+        *value.f = m_values.m_engine_max_speed_reverse_ratio;
+        break;
+    case GEAR_SWITCH_RATIO:
+        *value.fv = m_values.m_gear_switch_ratio;
+        break;
+    case GEAR_POWER_INCREASE:
+        *value.fv = m_values.m_gear_power_increase;
+        break;
+    case MASS:
+        *value.f = m_values.m_mass;
+        break;
+    case WHEELS_DAMPING_RELAXATION:
+        *value.f = m_values.m_wheels_damping_relaxation;
+        break;
+    case WHEELS_DAMPING_COMPRESSION:
+        *value.f = m_values.m_wheels_damping_compression;
+        break;
+    case JUMP_ANIMATION_TIME:
+        *value.f = m_values.m_jump_animation_time;
+        break;
+    case LEAN_MAX:
+        *value.f = m_values.m_lean_max;
+        break;
+    case LEAN_SPEED:
+        *value.f = m_values.m_lean_speed;
+        break;
+    case ANVIL_DURATION:
+        *value.f = m_values.m_anvil_duration;
+        break;
+    case ANVIL_WEIGHT:
+        *value.f = m_values.m_anvil_weight;
+        break;
+    case ANVIL_SPEED_FACTOR:
+        *value.f = m_values.m_anvil_speed_factor;
+        break;
+    case PARACHUTE_FRICTION:
+        *value.f = m_values.m_parachute_friction;
+        break;
+    case PARACHUTE_DURATION:
+        *value.f = m_values.m_parachute_duration;
+        break;
+    case PARACHUTE_DURATION_OTHER:
+        *value.f = m_values.m_parachute_duration_other;
+        break;
+    case PARACHUTE_DURATION_RANK_MULT:
+        *value.f = m_values.m_parachute_duration_rank_mult;
+        break;
+    case PARACHUTE_DURATION_SPEED_MULT:
+        *value.f = m_values.m_parachute_duration_speed_mult;
+        break;
+    case PARACHUTE_LBOUND_FRACTION:
+        *value.f = m_values.m_parachute_lbound_fraction;
+        break;
+    case PARACHUTE_UBOUND_FRACTION:
+        *value.f = m_values.m_parachute_ubound_fraction;
+        break;
+    case PARACHUTE_MAX_SPEED:
+        *value.f = m_values.m_parachute_max_speed;
+        break;
+    case FRICTION_KART_FRICTION:
+        *value.f = m_values.m_friction_kart_friction;
+        break;
+    case BUBBLEGUM_DURATION:
+        *value.f = m_values.m_bubblegum_duration;
+        break;
+    case BUBBLEGUM_SPEED_FRACTION:
+        *value.f = m_values.m_bubblegum_speed_fraction;
+        break;
+    case BUBBLEGUM_TORQUE:
+        *value.f = m_values.m_bubblegum_torque;
+        break;
+    case BUBBLEGUM_FADE_IN_TIME:
+        *value.f = m_values.m_bubblegum_fade_in_time;
+        break;
+    case BUBBLEGUM_SHIELD_DURATION:
+        *value.f = m_values.m_bubblegum_shield_duration;
+        break;
+    case ZIPPER_DURATION:
+        *value.f = m_values.m_zipper_duration;
+        break;
+    case ZIPPER_FORCE:
+        *value.f = m_values.m_zipper_force;
+        break;
+    case ZIPPER_SPEED_GAIN:
+        *value.f = m_values.m_zipper_speed_gain;
+        break;
+    case ZIPPER_MAX_SPEED_INCREASE:
+        *value.f = m_values.m_zipper_max_speed_increase;
+        break;
+    case ZIPPER_FADE_OUT_TIME:
+        *value.f = m_values.m_zipper_fade_out_time;
+        break;
+    case SWATTER_DURATION:
+        *value.f = m_values.m_swatter_duration;
+        break;
+    case SWATTER_DISTANCE:
+        *value.f = m_values.m_swatter_distance;
+        break;
+    case SWATTER_SQUASH_DURATION:
+        *value.f = m_values.m_swatter_squash_duration;
+        break;
+    case SWATTER_SQUASH_SLOWDOWN:
+        *value.f = m_values.m_swatter_squash_slowdown;
+        break;
+    case PLUNGER_BAND_MAX_LENGTH:
+        *value.f = m_values.m_plunger_band_max_length;
+        break;
+    case PLUNGER_BAND_FORCE:
+        *value.f = m_values.m_plunger_band_force;
+        break;
+    case PLUNGER_BAND_DURATION:
+        *value.f = m_values.m_plunger_band_duration;
+        break;
+    case PLUNGER_BAND_SPEED_INCREASE:
+        *value.f = m_values.m_plunger_band_speed_increase;
+        break;
+    case PLUNGER_BAND_FADE_OUT_TIME:
+        *value.f = m_values.m_plunger_band_fade_out_time;
+        break;
+    case PLUNGER_IN_FACE_TIME:
+        *value.f = m_values.m_plunger_in_face_time;
+        break;
+    case STARTUP_TIME:
+        *value.fv = m_values.m_startup_time;
+        break;
+    case STARTUP_BOOST:
+        *value.fv = m_values.m_startup_boost;
+        break;
+    case RESCUE_DURATION:
+        *value.f = m_values.m_rescue_duration;
+        break;
+    case RESCUE_VERT_OFFSET:
+        *value.f = m_values.m_rescue_vert_offset;
+        break;
+    case RESCUE_HEIGHT:
+        *value.f = m_values.m_rescue_height;
+        break;
+    case EXPLOSION_DURATION:
+        *value.f = m_values.m_explosion_duration;
+        break;
+    case EXPLOSION_RADIUS:
+        *value.f = m_values.m_explosion_radius;
+        break;
+    case EXPLOSION_INVULNERABILITY_TIME:
+        *value.f = m_values.m_explosion_invulnerability_time;
+        break;
+    case NITRO_DURATION:
+        *value.f = m_values.m_nitro_duration;
+        break;
+    case NITRO_ENGINE_FORCE:
+        *value.f = m_values.m_nitro_engine_force;
+        break;
+    case NITRO_ENGINE_MULT:
+        *value.f = m_values.m_nitro_engine_mult;
+        break;
+    case NITRO_CONSUMPTION:
+        *value.f = m_values.m_nitro_consumption;
+        break;
+    case NITRO_SMALL_CONTAINER:
+        *value.f = m_values.m_nitro_small_container;
+        break;
+    case NITRO_BIG_CONTAINER:
+        *value.f = m_values.m_nitro_big_container;
+        break;
+    case NITRO_MAX_SPEED_INCREASE:
+        *value.f = m_values.m_nitro_max_speed_increase;
+        break;
+    case NITRO_FADE_OUT_TIME:
+        *value.f = m_values.m_nitro_fade_out_time;
+        break;
+    case NITRO_MAX:
+        *value.f = m_values.m_nitro_max;
+        break;
+    case SLIPSTREAM_DURATION_FACTOR:
+        *value.f = m_values.m_slipstream_duration_factor;
+        break;
+    case SLIPSTREAM_BASE_SPEED:
+        *value.f = m_values.m_slipstream_base_speed;
+        break;
+    case SLIPSTREAM_LENGTH:
+        *value.f = m_values.m_slipstream_length;
+        break;
+    case SLIPSTREAM_WIDTH:
+        *value.f = m_values.m_slipstream_width;
+        break;
+    case SLIPSTREAM_INNER_FACTOR:
+        *value.f = m_values.m_slipstream_inner_factor;
+        break;
+    case SLIPSTREAM_MIN_COLLECT_TIME:
+        *value.f = m_values.m_slipstream_min_collect_time;
+        break;
+    case SLIPSTREAM_MAX_COLLECT_TIME:
+        *value.f = m_values.m_slipstream_max_collect_time;
+        break;
+    case SLIPSTREAM_ADD_POWER:
+        *value.f = m_values.m_slipstream_add_power;
+        break;
+    case SLIPSTREAM_MIN_SPEED:
+        *value.f = m_values.m_slipstream_min_speed;
+        break;
+    case SLIPSTREAM_MAX_SPEED_INCREASE:
+        *value.f = m_values.m_slipstream_max_speed_increase;
+        break;
+    case SLIPSTREAM_FADE_OUT_TIME:
+        *value.f = m_values.m_slipstream_fade_out_time;
+        break;
+    case SKID_INCREASE:
+        *value.f = m_values.m_skid_increase;
+        break;
+    case SKID_DECREASE:
+        *value.f = m_values.m_skid_decrease;
+        break;
+    case SKID_MAX:
+        *value.f = m_values.m_skid_max;
+        break;
+    case SKID_TIME_TILL_MAX:
+        *value.f = m_values.m_skid_time_till_max;
+        break;
+    case SKID_VISUAL:
+        *value.f = m_values.m_skid_visual;
+        break;
+    case SKID_VISUAL_TIME:
+        *value.f = m_values.m_skid_visual_time;
+        break;
+    case SKID_REVERT_VISUAL_TIME:
+        *value.f = m_values.m_skid_revert_visual_time;
+        break;
+    case SKID_MIN_SPEED:
+        *value.f = m_values.m_skid_min_speed;
+        break;
+    case SKID_TIME_TILL_BONUS:
+        *value.fv = m_values.m_skid_time_till_bonus;
+        break;
+    case SKID_BONUS_SPEED:
+        *value.fv = m_values.m_skid_bonus_speed;
+        break;
+    case SKID_BONUS_TIME:
+        *value.fv = m_values.m_skid_bonus_time;
+        break;
+    case SKID_BONUS_FORCE:
+        *value.fv = m_values.m_skid_bonus_force;
+        break;
+    case SKID_PHYSICAL_JUMP_TIME:
+        *value.f = m_values.m_skid_physical_jump_time;
+        break;
+    case SKID_GRAPHICAL_JUMP_TIME:
+        *value.f = m_values.m_skid_graphical_jump_time;
+        break;
+    case SKID_POST_SKID_ROTATE_FACTOR:
+        *value.f = m_values.m_skid_post_skid_rotate_factor;
+        break;
+    case SKID_REDUCE_TURN_MIN:
+        *value.f = m_values.m_skid_reduce_turn_min;
+        break;
+    case SKID_REDUCE_TURN_MAX:
+        *value.f = m_values.m_skid_reduce_turn_max;
+        break;
+    case SKID_ENABLED:
+        *value.b = m_values.m_skid_enabled;
+        break;
+
+    /* <characteristics-end ccprocess> */
+    case CHARACTERISTIC_COUNT:
+        Log::fatal("CachedCharacteristic::process", "Can't get value of "
+                   "characteristic count");
+        break;
     }
+    *is_set = true;
 }   // process
-
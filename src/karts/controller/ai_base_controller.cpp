@@ -39,6 +39,7 @@ AIBaseController::AIBaseController(AbstractKart *kart)
     m_kart_width    = m_kart->getKartWidth();
     m_ai_properties = m_kart->getKartProperties()
                             ->getAIPropertiesForDifficulty();
+    m_decided       = false;
 }   // AIBaseController
 
 //-----------------------------------------------------------------------------
@@ -46,6 +47,7 @@ AIBaseController::AIBaseController(AbstractKart *kart)
 void AIBaseController::reset()
 {
     m_stuck = false;
+    m_decided = false;
     m_collision_ticks.clear();
 }   // reset
 
@@ -59,6 +59,9 @@ protected:
     /** A pointer to the AI properties for this kart. */
     const AIProperties *m_ai_properties;
 
+    /** True if decide() prepared the next update(). */
+    bool m_decided;
+
     void         setControllerName(const std::string &name) OVERRIDE;
     float        steerToPoint(const Vec3 &point);
     float        normalizeAngle(float angle);
@@ -79,6 +79,10 @@ void ArenaAI::reset()
  */
 void ArenaAI::update(int ticks)
 {
+    // Use the target found by decide() if it was called for this update
+    const bool decided = m_decided;
+    m_decided = false;
+
     if (!m_graph)
         return;
 
@@ -127,7 +131,8 @@ void ArenaAI::update(int ticks)
     if (gettingUnstuck(ticks))
         return;
 
-    findTarget();
+    if (!decided)
+        findTarget();
 
     // After found target, convert it to local coordinate, used for skidding or
     // u-turn
@@ -165,6 +170,23 @@ void ArenaAI::update(int ticks)
 
 }   // update
 
+//-----------------------------------------------------------------------------
+/** Finds the target of this AI, which searches through all karts and items.
+ *  This is called for all karts in parallel before they are updated (see
+ *  Controller::decide), so it must not modify anything but this AI.
+ *  \param ticks Number of physics time steps.
+ */
+void ArenaAI::decide(int ticks)
+{
+    // update() does not look for a target in these cases
+    if (!m_graph || m_kart->getKartAnimation() || isWaiting() ||
+        (m_is_stuck && !m_is_uturn))
+        return;
+
+    findTarget();
+    m_decided = true;
+}   // decide
+
 //-----------------------------------------------------------------------------
 /** Update aiming position, use path finding if necessary.
  *  \param[out] target_point Suitable target point.
@@ -189,6 +189,8 @@ public:
     // ------------------------------------------------------------------------
     virtual void update(int ticks) OVERRIDE;
     // ------------------------------------------------------------------------
+    virtual void decide(int ticks) OVERRIDE;
+    // ------------------------------------------------------------------------
     virtual void reset() OVERRIDE;
     // ------------------------------------------------------------------------
     virtual void newLap(int lap) OVERRIDE {}
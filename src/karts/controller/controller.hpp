@@ -57,6 +57,11 @@ public:
     virtual      ~Controller         () {};
     virtual void  reset              () = 0;
     virtual void  update             (int ticks) = 0;
+    /** Prepares the next update() from the current state of the world,
+     *  e.g. the expensive path and crash tests of an AI. World::update()
+     *  calls this for all karts in parallel before any kart is updated, so
+     *  it must only read the world and only modify this controller. */
+    virtual void  decide             (int ticks) {}
     virtual void  handleZipper       () = 0;
     virtual void  collectedItem      (const ItemState &item,
                                       float previous_energy=0) = 0;
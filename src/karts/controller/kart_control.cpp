@@ -18,6 +18,7 @@
 
 #include "karts/controller/kart_control.hpp"
 
+#include "utils/state_buffer.hpp"
 
 #include "irrMath.h"
 #include <algorithm>
@@ -79,3 +80,21 @@ void KartControl::setLookBack(bool b)
 {
     m_look_back   = b;
 }   // setLookBack
+
+// ----------------------------------------------------------------------------
+/** Copies all controls into the state buffer. */
+void KartControl::saveState(StateBuffer *buffer) const
+{
+    buffer->add<int16_t>(m_steer);
+    buffer->add<uint16_t>(m_accel);
+    buffer->add<char>(getButtonsCompressed());
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores all controls from a state buffer. */
+void KartControl::restoreState(StateBuffer *buffer)
+{
+    m_steer = buffer->get<int16_t>();
+    m_accel = buffer->get<uint16_t>();
+    setButtonsCompressed(buffer->get<char>());
+}   // restoreState
@@ -21,6 +21,8 @@
 
 #include "utils/types.hpp"
 
+class StateBuffer;
+
 /**
   * \ingroup controller
   */
@@ -58,6 +60,8 @@ public:
     void setRescue(bool b);
     void setFire(bool b);
     void setLookBack(bool b);
+    void saveState(StateBuffer *buffer) const;
+    void restoreState(StateBuffer *buffer);
 
     // ------------------------------------------------------------------------
     KartControl()
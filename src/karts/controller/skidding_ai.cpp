@@ -168,6 +168,8 @@ void SkiddingAI::reset()
     m_current_track_direction    = DriveNode::DIR_STRAIGHT;
     m_item_to_collect            = NULL;
     m_last_direction_node        = 0;
+    m_aim_point                  = Vec3(0,0,0);
+    m_aim_last_node              = Graph::UNKNOWN_SECTOR;
     m_avoid_item_close           = false;
     m_skid_probability_state     = SKID_PROBAB_NOT_YET;
     m_last_item_random           = NULL;
@@ -219,6 +221,12 @@ void SkiddingAI::update(int ticks)
 {
     float dt = stk_config->ticks2Time(ticks);
 
+    // Use the results of decide() if it was called for this update
+    const bool decided = m_decided;
+    m_decided = false;
+    if (!decided)
+        m_aim_last_node = Graph::UNKNOWN_SECTOR;
+
     // Clear stored items if they were deleted (for example a switched nitro)
     if (m_item_to_collect &&
         !m_item_manager->itemExists(m_item_to_collect))
@@ -255,12 +263,15 @@ void SkiddingAI::update(int ticks)
         return;
     }
 
-    // Get information that is needed by more than 1 of the handling funcs
-    computeNearestKarts();
+    if (!decided)
+    {
+        // Get information that is needed by more than 1 of the handling funcs
+        computeNearestKarts();
 
-    //Detect if we are going to crash with the track and/or kart
-    checkCrashes(m_kart->getXYZ());
-    determineTrackDirection();
+        //Detect if we are going to crash with the track and/or kart
+        checkCrashes(m_kart->getXYZ());
+        determineTrackDirection();
+    }
 
     /*Response handling functions*/
     handleAccelerationAndBraking(ticks);
@@ -276,6 +287,26 @@ void SkiddingAI::update(int ticks)
     AIBaseLapController::update(ticks);
 }   // update
 
+//-----------------------------------------------------------------------------
+/** Computes the nearest karts, possible crashes, the track direction and the
+ *  point to aim at, which are the most expensive parts of update(). This is
+ *  called for all karts in parallel before they are updated (see
+ *  Controller::decide), so it must not modify anything but this AI.
+ *  \param ticks Number of physics time steps.
+ */
+void SkiddingAI::decide(int ticks)
+{
+    // update() does not use any of this in these cases
+    if (m_kart->getKartAnimation() || isStuck())
+        return;
+
+    computeNearestKarts();
+    checkCrashes(m_kart->getXYZ());
+    determineTrackDirection();
+    findAimPoint(&m_aim_point, &m_aim_last_node);
+    m_decided = true;
+}   // decide
+
 //-----------------------------------------------------------------------------
 /** Decides in which direction to steer. If the kart is off track, it will
  *  steer towards the center of the track. Otherwise it will call one of
@@ -386,13 +417,13 @@ void SkiddingAI::handleSteering(float dt)
         Vec3 aim_point;
         int last_node = Graph::UNKNOWN_SECTOR;
 
-        switch(m_point_selection_algorithm)
+        if (m_aim_last_node != Graph::UNKNOWN_SECTOR)
         {
-        case PSA_NEW:    findNonCrashingPointNew(&aim_point, &last_node);
-                         break;
-        case PSA_DEFAULT:findNonCrashingPoint(&aim_point, &last_node);
-                         break;
+            aim_point = m_aim_point;
+            last_node = m_aim_last_node;
         }
+        else
+            findAimPoint(&aim_point, &last_node);
 #ifdef AI_DEBUG
         m_debug_sphere[m_point_selection_algorithm]->setPosition(aim_point.toIrrVector());
 #endif
@@ -2465,6 +2496,23 @@ void SkiddingAI::findNonCrashingPointNew(Vec3 *result, int *last_node)
     *result = DriveGraph::get()->getNode(*last_node)->getCenter();
 }   // findNonCrashingPointNew
 
+//-----------------------------------------------------------------------------
+/** Finds the point to aim at using the selected point selection algorithm,
+ *  see m_point_selection_algorithm.
+ *  \param result On exit contains the point the AI should aim at.
+ *  \param last_node On exit contains the graph node the AI is aiming at.
+ */
+void SkiddingAI::findAimPoint(Vec3 *result, int *last_node)
+{
+    switch(m_point_selection_algorithm)
+    {
+    case PSA_NEW:    findNonCrashingPointNew(result, last_node);
+                     break;
+    case PSA_DEFAULT:findNonCrashingPoint(result, last_node);
+                     break;
+    }
+}   // findAimPoint
+
 //-----------------------------------------------------------------------------
 /** This is basically the original AI algorithm. It is clearly buggy:
  *  1. the test:
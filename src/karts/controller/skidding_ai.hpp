@@ -173,6 +173,12 @@ private:
      *  the last node that is still turning left etc. */
     unsigned int m_last_direction_node;
 
+    /** The point to aim at and its graph node as found by decide(), see
+     *  findAimPoint(). The node is UNKNOWN_SECTOR if decide() was not
+     *  called for the current update. */
+    Vec3  m_aim_point;
+    int   m_aim_last_node;
+
     /** If set an item that the AI should aim for. */
     const ItemState *m_item_to_collect;
 
@@ -281,6 +287,7 @@ private:
     void  checkCrashes(const Vec3& pos);
     void  findNonCrashingPointNew(Vec3 *result, int *last_node);
     void  findNonCrashingPoint(Vec3 *result, int *last_node);
+    void  findAimPoint(Vec3 *result, int *last_node);
 
     void  determineTrackDirection();
     virtual bool canSkid(float steer_fraction);
@@ -294,6 +301,7 @@ public:
                  SkiddingAI(AbstractKart *kart);
                 ~SkiddingAI();
     virtual void update      (int ticks);
+    virtual void decide      (int ticks);
     virtual void reset       ();
     virtual const irr::core::stringw& getNamePostfix() const;
 };
@@ -115,8 +115,12 @@ void SoccerAI::update(int ticks)
     m_red_sphere->setPosition(red.toIrrVector());
     m_blue_sphere->setPosition(blue.toIrrVector());
 #endif
-    m_force_brake = false;
-    m_chasing_ball = false;
+    // Otherwise decide() already reset them before finding the target
+    if (!m_decided)
+    {
+        m_force_brake = false;
+        m_chasing_ball = false;
+    }
     m_front_transform.setOrigin(m_kart->getFrontXYZ());
     m_front_transform.setBasis(m_kart->getTrans().getBasis());
 
@@ -132,6 +136,23 @@ void SoccerAI::update(int ticks)
     ArenaAI::update(ticks);
 }   // update
 
+//-----------------------------------------------------------------------------
+/** Finds the target of this AI (which may be the ball) for the next update,
+ *  see ArenaAI::decide.
+ *  \param ticks Number of physics time steps.
+ */
+void SoccerAI::decide(int ticks)
+{
+    if (m_world->isGoalPhase())
+        return;
+
+    m_force_brake = false;
+    m_chasing_ball = false;
+    m_front_transform.setOrigin(m_kart->getFrontXYZ());
+    m_front_transform.setBasis(m_kart->getTrans().getBasis());
+    ArenaAI::decide(ticks);
+}   // decide
+
 //-----------------------------------------------------------------------------
 /** Find the closest kart around this AI, it won't find the kart with same
  *  team, consider_difficulty and find_sta are not used here.
@@ -102,6 +102,7 @@ public:
                  SoccerAI(AbstractKart *kart);
                 ~SoccerAI();
     virtual void update (int ticks) OVERRIDE;
+    virtual void decide (int ticks) OVERRIDE;
     virtual void reset() OVERRIDE;
 
 };
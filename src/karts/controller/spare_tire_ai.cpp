@@ -26,6 +26,7 @@
 #include "tracks/arena_node.hpp"
 #include "physics/physics.hpp"
 #include "utils/random_generator.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <algorithm>
@@ -128,6 +129,24 @@ void SpareTireAI::unspawn()
     m_kart->eliminate();
 }   // unspawn
 
+//-----------------------------------------------------------------------------
+/** Saves the path index and the time left before \ref unspawn. The kart
+ *  itself (including if it is in the physics world) is saved by the world.
+ */
+void SpareTireAI::saveState(StateBuffer *buffer) const
+{
+    buffer->add<int>(m_idx);
+    buffer->add<int>(m_timer);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void SpareTireAI::restoreState(StateBuffer *buffer)
+{
+    m_idx   = buffer->get<int>();
+    m_timer = buffer->get<int>();
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Callback function when a kart crashes into the SpareTireAI, the kart will
  *  increase one life if its life is not equal 3. A message will be shown too.
@@ -21,6 +21,8 @@
 
 #include "karts/controller/battle_ai.hpp"
 
+class StateBuffer;
+
 /** The AI for spare tire karts in battle mode, allowing kart to gain life.
  * \ingroup controller
  */
@@ -55,6 +57,10 @@ public:
     // ------------------------------------------------------------------------
     void         unspawn();
     // ------------------------------------------------------------------------
+    void         saveState(StateBuffer *buffer) const;
+    // ------------------------------------------------------------------------
+    void         restoreState(StateBuffer *buffer);
+    // ------------------------------------------------------------------------
     /** Return true if this AI needed to be called \ref update by \ref World,
      *  ie it is spawned. */
     bool         isMoving() const                       { return m_idx != -1; }
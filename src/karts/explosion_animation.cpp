@@ -29,6 +29,7 @@
 #include "race/race_manager.hpp"
 #include "tracks/track.hpp"
 #include "utils/mini_glm.hpp"
+#include "utils/state_buffer.hpp"
 
 #include <cstring>
 
@@ -120,6 +121,28 @@ ExplosionAnimation::ExplosionAnimation(AbstractKart* kart, bool direct_hit)
         resetPowerUp();
 }   // ExplosionAnimation
 
+// ----------------------------------------------------------------------------
+/** Restores an explosion written by saveState(). Unlike the other
+ *  constructor this does not move the kart, make it invulnerable or clear
+ *  attachments and powerups: these effects are already part of the saved
+ *  state.
+ *  \param kart Pointer to the kart which is animated.
+ *  \param buffer The buffer to read the state from.
+ */
+ExplosionAnimation::ExplosionAnimation(AbstractKart* kart,
+                                       StateBuffer* buffer)
+                  : AbstractKartAnimation(kart, "ExplosionAnimation", buffer)
+{
+    // update() ends an explosion early if the kart would be below the track
+    const int end_ticks = m_end_ticks;
+    bool direct_hit = buffer->get<bool>();
+    Vec3 normal = buffer->getVec3();
+    btTransform reset_trans = buffer->getTransform();
+    MiniGLM::compressbtTransform(reset_trans, m_reset_trans_compressed);
+    init(direct_hit, normal, reset_trans);
+    m_end_ticks = end_ticks;
+}   // ExplosionAnimation
+
 //-----------------------------------------------------------------------------
 ExplosionAnimation::~ExplosionAnimation()
 {
@@ -204,6 +227,16 @@ void ExplosionAnimation::init(bool direct_hit, const Vec3& normal,
         ((m_created_ticks / 11) % (2 * max_rotation + 1) - max_rotation) * f);
 }   // init
 
+// ----------------------------------------------------------------------------
+/** Saves the state read by the state constructor. */
+void ExplosionAnimation::saveState(StateBuffer *buffer) const
+{
+    AbstractKartAnimation::saveState(buffer);
+    buffer->add<bool>(m_direct_hit);
+    buffer->addVec3(m_normal);
+    buffer->addTransform(m_reset_trans);
+}   // saveState
+
 // ----------------------------------------------------------------------------
 /** Updates the kart animation.
  *  \param ticks Number of time steps - should be 1.
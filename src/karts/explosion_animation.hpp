@@ -38,6 +38,7 @@ class ExplosionAnimation: public AbstractKartAnimation
 {
 protected:
 friend class KartRewinder;
+friend class Kart;
     /** The normal of kart when it started to explode. */
     Vec3 m_normal;
 
@@ -68,6 +69,8 @@ friend class KartRewinder;
               const btTransform& reset_trans);
     // ------------------------------------------------------------------------
     ExplosionAnimation(AbstractKart* kart, bool direct_hit);
+    // ------------------------------------------------------------------------
+    ExplosionAnimation(AbstractKart* kart, StateBuffer* buffer);
 public:
     // ------------------------------------------------------------------------
     static ExplosionAnimation *create(AbstractKart* kart, const Vec3 &pos,
@@ -81,6 +84,11 @@ public:
     // ------------------------------------------------------------------------
     virtual void updateGraphics(float dt);
     // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const;
+    // ------------------------------------------------------------------------
+    /** Returns if this explosion was caused by a direct hit. */
+    bool isDirectHit() const { return m_direct_hit; }
+    // ------------------------------------------------------------------------
     virtual KartAnimationType getAnimationType() const
                                                       { return KAT_EXPLOSION; }
     // ------------------------------------------------------------------------
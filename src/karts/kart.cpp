@@ -70,6 +70,7 @@
 #include "utils/helpers.hpp"
 #include "utils/log.hpp" //TODO: remove after debugging is done
 #include "utils/profiler.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/vs.hpp"
 
@@ -360,6 +361,166 @@ void Kart::reset()
 
 }   // reset
 
+// -----------------------------------------------------------------------------
+/** Saves the simulation state of this kart, i.e. everything that influences
+ *  the following time steps. Purely graphical state (particles, skid marks,
+ *  kart model animations) and the internal state of the controller are not
+ *  saved.
+ *  \param buffer The buffer to append the state to.
+ */
+void Kart::saveState(StateBuffer *buffer) const
+{
+    // The animation comes first: on restore it has to be re-created at its
+    // original position before the body state is restored.
+    int animation_type = -1;
+    if (m_kart_animation &&
+        m_kart_animation->getAnimationType() != KAT_CANNON)
+        animation_type = m_kart_animation->getAnimationType();
+    buffer->add<int>(animation_type);
+    if (animation_type != -1)
+        m_kart_animation->saveState(buffer);
+
+    saveBodyState(buffer);
+    m_vehicle->saveState(buffer);
+    m_controls.saveState(buffer);
+    m_skidding->saveState(buffer);
+    m_max_speed->saveState(buffer);
+    m_slipstream->saveState(buffer);
+    m_powerup->saveState(buffer);
+    m_attachment->saveState(buffer);
+
+    buffer->add<bool>(m_is_jumping);
+    buffer->add<bool>(m_flying);
+    buffer->add<bool>(m_bubblegum_torque_sign);
+    buffer->add<uint8_t>(m_bounce_back_ticks);
+    buffer->add<bool>(m_has_caught_nolok_bubblegum);
+    buffer->add<bool>(m_eliminated);
+    buffer->add<int>(m_race_position);
+    buffer->add<int>(m_brake_ticks);
+    buffer->add<int16_t>(m_invulnerable_ticks);
+    buffer->add<int16_t>(m_bubblegum_ticks);
+    buffer->add<int16_t>(m_view_blocked_by_plunger);
+    buffer->add<float>(m_current_lean);
+    buffer->add<int8_t>(m_min_nitro_ticks);
+    buffer->add<bool>(m_fire_clicked);
+    buffer->add<bool>(m_finished_race);
+    buffer->add<float>(m_finish_time);
+    buffer->add<float>(m_collected_energy);
+    buffer->add<float>(m_energy_to_min_ratio);
+    buffer->add<float>(m_startup_boost);
+    buffer->add<float>(m_falling_time);
+    buffer->add<float>(m_speed);
+    buffer->add<int>(m_ticks_last_crash);
+    buffer->add<int>(m_ticks_last_zipper);
+    buffer->add<PowerupManager::PowerupType>(m_last_used_powerup);
+    buffer->addVec3(m_xyz_front);
+    buffer->add<float>(m_time_previous_counter);
+    for (int i = 0; i < m_xyz_history_size; i++)
+    {
+        buffer->addVec3(m_previous_xyz[i]);
+        buffer->add<float>(m_previous_xyz_times[i]);
+    }
+    // Eliminated karts, karts in an animation and spare tire karts that are
+    // not spawned have no body in the physics world.
+    buffer->add<bool>(m_body->getBroadphaseHandle() != NULL);
+    buffer->add<bool>(m_node && m_node->isVisible());
+}   // saveState
+
+// -----------------------------------------------------------------------------
+/** Restores the state written by saveState(). Rescue and explosion
+ *  animations are re-created from their saved state, without the side
+ *  effects of starting one. Cannon animations are not restored.
+ *  \param buffer The buffer to read the state from.
+ */
+void Kart::restoreState(StateBuffer *buffer)
+{
+    if (m_kart_animation)
+    {
+        AbstractKartAnimation *ka = m_kart_animation;
+        setKartAnimation(NULL);
+        delete ka;
+    }
+    // The animations register themselves with the kart, see
+    // AbstractKartAnimation
+    int animation_type = buffer->get<int>();
+    if (animation_type == KAT_EXPLOSION)
+        new ExplosionAnimation(this, buffer);
+    else if (animation_type == KAT_RESCUE)
+        new RescueAnimation(this, buffer);
+
+    restoreBodyState(buffer);
+    m_vehicle->restoreState(buffer);
+    m_controls.restoreState(buffer);
+    m_skidding->restoreState(buffer);
+    m_max_speed->restoreState(buffer);
+    m_slipstream->restoreState(buffer);
+    m_powerup->restoreState(buffer);
+    m_attachment->restoreState(buffer);
+
+    m_is_jumping              = buffer->get<bool>();
+    bool flying               = buffer->get<bool>();
+    if (m_flying && !flying)
+        stopFlying();
+    m_flying                  = flying;
+    m_bubblegum_torque_sign   = buffer->get<bool>();
+    m_bounce_back_ticks       = buffer->get<uint8_t>();
+    m_has_caught_nolok_bubblegum = buffer->get<bool>();
+    m_eliminated              = buffer->get<bool>();
+    m_race_position           = buffer->get<int>();
+    m_brake_ticks             = buffer->get<int>();
+    m_invulnerable_ticks      = buffer->get<int16_t>();
+    m_bubblegum_ticks         = buffer->get<int16_t>();
+    m_view_blocked_by_plunger = buffer->get<int16_t>();
+    m_current_lean            = buffer->get<float>();
+    m_min_nitro_ticks         = buffer->get<int8_t>();
+    m_fire_clicked            = buffer->get<bool>();
+    bool finished_race        = buffer->get<bool>();
+    m_finish_time             = buffer->get<float>();
+    m_collected_energy        = buffer->get<float>();
+    m_energy_to_min_ratio     = buffer->get<float>();
+    m_startup_boost           = buffer->get<float>();
+    m_falling_time            = buffer->get<float>();
+    m_speed                   = buffer->get<float>();
+    m_ticks_last_crash        = buffer->get<int>();
+    m_ticks_last_zipper       = buffer->get<int>();
+    m_last_used_powerup       = buffer->get<PowerupManager::PowerupType>();
+    m_xyz_front               = buffer->getVec3();
+    m_time_previous_counter   = buffer->get<float>();
+    for (int i = 0; i < m_xyz_history_size; i++)
+    {
+        m_previous_xyz[i]       = buffer->getVec3();
+        m_previous_xyz_times[i] = buffer->get<float>();
+    }
+
+    // Swap the end controller in or out, the same way finishedRace() and
+    // reset() do. Spare tire karts keep their controller.
+    if (!finished_race && m_finished_race && m_saved_controller)
+    {
+        delete m_controller;
+        m_controller       = m_saved_controller;
+        m_saved_controller = NULL;
+    }
+    else if (finished_race && !m_finished_race && !m_saved_controller &&
+             dynamic_cast<SpareTireAI*>(m_controller) == NULL)
+    {
+        setController(new EndController(this, m_controller));
+    }
+    m_finished_race = finished_race;
+
+    const bool in_physics = m_body->getBroadphaseHandle() != NULL;
+    const bool saved_in_physics = buffer->get<bool>();
+    if (in_physics && !saved_in_physics)
+        Physics::get()->removeKart(this);
+    else if (!in_physics && saved_in_physics)
+        Physics::get()->addKart(this);
+    const bool visible = buffer->get<bool>();
+    if (m_node)
+        m_node->setVisible(visible);
+
+    m_terrain_info->update(getTrans().getBasis(),
+        getTrans().getOrigin() + getTrans().getBasis() * Vec3(0, 0.3f, 0));
+}   // restoreState
+
 // -----------------------------------------------------------------------------
 void Kart::setXYZ(const Vec3& a)
 {
@@ -632,7 +793,8 @@ void Kart::createPhysics()
     trans.setIdentity();
     createBody(mass, trans, m_kart_chassis.get(),
                m_kart_properties->getRestitution(0.0f));
-    std::vector<float> ang_fact = m_kart_properties->getStabilityAngularFactor();
+    const std::vector<float> &ang_fact =
+        m_kart_properties->getStabilityAngularFactor();
     // The angular factor (with X and Z values <1) helps to keep the kart
     // upright, especially in case of a collision.
     m_body->setAngularFactor(Vec3(ang_fact[0], ang_fact[1], ang_fact[2]));
@@ -754,11 +916,8 @@ void Kart::updateWeight()
  *  \param radius The radius for which the speed needs to be computed. */
 float Kart::getSpeedForTurnRadius(float radius) const
 {
-    InterpolationArray turn_angle_at_speed = m_kart_properties->getTurnRadius();
-    // Convert the turn radius into turn angle
-    for(int i = 0; i < (int)turn_angle_at_speed.size(); i++)
-        turn_angle_at_speed.setY(i, sinf( 1.0f / turn_angle_at_speed.getY(i)));
-
+    const InterpolationArray &turn_angle_at_speed =
+        m_kart_properties->getTurnAngleAtSpeed();
     float angle = sinf(1.0f / radius);
     return turn_angle_at_speed.getReverse(angle);
 }   // getSpeedForTurnRadius
@@ -770,16 +929,11 @@ float Kart::getSpeedForTurnRadius(float radius) const
     real raw steer angle. */
 float Kart::getMaxSteerAngle(float speed) const
 {
-    InterpolationArray turn_angle_at_speed = m_kart_properties->getTurnRadius();
-    // Convert the turn radius into turn angle
     // We multiply by wheel base to keep turn radius identical
     // across karts of different lengths sharing the same
     // turn radius properties
-    for(int i = 0; i < (int)turn_angle_at_speed.size(); i++)
-        turn_angle_at_speed.setY(i, sinf( 1.0f / turn_angle_at_speed.getY(i))
-                                    * m_kart_properties->getWheelBase());
-
-    return turn_angle_at_speed.get(speed);
+    return m_kart_properties->getTurnAngleAtSpeed().get(speed)
+         * m_kart_properties->getWheelBase();
 }   // getMaxSteerAngle
 
 //-----------------------------------------------------------------------------
@@ -282,6 +282,8 @@ public:
     virtual float getTerrainPitch(float heading) const OVERRIDE;
 
     virtual void   reset            () OVERRIDE;
+    virtual void   saveState        (StateBuffer *buffer) const OVERRIDE;
+    virtual void   restoreState     (StateBuffer *buffer) OVERRIDE;
     virtual void   handleZipper     (const Material *m=NULL) OVERRIDE;
     virtual bool   setSquash        (float time, float slowdown) OVERRIDE;
             void   setSquashGraphics();
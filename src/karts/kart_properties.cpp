@@ -65,6 +65,7 @@ std::string KartProperties::getHandicapAsString(HandicapLevel h)
 KartProperties::KartProperties(const std::string &filename)
 {
     m_is_addon = false;
+    m_models_loaded = false;
     m_icon_material = NULL;
     m_minimap_icon  = NULL;
     m_name          = "NONAME";
@@ -171,7 +172,8 @@ void KartProperties::copyFrom(const KartProperties *source)
 }   // copyFrom
 
 //-----------------------------------------------------------------------------
-/** Loads the kart properties from a file.
+/** Loads the kart properties from a file. The meshes of the kart model are
+ *  not loaded here, see loadModels().
  *  \param filename Filename to load.
  *  \param node Name of the xml node to load the data from
  */
@@ -269,6 +271,33 @@ void KartProperties::load(const std::string &filename, const std::string &node)
     else
         m_minimap_icon = NULL;
 
+    m_shadow_material = material_manager->getMaterialSPM(m_shadow_file, "",
+        "alphablend");
+
+    STKTexManager::getInstance()->unsetTextureErrorMessage();
+    file_manager->popTextureSearchPath();
+    file_manager->popModelSearchPath();
+
+}   // load
+
+//-----------------------------------------------------------------------------
+/** Loads the meshes and textures of the master kart model, and computes the
+ *  values that depend on the size of the model. This is not done in load(),
+ *  since most karts are never used in a race, and is done by the
+ *  KartPropertiesManager before a kart is created. Does nothing if the
+ *  models are already loaded.
+ */
+void KartProperties::loadModels()
+{
+    if (m_models_loaded)
+        return;
+
+    std::string unique_id = StringUtils::insertValues("karts/%s", m_ident.c_str());
+    file_manager->pushModelSearchPath(m_root);
+    file_manager->pushTextureSearchPath(m_root, unique_id);
+    STKTexManager::getInstance()
+        ->setTextureErrorMessage("Error while loading kart '%s':", m_name);
+
     // Only load the model if the .kart file has the appropriate version,
     // otherwise warnings are printed.
     if (m_version >= 1)
@@ -276,9 +305,11 @@ void KartProperties::load(const std::string &filename, const std::string &node)
         const bool success = m_kart_model->loadModels(*this);
         if (!success)
         {
+            STKTexManager::getInstance()->unsetTextureErrorMessage();
             file_manager->popTextureSearchPath();
             file_manager->popModelSearchPath();
-            throw std::runtime_error("Cannot load kart models");
+            throw std::runtime_error("Cannot load kart models of '" +
+                                     m_ident + "'");
         }
     }
 
@@ -303,14 +334,35 @@ void KartProperties::load(const std::string &filename, const std::string &node)
     // closely (+-0,1%) with the specifications in kart_characteristics.xml
     m_wheel_base = fabsf(m_kart_model->getLength()/1.425f);
 
-    m_shadow_material = material_manager->getMaterialSPM(m_shadow_file, "",
-        "alphablend");
-
     STKTexManager::getInstance()->unsetTextureErrorMessage();
     file_manager->popTextureSearchPath();
     file_manager->popModelSearchPath();
+    m_models_loaded = true;
+}   // loadModels
 
-}   // load
+//-----------------------------------------------------------------------------
+/** Frees the meshes and textures of the master kart model. The model is
+ *  replaced by a new master model with the same information from kart.xml,
+ *  so loadModels() can load it again later. Must not be called while a kart
+ *  in a race uses the model, see isModelInUse().
+ */
+void KartProperties::unloadModels()
+{
+    if (!m_models_loaded)
+        return;
+    assert(!isModelInUse());
+
+    const XMLNode root(m_root + "kart.xml");
+    std::string hat_name = m_kart_model->getHatMeshName();
+    m_kart_model = std::make_shared<KartModel>(/*is_master*/true);
+    m_kart_model->loadInfo(root);
+    m_kart_model->setHatMeshName(hat_name);
+    m_models_loaded = false;
+#ifndef SERVER_ONLY
+    if (CVS->isGLSL())
+        SP::SPTextureManager::get()->removeUnusedTextures();
+#endif
+}   // unloadModels
 
 // ----------------------------------------------------------------------------
 /** Returns a pointer to the KartModel object.
@@ -489,6 +541,15 @@ const AbstractCharacteristic* KartProperties::getCombinedCharacteristic() const
     return m_combined_characteristic.get();
 }   // getCombinedCharacteristic
 
+// ----------------------------------------------------------------------------
+/** Returns sin(1/turn_radius) for each speed, which is used to compute the
+ *  maximum steering angle of a kart.
+ */
+const InterpolationArray& KartProperties::getTurnAngleAtSpeed() const
+{
+    return m_cached_characteristic->getTurnAngleAtSpeed();
+}   // getTurnAngleAtSpeed
+
 // ----------------------------------------------------------------------------
 bool KartProperties::isInGroup(const std::string &group) const
 {
@@ -539,643 +600,643 @@ core::stringw KartProperties::getName() const
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionStiffness() const
 {
-    return m_cached_characteristic->getSuspensionStiffness();
+    return m_cached_characteristic->getValues().m_suspension_stiffness;
 }  // getSuspensionStiffness
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionRest() const
 {
-    return m_cached_characteristic->getSuspensionRest();
+    return m_cached_characteristic->getValues().m_suspension_rest;
 }  // getSuspensionRest
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionTravel() const
 {
-    return m_cached_characteristic->getSuspensionTravel();
+    return m_cached_characteristic->getValues().m_suspension_travel;
 }  // getSuspensionTravel
 
 // ----------------------------------------------------------------------------
 bool KartProperties::getSuspensionExpSpringResponse() const
 {
-    return m_cached_characteristic->getSuspensionExpSpringResponse();
+    return m_cached_characteristic->getValues().m_suspension_exp_spring_response;
 }  // getSuspensionExpSpringResponse
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionMaxForce() const
 {
-    return m_cached_characteristic->getSuspensionMaxForce();
+    return m_cached_characteristic->getValues().m_suspension_max_force;
 }  // getSuspensionMaxForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityRollInfluence() const
 {
-    return m_cached_characteristic->getStabilityRollInfluence();
+    return m_cached_characteristic->getValues().m_stability_roll_influence;
 }  // getStabilityRollInfluence
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityChassisLinearDamping() const
 {
-    return m_cached_characteristic->getStabilityChassisLinearDamping();
+    return m_cached_characteristic->getValues().m_stability_chassis_linear_damping;
 }  // getStabilityChassisLinearDamping
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityChassisAngularDamping() const
 {
-    return m_cached_characteristic->getStabilityChassisAngularDamping();
+    return m_cached_characteristic->getValues().m_stability_chassis_angular_damping;
 }  // getStabilityChassisAngularDamping
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityDownwardImpulseFactor() const
 {
-    return m_cached_characteristic->getStabilityDownwardImpulseFactor();
+    return m_cached_characteristic->getValues().m_stability_downward_impulse_factor;
 }  // getStabilityDownwardImpulseFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityTrackConnectionAccel() const
 {
-    return m_cached_characteristic->getStabilityTrackConnectionAccel();
+    return m_cached_characteristic->getValues().m_stability_track_connection_accel;
 }  // getStabilityTrackConnectionAccel
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStabilityAngularFactor() const
+const std::vector<float>& KartProperties::getStabilityAngularFactor() const
 {
-    return m_cached_characteristic->getStabilityAngularFactor();
+    return m_cached_characteristic->getValues().m_stability_angular_factor;
 }  // getStabilityAngularFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilitySmoothFlyingImpulse() const
 {
-    return m_cached_characteristic->getStabilitySmoothFlyingImpulse();
+    return m_cached_characteristic->getValues().m_stability_smooth_flying_impulse;
 }  // getStabilitySmoothFlyingImpulse
 
 // ----------------------------------------------------------------------------
-InterpolationArray KartProperties::getTurnRadius() const
+const InterpolationArray& KartProperties::getTurnRadius() const
 {
-    return m_cached_characteristic->getTurnRadius();
+    return m_cached_characteristic->getValues().m_turn_radius;
 }  // getTurnRadius
 
 // ----------------------------------------------------------------------------
 float KartProperties::getTurnTimeResetSteer() const
 {
-    return m_cached_characteristic->getTurnTimeResetSteer();
+    return m_cached_characteristic->getValues().m_turn_time_reset_steer;
 }  // getTurnTimeResetSteer
 
 // ----------------------------------------------------------------------------
-InterpolationArray KartProperties::getTurnTimeFullSteer() const
+const InterpolationArray& KartProperties::getTurnTimeFullSteer() const
 {
-    return m_cached_characteristic->getTurnTimeFullSteer();
+    return m_cached_characteristic->getValues().m_turn_time_full_steer;
 }  // getTurnTimeFullSteer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEnginePower() const
 {
-    return m_cached_characteristic->getEnginePower();
+    return m_cached_characteristic->getValues().m_engine_power;
 }  // getEnginePower
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineMaxSpeed() const
 {
-    return m_cached_characteristic->getEngineMaxSpeed();
+    return m_cached_characteristic->getValues().m_engine_max_speed;
 }  // getEngineMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineGenericMaxSpeed() const
 {
-    return m_cached_characteristic->getEngineGenericMaxSpeed();
+    return m_cached_characteristic->getValues().m_engine_generic_max_speed;
 }  // getEngineGenericMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineBrakeFactor() const
 {
-    return m_cached_characteristic->getEngineBrakeFactor();
+    return m_cached_characteristic->getValues().m_engine_brake_factor;
 }  // getEngineBrakeFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineBrakeTimeIncrease() const
 {
-    return m_cached_characteristic->getEngineBrakeTimeIncrease();
+    return m_cached_characteristic->getValues().m_engine_brake_time_increase;
 }  // getEngineBrakeTimeIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineMaxSpeedReverseRatio() const
 {
-    return m_cached_characteristic->getEngineMaxSpeedReverseRatio();
+    return m_cached_characteristic->getValues().m_engine_max_speed_reverse_ratio;
 }  // getEngineMaxSpeedReverseRatio
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getGearSwitchRatio() const
+const std::vector<float>& KartProperties::getGearSwitchRatio() const
 {
-    return m_cached_characteristic->getGearSwitchRatio();
+    return m_cached_characteristic->getValues().m_gear_switch_ratio;
 }  // getGearSwitchRatio
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getGearPowerIncrease() const
+const std::vector<float>& KartProperties::getGearPowerIncrease() const
 {
-    return m_cached_characteristic->getGearPowerIncrease();
+    return m_cached_characteristic->getValues().m_gear_power_increase;
 }  // getGearPowerIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getMass() const
 {
-    return m_cached_characteristic->getMass();
+    return m_cached_characteristic->getValues().m_mass;
 }  // getMass
 
 // ----------------------------------------------------------------------------
 float KartProperties::getWheelsDampingRelaxation() const
 {
-    return m_cached_characteristic->getWheelsDampingRelaxation();
+    return m_cached_characteristic->getValues().m_wheels_damping_relaxation;
 }  // getWheelsDampingRelaxation
 
 // ----------------------------------------------------------------------------
 float KartProperties::getWheelsDampingCompression() const
 {
-    return m_cached_characteristic->getWheelsDampingCompression();
+    return m_cached_characteristic->getValues().m_wheels_damping_compression;
 }  // getWheelsDampingCompression
 
 // ----------------------------------------------------------------------------
 float KartProperties::getJumpAnimationTime() const
 {
-    return m_cached_characteristic->getJumpAnimationTime();
+    return m_cached_characteristic->getValues().m_jump_animation_time;
 }  // getJumpAnimationTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getLeanMax() const
 {
-    return m_cached_characteristic->getLeanMax();
+    return m_cached_characteristic->getValues().m_lean_max;
 }  // getLeanMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getLeanSpeed() const
 {
-    return m_cached_characteristic->getLeanSpeed();
+    return m_cached_characteristic->getValues().m_lean_speed;
 }  // getLeanSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilDuration() const
 {
-    return m_cached_characteristic->getAnvilDuration();
+    return m_cached_characteristic->getValues().m_anvil_duration;
 }  // getAnvilDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilWeight() const
 {
-    return m_cached_characteristic->getAnvilWeight();
+    return m_cached_characteristic->getValues().m_anvil_weight;
 }  // getAnvilWeight
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilSpeedFactor() const
 {
-    return m_cached_characteristic->getAnvilSpeedFactor();
+    return m_cached_characteristic->getValues().m_anvil_speed_factor;
 }  // getAnvilSpeedFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteFriction() const
 {
-    return m_cached_characteristic->getParachuteFriction();
+    return m_cached_characteristic->getValues().m_parachute_friction;
 }  // getParachuteFriction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDuration() const
 {
-    return m_cached_characteristic->getParachuteDuration();
+    return m_cached_characteristic->getValues().m_parachute_duration;
 }  // getParachuteDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDurationOther() const
 {
-    return m_cached_characteristic->getParachuteDurationOther();
+    return m_cached_characteristic->getValues().m_parachute_duration_other;
 }  // getParachuteDurationOther
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDurationRankMult() const
 {
-    return m_cached_characteristic->getParachuteDurationRankMult();
+    return m_cached_characteristic->getValues().m_parachute_duration_rank_mult;
 }  // getParachuteDurationRankMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDurationSpeedMult() const
 {
-    return m_cached_characteristic->getParachuteDurationSpeedMult();
+    return m_cached_characteristic->getValues().m_parachute_duration_speed_mult;
 }  // getParachuteDurationSpeedMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteLboundFraction() const
 {
-    return m_cached_characteristic->getParachuteLboundFraction();
+    return m_cached_characteristic->getValues().m_parachute_lbound_fraction;
 }  // getParachuteLboundFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteUboundFraction() const
 {
-    return m_cached_characteristic->getParachuteUboundFraction();
+    return m_cached_characteristic->getValues().m_parachute_ubound_fraction;
 }  // getParachuteUboundFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteMaxSpeed() const
 {
-    return m_cached_characteristic->getParachuteMaxSpeed();
+    return m_cached_characteristic->getValues().m_parachute_max_speed;
 }  // getParachuteMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getFrictionKartFriction() const
 {
-    return m_cached_characteristic->getFrictionKartFriction();
+    return m_cached_characteristic->getValues().m_friction_kart_friction;
 }  // getFrictionKartFriction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumDuration() const
 {
-    return m_cached_characteristic->getBubblegumDuration();
+    return m_cached_characteristic->getValues().m_bubblegum_duration;
 }  // getBubblegumDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumSpeedFraction() const
 {
-    return m_cached_characteristic->getBubblegumSpeedFraction();
+    return m_cached_characteristic->getValues().m_bubblegum_speed_fraction;
 }  // getBubblegumSpeedFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumTorque() const
 {
-    return m_cached_characteristic->getBubblegumTorque();
+    return m_cached_characteristic->getValues().m_bubblegum_torque;
 }  // getBubblegumTorque
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumFadeInTime() const
 {
-    return m_cached_characteristic->getBubblegumFadeInTime();
+    return m_cached_characteristic->getValues().m_bubblegum_fade_in_time;
 }  // getBubblegumFadeInTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumShieldDuration() const
 {
-    return m_cached_characteristic->getBubblegumShieldDuration();
+    return m_cached_characteristic->getValues().m_bubblegum_shield_duration;
 }  // getBubblegumShieldDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperDuration() const
 {
-    return m_cached_characteristic->getZipperDuration();
+    return m_cached_characteristic->getValues().m_zipper_duration;
 }  // getZipperDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperForce() const
 {
-    return m_cached_characteristic->getZipperForce();
+    return m_cached_characteristic->getValues().m_zipper_force;
 }  // getZipperForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperSpeedGain() const
 {
-    return m_cached_characteristic->getZipperSpeedGain();
+    return m_cached_characteristic->getValues().m_zipper_speed_gain;
 }  // getZipperSpeedGain
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getZipperMaxSpeedIncrease();
+    return m_cached_characteristic->getValues().m_zipper_max_speed_increase;
 }  // getZipperMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperFadeOutTime() const
 {
-    return m_cached_characteristic->getZipperFadeOutTime();
+    return m_cached_characteristic->getValues().m_zipper_fade_out_time;
 }  // getZipperFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterDuration() const
 {
-    return m_cached_characteristic->getSwatterDuration();
+    return m_cached_characteristic->getValues().m_swatter_duration;
 }  // getSwatterDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterDistance() const
 {
-    return m_cached_characteristic->getSwatterDistance();
+    return m_cached_characteristic->getValues().m_swatter_distance;
 }  // getSwatterDistance
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterSquashDuration() const
 {
-    return m_cached_characteristic->getSwatterSquashDuration();
+    return m_cached_characteristic->getValues().m_swatter_squash_duration;
 }  // getSwatterSquashDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterSquashSlowdown() const
 {
-    return m_cached_characteristic->getSwatterSquashSlowdown();
+    return m_cached_characteristic->getValues().m_swatter_squash_slowdown;
 }  // getSwatterSquashSlowdown
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandMaxLength() const
 {
-    return m_cached_characteristic->getPlungerBandMaxLength();
+    return m_cached_characteristic->getValues().m_plunger_band_max_length;
 }  // getPlungerBandMaxLength
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandForce() const
 {
-    return m_cached_characteristic->getPlungerBandForce();
+    return m_cached_characteristic->getValues().m_plunger_band_force;
 }  // getPlungerBandForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandDuration() const
 {
-    return m_cached_characteristic->getPlungerBandDuration();
+    return m_cached_characteristic->getValues().m_plunger_band_duration;
 }  // getPlungerBandDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandSpeedIncrease() const
 {
-    return m_cached_characteristic->getPlungerBandSpeedIncrease();
+    return m_cached_characteristic->getValues().m_plunger_band_speed_increase;
 }  // getPlungerBandSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandFadeOutTime() const
 {
-    return m_cached_characteristic->getPlungerBandFadeOutTime();
+    return m_cached_characteristic->getValues().m_plunger_band_fade_out_time;
 }  // getPlungerBandFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerInFaceTime() const
 {
-    return m_cached_characteristic->getPlungerInFaceTime();
+    return m_cached_characteristic->getValues().m_plunger_in_face_time;
 }  // getPlungerInFaceTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStartupTime() const
+const std::vector<float>& KartProperties::getStartupTime() const
 {
-    return m_cached_characteristic->getStartupTime();
+    return m_cached_characteristic->getValues().m_startup_time;
 }  // getStartupTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStartupBoost() const
+const std::vector<float>& KartProperties::getStartupBoost() const
 {
-    return m_cached_characteristic->getStartupBoost();
+    return m_cached_characteristic->getValues().m_startup_boost;
 }  // getStartupBoost
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueDuration() const
 {
-    return m_cached_characteristic->getRescueDuration();
+    return m_cached_characteristic->getValues().m_rescue_duration;
 }  // getRescueDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueVertOffset() const
 {
-    return m_cached_characteristic->getRescueVertOffset();
+    return m_cached_characteristic->getValues().m_rescue_vert_offset;
 }  // getRescueVertOffset
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueHeight() const
 {
-    return m_cached_characteristic->getRescueHeight();
+    return m_cached_characteristic->getValues().m_rescue_height;
 }  // getRescueHeight
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionDuration() const
 {
-    return m_cached_characteristic->getExplosionDuration();
+    return m_cached_characteristic->getValues().m_explosion_duration;
 }  // getExplosionDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionRadius() const
 {
-    return m_cached_characteristic->getExplosionRadius();
+    return m_cached_characteristic->getValues().m_explosion_radius;
 }  // getExplosionRadius
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionInvulnerabilityTime() const
 {
-    return m_cached_characteristic->getExplosionInvulnerabilityTime();
+    return m_cached_characteristic->getValues().m_explosion_invulnerability_time;
 }  // getExplosionInvulnerabilityTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroDuration() const
 {
-    return m_cached_characteristic->getNitroDuration();
+    return m_cached_characteristic->getValues().m_nitro_duration;
 }  // getNitroDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroEngineForce() const
 {
-    return m_cached_characteristic->getNitroEngineForce();
+    return m_cached_characteristic->getValues().m_nitro_engine_force;
 }  // getNitroEngineForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroEngineMult() const
 {
-    return m_cached_characteristic->getNitroEngineMult();
+    return m_cached_characteristic->getValues().m_nitro_engine_mult;
 }  // getNitroEngineMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroConsumption() const
 {
-    return m_cached_characteristic->getNitroConsumption();
+    return m_cached_characteristic->getValues().m_nitro_consumption;
 }  // getNitroConsumption
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroSmallContainer() const
 {
-    return m_cached_characteristic->getNitroSmallContainer();
+    return m_cached_characteristic->getValues().m_nitro_small_container;
 }  // getNitroSmallContainer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroBigContainer() const
 {
-    return m_cached_characteristic->getNitroBigContainer();
+    return m_cached_characteristic->getValues().m_nitro_big_container;
 }  // getNitroBigContainer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getNitroMaxSpeedIncrease();
+    return m_cached_characteristic->getValues().m_nitro_max_speed_increase;
 }  // getNitroMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroFadeOutTime() const
 {
-    return m_cached_characteristic->getNitroFadeOutTime();
+    return m_cached_characteristic->getValues().m_nitro_fade_out_time;
 }  // getNitroFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroMax() const
 {
-    return m_cached_characteristic->getNitroMax();
+    return m_cached_characteristic->getValues().m_nitro_max;
 }  // getNitroMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamDurationFactor() const
 {
-    return m_cached_characteristic->getSlipstreamDurationFactor();
+    return m_cached_characteristic->getValues().m_slipstream_duration_factor;
 }  // getSlipstreamDurationFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamBaseSpeed() const
 {
-    return m_cached_characteristic->getSlipstreamBaseSpeed();
+    return m_cached_characteristic->getValues().m_slipstream_base_speed;
 }  // getSlipstreamBaseSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamLength() const
 {
-    return m_cached_characteristic->getSlipstreamLength();
+    return m_cached_characteristic->getValues().m_slipstream_length;
 }  // getSlipstreamLength
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamWidth() const
 {
-    return m_cached_characteristic->getSlipstreamWidth();
+    return m_cached_characteristic->getValues().m_slipstream_width;
 }  // getSlipstreamWidth
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamInnerFactor() const
 {
-    return m_cached_characteristic->getSlipstreamInnerFactor();
+    return m_cached_characteristic->getValues().m_slipstream_inner_factor;
 }  // getSlipstreamInnerFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMinCollectTime() const
 {
-    return m_cached_characteristic->getSlipstreamMinCollectTime();
+    return m_cached_characteristic->getValues().m_slipstream_min_collect_time;
 }  // getSlipstreamMinCollectTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMaxCollectTime() const
 {
-    return m_cached_characteristic->getSlipstreamMaxCollectTime();
+    return m_cached_characteristic->getValues().m_slipstream_max_collect_time;
 }  // getSlipstreamMaxCollectTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamAddPower() const
 {
-    return m_cached_characteristic->getSlipstreamAddPower();
+    return m_cached_characteristic->getValues().m_slipstream_add_power;
 }  // getSlipstreamAddPower
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMinSpeed() const
 {
-    return m_cached_characteristic->getSlipstreamMinSpeed();
+    return m_cached_characteristic->getValues().m_slipstream_min_speed;
 }  // getSlipstreamMinSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getSlipstreamMaxSpeedIncrease();
+    return m_cached_characteristic->getValues().m_slipstream_max_speed_increase;
 }  // getSlipstreamMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamFadeOutTime() const
 {
-    return m_cached_characteristic->getSlipstreamFadeOutTime();
+    return m_cached_characteristic->getValues().m_slipstream_fade_out_time;
 }  // getSlipstreamFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidIncrease() const
 {
-    return m_cached_characteristic->getSkidIncrease();
+    return m_cached_characteristic->getValues().m_skid_increase;
 }  // getSkidIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidDecrease() const
 {
-    return m_cached_characteristic->getSkidDecrease();
+    return m_cached_characteristic->getValues().m_skid_decrease;
 }  // getSkidDecrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidMax() const
 {
-    return m_cached_characteristic->getSkidMax();
+    return m_cached_characteristic->getValues().m_skid_max;
 }  // getSkidMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidTimeTillMax() const
 {
-    return m_cached_characteristic->getSkidTimeTillMax();
+    return m_cached_characteristic->getValues().m_skid_time_till_max;
 }  // getSkidTimeTillMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidVisual() const
 {
-    return m_cached_characteristic->getSkidVisual();
+    return m_cached_characteristic->getValues().m_skid_visual;
 }  // getSkidVisual
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidVisualTime() const
 {
-    return m_cached_characteristic->getSkidVisualTime();
+    return m_cached_characteristic->getValues().m_skid_visual_time;
 }  // getSkidVisualTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidRevertVisualTime() const
 {
-    return m_cached_characteristic->getSkidRevertVisualTime();
+    return m_cached_characteristic->getValues().m_skid_revert_visual_time;
 }  // getSkidRevertVisualTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidMinSpeed() const
 {
-    return m_cached_characteristic->getSkidMinSpeed();
+    return m_cached_characteristic->getValues().m_skid_min_speed;
 }  // getSkidMinSpeed
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidTimeTillBonus() const
+const std::vector<float>& KartProperties::getSkidTimeTillBonus() const
 {
-    return m_cached_characteristic->getSkidTimeTillBonus();
+    return m_cached_characteristic->getValues().m_skid_time_till_bonus;
 }  // getSkidTimeTillBonus
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusSpeed() const
+const std::vector<float>& KartProperties::getSkidBonusSpeed() const
 {
-    return m_cached_characteristic->getSkidBonusSpeed();
+    return m_cached_characteristic->getValues().m_skid_bonus_speed;
 }  // getSkidBonusSpeed
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusTime() const
+const std::vector<float>& KartProperties::getSkidBonusTime() const
 {
-    return m_cached_characteristic->getSkidBonusTime();
+    return m_cached_characteristic->getValues().m_skid_bonus_time;
 }  // getSkidBonusTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusForce() const
+const std::vector<float>& KartProperties::getSkidBonusForce() const
 {
-    return m_cached_characteristic->getSkidBonusForce();
+    return m_cached_characteristic->getValues().m_skid_bonus_force;
 }  // getSkidBonusForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidPhysicalJumpTime() const
 {
-    return m_cached_characteristic->getSkidPhysicalJumpTime();
+    return m_cached_characteristic->getValues().m_skid_physical_jump_time;
 }  // getSkidPhysicalJumpTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidGraphicalJumpTime() const
 {
-    return m_cached_characteristic->getSkidGraphicalJumpTime();
+    return m_cached_characteristic->getValues().m_skid_graphical_jump_time;
 }  // getSkidGraphicalJumpTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidPostSkidRotateFactor() const
 {
-    return m_cached_characteristic->getSkidPostSkidRotateFactor();
+    return m_cached_characteristic->getValues().m_skid_post_skid_rotate_factor;
 }  // getSkidPostSkidRotateFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidReduceTurnMin() const
 {
-    return m_cached_characteristic->getSkidReduceTurnMin();
+    return m_cached_characteristic->getValues().m_skid_reduce_turn_min;
 }  // getSkidReduceTurnMin
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidReduceTurnMax() const
 {
-    return m_cached_characteristic->getSkidReduceTurnMax();
+    return m_cached_characteristic->getValues().m_skid_reduce_turn_max;
 }  // getSkidReduceTurnMax
 
 // ----------------------------------------------------------------------------
 bool KartProperties::getSkidEnabled() const
 {
-    return m_cached_characteristic->getSkidEnabled();
+    return m_cached_characteristic->getValues().m_skid_enabled;
 }  // getSkidEnabled
 
 
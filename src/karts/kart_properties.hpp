@@ -83,6 +83,10 @@ private:
      *  the kart_properties object is const. */
     mutable std::shared_ptr<KartModel> m_kart_model;
 
+    /** True if the meshes of m_kart_model are loaded. They are only loaded
+     *  when the kart is used in a race, see loadModels(). */
+    bool m_models_loaded;
+
     /** List of all groups the kart belongs to. */
     std::vector<std::string> m_groups;
 
@@ -212,6 +216,8 @@ public:
     void  getAllData        (const XMLNode * root);
     void  checkAllSet       (const std::string &filename);
     bool  isInGroup         (const std::string &group) const;
+    void  loadModels        ();
+    void  unloadModels      ();
     bool operator<(const KartProperties &other) const;
 
     // ------------------------------------------------------------------------
@@ -223,6 +229,7 @@ public:
      *  difficulty is missing, but it can be used e.g. for the kart stats widget.
      */
     const AbstractCharacteristic* getCombinedCharacteristic() const;
+    const InterpolationArray& getTurnAngleAtSpeed() const;
 
     // ------------------------------------------------------------------------
     /** Returns the material for the kart icons. */
@@ -239,6 +246,12 @@ public:
      *  should not be modified, not attachModel be called on it. */
     const KartModel& getMasterKartModel() const {return *m_kart_model;        }
     // ------------------------------------------------------------------------
+    /** Returns true if the meshes of the master kart model are loaded. */
+    bool areModelsLoaded() const { return m_models_loaded; }
+    // ------------------------------------------------------------------------
+    /** Returns true if a kart in a race uses the master kart model. */
+    bool isModelInUse() const { return m_kart_model.use_count() > 1; }
+    // ------------------------------------------------------------------------
     void setHatMeshName(const std::string &hat_name);
     // ------------------------------------------------------------------------
     core::stringw getName() const;
@@ -370,12 +383,12 @@ public:
     float getStabilityChassisAngularDamping() const;
     float getStabilityDownwardImpulseFactor() const;
     float getStabilityTrackConnectionAccel() const;
-    std::vector<float> getStabilityAngularFactor() const;
+    const std::vector<float>& getStabilityAngularFactor() const;
     float getStabilitySmoothFlyingImpulse() const;
 
-    InterpolationArray getTurnRadius() const;
+    const InterpolationArray& getTurnRadius() const;
     float getTurnTimeResetSteer() const;
-    InterpolationArray getTurnTimeFullSteer() const;
+    const InterpolationArray& getTurnTimeFullSteer() const;
 
     float getEnginePower() const;
     float getEngineMaxSpeed() const;
@@ -384,8 +397,8 @@ public:
     float getEngineBrakeTimeIncrease() const;
     float getEngineMaxSpeedReverseRatio() const;
 
-    std::vector<float> getGearSwitchRatio() const;
-    std::vector<float> getGearPowerIncrease() const;
+    const std::vector<float>& getGearSwitchRatio() const;
+    const std::vector<float>& getGearPowerIncrease() const;
 
     float getMass() const;
 
@@ -436,8 +449,8 @@ public:
     float getPlungerBandFadeOutTime() const;
     float getPlungerInFaceTime() const;
 
-    std::vector<float> getStartupTime() const;
-    std::vector<float> getStartupBoost() const;
+    const std::vector<float>& getStartupTime() const;
+    const std::vector<float>& getStartupBoost() const;
 
     float getRescueDuration() const;
     float getRescueVertOffset() const;
@@ -477,10 +490,10 @@ public:
     float getSkidVisualTime() const;
     float getSkidRevertVisualTime() const;
     float getSkidMinSpeed() const;
-    std::vector<float> getSkidTimeTillBonus() const;
-    std::vector<float> getSkidBonusSpeed() const;
-    std::vector<float> getSkidBonusTime() const;
-    std::vector<float> getSkidBonusForce() const;
+    const std::vector<float>& getSkidTimeTillBonus() const;
+    const std::vector<float>& getSkidBonusSpeed() const;
+    const std::vector<float>& getSkidBonusTime() const;
+    const std::vector<float>& getSkidBonusForce() const;
     float getSkidPhysicalJumpTime() const;
     float getSkidGraphicalJumpTime() const;
     float getSkidPostSkidRotateFactor() const;
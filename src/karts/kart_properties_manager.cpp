@@ -37,11 +37,13 @@
 KartPropertiesManager *kart_properties_manager=0;
 
 std::vector<std::string> KartPropertiesManager::m_kart_search_path;
+unsigned int KartPropertiesManager::m_max_loaded_models = 16;
 
 /** Constructor, only clears internal data structures. */
 KartPropertiesManager::KartPropertiesManager()
 {
     m_all_groups.clear();
+    m_model_use_counter = 0;
 }   // KartPropertiesManager
 
 //-----------------------------------------------------------------------------
@@ -74,6 +76,7 @@ void KartPropertiesManager::addKartSearchDir(const std::string &s)
  */
 void KartPropertiesManager::unloadAllKarts()
 {
+    m_model_last_used.clear();
     m_karts_properties.clearAndDeleteAll();
     m_selected_karts.clear();
     m_kart_available.clear();
@@ -90,6 +93,7 @@ void KartPropertiesManager::removeKart(const std::string &ident)
     // Remove the kart properties from the vector of all kart properties
     int index = getKartId(ident);
     const KartProperties *kp = getKart(ident);  // must be done before remove
+    m_model_last_used.erase(ident);
     m_karts_properties.remove(index);
     m_all_kart_dirs.erase(m_all_kart_dirs.begin()+index);
     m_kart_available.erase(m_kart_available.begin()+index);
@@ -145,7 +149,8 @@ void KartPropertiesManager::removeKart(const std::string &ident)
 }   // removeKart
 
 //-----------------------------------------------------------------------------
-/** Loads all kart properties and models.
+/** Loads the properties of all karts. The models of a kart are only loaded
+ *  once it is used in a race, see loadKartModels().
  */
 void KartPropertiesManager::loadAllKarts(bool loading_icon)
 {
@@ -287,6 +292,73 @@ void KartPropertiesManager::setHatMeshName(const std::string &hat_name)
     }
 }   // setHatMeshName
 
+//-----------------------------------------------------------------------------
+/** Loads the models of the given karts, which is done before the karts of a
+ *  race are created. Afterwards the models of the least recently used karts
+ *  are unloaded until at most getMaxLoadedModels() karts have loaded models.
+ *  Models used by a race or requested here are never unloaded, so more
+ *  models can be loaded temporarily.
+ *  \param idents The identifiers of the karts.
+ */
+void KartPropertiesManager::loadKartModels(const std::vector<std::string> &idents)
+{
+    std::lock_guard<std::mutex> lock(m_model_mutex);
+    for (KartProperties *kp : m_karts_properties)
+    {
+        if (std::find(idents.begin(), idents.end(), kp->getIdent()) ==
+            idents.end())
+            continue;
+        kp->loadModels();
+        m_model_last_used[kp->getIdent()] = ++m_model_use_counter;
+    }
+    evictKartModels(idents);
+}   // loadKartModels
+
+//-----------------------------------------------------------------------------
+/** Unloads the models of the least recently used karts that are not used by
+ *  a race until at most m_max_loaded_models karts have loaded models. Must
+ *  be called with m_model_mutex locked.
+ *  \param keep Karts whose models must not be unloaded.
+ */
+void KartPropertiesManager::evictKartModels(const std::vector<std::string> &keep)
+{
+    while (m_model_last_used.size() > m_max_loaded_models)
+    {
+        auto oldest = m_model_last_used.end();
+        for (auto it = m_model_last_used.begin();
+             it != m_model_last_used.end(); it++)
+        {
+            if (std::find(keep.begin(), keep.end(), it->first) != keep.end() ||
+                getKart(it->first)->isModelInUse())
+                continue;
+            if (oldest == m_model_last_used.end() ||
+                it->second < oldest->second)
+                oldest = it;
+        }
+        if (oldest == m_model_last_used.end())
+            return;
+        m_karts_properties[getKartId(oldest->first)].unloadModels();
+        m_model_last_used.erase(oldest);
+    }
+}   // evictKartModels
+
+//-----------------------------------------------------------------------------
+/** Sets the maximum number of karts whose models stay loaded while no race
+ *  uses them, and unloads models if there are more. 0 unloads the models of
+ *  a kart as soon as a new race starts without it.
+ */
+void KartPropertiesManager::setMaxLoadedModels(unsigned int n)
+{
+    if (!kart_properties_manager)
+    {
+        m_max_loaded_models = n;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(kart_properties_manager->m_model_mutex);
+    m_max_loaded_models = n;
+    kart_properties_manager->evictKartModels(std::vector<std::string>());
+}   // setMaxLoadedModels
+
 //-----------------------------------------------------------------------------
 const AbstractCharacteristic* KartPropertiesManager::getDifficultyCharacteristic(const std::string &type) const
 {
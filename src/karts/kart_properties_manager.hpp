@@ -23,6 +23,7 @@
 #include "utils/ptr_vector.hpp"
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "network/remote_kart_info.hpp"
 #include "utils/no_copy.hpp"
@@ -69,6 +70,23 @@ private:
     std::map<std::string, std::unique_ptr<AbstractCharacteristic> > m_kart_type_characteristics;
     std::map<std::string, std::unique_ptr<AbstractCharacteristic> > m_player_characteristics;
 
+    /** For each kart with loaded models the value of m_model_use_counter
+     *  when it was last used, to find the least recently used models. */
+    std::map<std::string, unsigned long> m_model_last_used;
+
+    /** Counter used to find the least recently used kart models. */
+    unsigned long m_model_use_counter;
+
+    /** Protects the loaded models, races in different slots can start at
+     *  the same time. */
+    std::mutex m_model_mutex;
+
+    /** Maximum number of karts whose models stay loaded while no race uses
+     *  them. */
+    static unsigned int m_max_loaded_models;
+
+    void evictKartModels(const std::vector<std::string> &keep);
+
 protected:
 
     typedef PtrVector<KartProperties> KartPropertiesVector;
@@ -101,6 +119,11 @@ public:
                                            RemoteKartInfoList* existing_karts,
                                            std::vector<std::string> *ai_list);
     void                     setHatMeshName(const std::string &hat_name);
+    void                     loadKartModels(const std::vector<std::string> &idents);
+    static void              setMaxLoadedModels(unsigned int n);
+    // ------------------------------------------------------------------------
+    /** Returns the maximum number of karts whose models stay loaded. */
+    static unsigned int getMaxLoadedModels() { return m_max_loaded_models; }
     // ------------------------------------------------------------------------
     /** Get the characteristic that holds the base values. */
     const AbstractCharacteristic* getBaseCharacteristic() const { return m_base_characteristic.get(); }
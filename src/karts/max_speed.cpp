@@ -22,6 +22,7 @@
 #include "karts/abstract_kart.hpp"
 #include "karts/kart_properties.hpp"
 #include "utils/log.hpp"
+#include "utils/state_buffer.hpp"
 
 #include "physics/btKart.hpp"
 
@@ -84,6 +85,32 @@ void MaxSpeed::reset()
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves all speed increase and decrease categories. */
+void MaxSpeed::saveState(StateBuffer *buffer) const
+{
+    buffer->add<float>(m_current_max_speed);
+    buffer->add<float>(m_add_engine_force);
+    buffer->add<float>(m_min_speed);
+    for (unsigned int i = MS_DECREASE_MIN; i < MS_DECREASE_MAX; i++)
+        buffer->add<SpeedDecrease>(m_speed_decrease[i]);
+    for (unsigned int i = MS_INCREASE_MIN; i < MS_INCREASE_MAX; i++)
+        buffer->add<SpeedIncrease>(m_speed_increase[i]);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void MaxSpeed::restoreState(StateBuffer *buffer)
+{
+    m_current_max_speed = buffer->get<float>();
+    m_add_engine_force  = buffer->get<float>();
+    m_min_speed         = buffer->get<float>();
+    for (unsigned int i = MS_DECREASE_MIN; i < MS_DECREASE_MAX; i++)
+        m_speed_decrease[i] = buffer->get<SpeedDecrease>();
+    for (unsigned int i = MS_INCREASE_MIN; i < MS_INCREASE_MAX; i++)
+        m_speed_increase[i] = buffer->get<SpeedIncrease>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Sets an increased maximum speed for a category.
  *  \param category The category for which to set the higher maximum speed.
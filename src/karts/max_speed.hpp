@@ -25,6 +25,7 @@
 /** \defgroup karts */
 
 class AbstractKart;
+class StateBuffer;
 
 class MaxSpeed
 {
@@ -193,6 +194,8 @@ public:
     int   isSpeedDecreaseActive(unsigned int category);
     void  update(int ticks);
     void  reset();
+    void  saveState(StateBuffer *buffer) const;
+    void  restoreState(StateBuffer *buffer);
     // ------------------------------------------------------------------------
     /** Sets the minimum speed a kart should have. This is used to guarantee
      *  that e.g. zippers on ramps will always fast enough for the karts to
@@ -26,6 +26,7 @@
 #include "graphics/material_manager.hpp"
 #include "modes/world.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 
 #include "ISceneNode.h"
 
@@ -200,3 +201,67 @@ void Moveable::setTrans(const btTransform &t)
     if(m_motion_state)
         m_motion_state->setWorldTransform(t);
 }   // setTrans
+
+//-----------------------------------------------------------------------------
+/** Saves the state of the physical body: the transforms of the body, of its
+ *  motion state and of this moveable (which differ between a physics step
+ *  and the next update()), the velocities, gravity and the activation
+ *  (sleeping) state. All values are stored exactly, so a restored body
+ *  follows the same trajectory as the saved one. Bullet's contact caches
+ *  (the overlapping pairs and the contact points used to warm start the
+ *  solver) are not saved, a body that is in contact with another one when
+ *  saved may therefore move slightly differently after a restore.
+ *  \param buffer The buffer to append the state to.
+ */
+void Moveable::saveBodyState(StateBuffer *buffer) const
+{
+    btTransform motion_state_transform = m_transform;
+    if (m_motion_state)
+        m_motion_state->getWorldTransform(motion_state_transform);
+    buffer->addTransform(m_body->getWorldTransform());
+    buffer->addTransform(m_body->getInterpolationWorldTransform());
+    buffer->addTransform(motion_state_transform);
+    buffer->addTransform(m_transform);
+    buffer->addVec3(m_body->getLinearVelocity());
+    buffer->addVec3(m_body->getAngularVelocity());
+    buffer->addVec3(m_body->getInterpolationLinearVelocity());
+    buffer->addVec3(m_body->getInterpolationAngularVelocity());
+    buffer->addVec3(m_body->getGravity());
+    buffer->add<int>(m_body->getActivationState());
+    buffer->add<float>(m_body->getDeactivationTime());
+}   // saveBodyState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveBodyState(). This works whether or not
+ *  the body is currently part of the physics world.
+ *  \param buffer The buffer to read the state from.
+ */
+void Moveable::restoreBodyState(StateBuffer *buffer)
+{
+    btTransform world_transform         = buffer->getTransform();
+    btTransform interpolation_transform = buffer->getTransform();
+    btTransform motion_state_transform  = buffer->getTransform();
+    btTransform transform               = buffer->getTransform();
+    btVector3 linear_velocity                = buffer->getVec3();
+    btVector3 angular_velocity               = buffer->getVec3();
+    btVector3 interpolation_linear_velocity  = buffer->getVec3();
+    btVector3 interpolation_angular_velocity = buffer->getVec3();
+    btVector3 gravity                        = buffer->getVec3();
+    int activation_state                     = buffer->get<int>();
+    float deactivation_time                  = buffer->get<float>();
+    m_body->setWorldTransform(world_transform);
+    m_body->setInterpolationWorldTransform(interpolation_transform);
+    m_body->setLinearVelocity(linear_velocity);
+    m_body->setAngularVelocity(angular_velocity);
+    m_body->setInterpolationLinearVelocity(interpolation_linear_velocity);
+    m_body->setInterpolationAngularVelocity(interpolation_angular_velocity);
+    m_body->setGravity(gravity);
+    m_body->clearForces();
+    m_body->forceActivationState(activation_state);
+    m_body->setDeactivationTime(deactivation_time);
+    if (m_motion_state)
+        m_motion_state->setWorldTransform(motion_state_transform);
+    m_transform = transform;
+    m_velocityLC = linear_velocity * m_transform.getBasis();
+    updatePosition();
+}   // restoreBodyState
@@ -36,6 +36,7 @@ using namespace irr;
 #include <string>
 
 class Material;
+class StateBuffer;
 
 /**
   * \ingroup karts
@@ -123,6 +124,8 @@ public:
                  &getTrans() const {return m_transform;}
     void          setTrans(const btTransform& t);
     void          updatePosition();
+    void          saveBodyState(StateBuffer *buffer) const;
+    void          restoreBodyState(StateBuffer *buffer);
     // ------------------------------------------------------------------------
     /** Called once per rendered frame. It is used to only update any graphical
      *  effects.
@@ -25,6 +25,7 @@
 #include "modes/follow_the_leader.hpp"
 #include "modes/three_strikes_battle.hpp"
 #include "utils/mini_glm.hpp"
+#include "utils/state_buffer.hpp"
 
 #include "ISceneNode.h"
 
@@ -95,6 +96,27 @@ RescueAnimation::RescueAnimation(AbstractKart* kart, bool is_auto_rescue)
         resetPowerUp();
 }   // RescueAnimation
 
+//-----------------------------------------------------------------------------
+/** Restores a rescue animation written by saveState(). Unlike the other
+ *  constructor this does not move the kart, count a hit, change the clock
+ *  in follow the leader or clear attachments and powerups: these effects
+ *  are already part of the saved state.
+ *  \param kart Pointer to the kart which is animated.
+ *  \param buffer The buffer to read the state from.
+ */
+RescueAnimation::RescueAnimation(AbstractKart* kart, StateBuffer* buffer)
+               : AbstractKartAnimation(kart, "RescueAnimation", buffer)
+{
+    m_referee = NULL;
+    const int end_ticks = m_end_ticks;
+    btTransform rescue_transform = buffer->getTransform();
+    float velocity = buffer->get<float>();
+    MiniGLM::compressbtTransform(rescue_transform,
+        m_rescue_transform_compressed);
+    init(rescue_transform, velocity);
+    m_end_ticks = end_ticks;
+}   // RescueAnimation
+
 //-----------------------------------------------------------------------------
 /* When rescue transform and velocity is known, setting up the rest of data.
  * It is also used for each restoreState to make sure animation end in correct
@@ -111,6 +133,15 @@ void RescueAnimation::init(const btTransform& rescue_transform,
 }   // init
 
 //-----------------------------------------------------------------------------
+/** Saves the state read by the state constructor. */
+void RescueAnimation::saveState(StateBuffer *buffer) const
+{
+    AbstractKartAnimation::saveState(buffer);
+    buffer->addTransform(m_rescue_transform);
+    buffer->add<float>(m_velocity);
+}   // saveState
+
+// ----------------------------------------------------------------------------
 /** This object is automatically destroyed when the timer expires.
  */
 RescueAnimation::~RescueAnimation()
@@ -31,6 +31,7 @@ class Referee;
 class RescueAnimation: public AbstractKartAnimation
 {
 protected:
+friend class Kart;
     /** The velocity with which the kart is moved. */
     float m_velocity;
 
@@ -50,6 +51,8 @@ protected:
     // ------------------------------------------------------------------------
     RescueAnimation(AbstractKart* kart, bool is_auto_rescue);
     // ------------------------------------------------------------------------
+    RescueAnimation(AbstractKart* kart, StateBuffer* buffer);
+    // ------------------------------------------------------------------------
     void init(const btTransform& rescue_transform, float velocity);
 public:
     // ------------------------------------------------------------------------
@@ -62,6 +65,8 @@ public:
     // ------------------------------------------------------------------------
     virtual void updateGraphics(float dt);
     // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const;
+    // ------------------------------------------------------------------------
     virtual KartAnimationType getAnimationType() const   { return KAT_RESCUE; }
 };   // RescueAnimation
 #endif
@@ -31,6 +31,7 @@
 #include "physics/btKart.hpp"
 #include "tracks/track.hpp"
 #include "utils/log.hpp"
+#include "utils/state_buffer.hpp"
 
 /** Constructor of the skidding object.
  */
@@ -86,6 +87,38 @@ void Skidding::reset()
     m_kart->getVehicle()->setTimedRotation(0, 0);
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the skidding state. The timed rotation is part of btKart and saved
+ *  there.
+ */
+void Skidding::saveState(StateBuffer *buffer) const
+{
+    buffer->add<uint16_t>(m_skid_time);
+    buffer->add<SkidState>(m_skid_state);
+    buffer->add<float>(m_skid_factor);
+    buffer->add<float>(m_real_steering);
+    buffer->add<float>(m_visual_rotation);
+    buffer->add<bool>(m_skid_bonus_ready);
+    buffer->add<float>(m_remaining_jump_time);
+    buffer->add<int>(m_skid_bonus_end_ticks);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void Skidding::restoreState(StateBuffer *buffer)
+{
+    m_skid_time            = buffer->get<uint16_t>();
+    m_skid_state           = buffer->get<SkidState>();
+    m_skid_factor          = buffer->get<float>();
+    m_real_steering        = buffer->get<float>();
+    m_visual_rotation      = buffer->get<float>();
+    m_skid_bonus_ready     = buffer->get<bool>();
+    m_remaining_jump_time  = buffer->get<float>();
+    m_skid_bonus_end_ticks = buffer->get<int>();
+    m_prev_visual_rotation = m_visual_rotation;
+    m_smoothing_dt         = -1.0f;
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Computes the actual steering fraction to be used in the physics, and
  *  stores it in m_real_skidding. This is later used by kart to set the
@@ -26,6 +26,7 @@
 
 class Kart;
 class ShowCurve;
+class StateBuffer;
 
 #include <vector>
 
@@ -106,6 +107,8 @@ public:
          Skidding(Kart *kart);
         ~Skidding();
     void reset();
+    void saveState(StateBuffer *buffer) const;
+    void restoreState(StateBuffer *buffer);
     float updateGraphics(float dt);
     void update(int dt, bool is_on_ground, float steer,
                 KartControl::SkidControl skidding);
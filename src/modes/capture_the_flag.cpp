@@ -28,6 +28,7 @@
 #include "physics/triangle_mesh.hpp"
 #include "tracks/track.hpp"
 #include "tracks/track_object_manager.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <algorithm>
@@ -130,6 +131,49 @@ void CaptureTheFlag::reset(bool restart)
     m_blue_flag->resetToBase();
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the team scores and both flags in addition to the free for all
+ *  state.
+ */
+void CaptureTheFlag::saveState(StateBuffer *buffer) const
+{
+    FreeForAll::saveState(buffer);
+    buffer->add<int>(m_red_scores);
+    buffer->add<int>(m_blue_scores);
+    buffer->add<int>(m_last_captured_flag_ticks);
+    buffer->add<int>(m_red_flag_status);
+    buffer->add<int>(m_blue_flag_status);
+    buffer->add<uint32_t>((uint32_t)m_swatter_reset_kart_ticks.size());
+    for (auto &reset_ticks : m_swatter_reset_kart_ticks)
+    {
+        buffer->add<int>(reset_ticks.first);
+        buffer->add<int>(reset_ticks.second);
+    }
+    m_red_flag->saveState(buffer);
+    m_blue_flag->saveState(buffer);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void CaptureTheFlag::restoreState(StateBuffer *buffer)
+{
+    FreeForAll::restoreState(buffer);
+    m_red_scores               = buffer->get<int>();
+    m_blue_scores              = buffer->get<int>();
+    m_last_captured_flag_ticks = buffer->get<int>();
+    m_red_flag_status          = buffer->get<int>();
+    m_blue_flag_status         = buffer->get<int>();
+    m_swatter_reset_kart_ticks.clear();
+    unsigned int count = buffer->get<uint32_t>();
+    for (unsigned int i = 0; i < count; i++)
+    {
+        int kart_id = buffer->get<int>();
+        m_swatter_reset_kart_ticks[kart_id] = buffer->get<int>();
+    }
+    m_red_flag->restoreState(buffer);
+    m_blue_flag->restoreState(buffer);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 void CaptureTheFlag::updateGraphics(float dt)
 {
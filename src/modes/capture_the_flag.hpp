@@ -79,6 +79,10 @@ public:
     // ------------------------------------------------------------------------
     virtual void reset(bool restart=false) OVERRIDE;
     // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
+    // ------------------------------------------------------------------------
     virtual void update(int ticks) OVERRIDE;
     // ------------------------------------------------------------------------
     virtual void updateGraphics(float dt) OVERRIDE;
@@ -23,8 +23,10 @@
 #include "modes/world.hpp"
 
 #include "utils/mini_glm.hpp"
+#include "utils/state_buffer.hpp"
 
 #include "LinearMath/btQuaternion.h"
+#include <ISceneManager.h>
 
 // ============================================================================
 // Position offset to attach in kart model
@@ -67,6 +69,30 @@ void CTFFlag::update(int ticks)
     }
 }   // update
 
+// ----------------------------------------------------------------------------
+/** Saves the status, transformation and timers of this flag. */
+void CTFFlag::saveState(StateBuffer *buffer) const
+{
+    buffer->add<int8_t>(m_flag_status);
+    buffer->addTransform(m_flag_trans);
+    buffer->add<uint16_t>(m_ticks_since_off_base);
+    for (int i = 0; i < 4; i++)
+        buffer->add<int>(m_off_base_compressed[i]);
+    buffer->add<uint16_t>(m_deactivated_ticks);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void CTFFlag::restoreState(StateBuffer *buffer)
+{
+    m_flag_status          = buffer->get<int8_t>();
+    m_flag_trans           = buffer->getTransform();
+    m_ticks_since_off_base = buffer->get<uint16_t>();
+    for (int i = 0; i < 4; i++)
+        m_off_base_compressed[i] = buffer->get<int>();
+    m_deactivated_ticks    = buffer->get<uint16_t>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 void CTFFlag::updateFlagGraphics(irr::scene::IAnimatedMeshSceneNode* flag_node)
 {
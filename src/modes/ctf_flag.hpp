@@ -32,6 +32,7 @@ enum FlagColor : unsigned int
 };
 
 class RenderInfo;
+class StateBuffer;
 
 namespace irr
 {
@@ -132,6 +133,10 @@ public:
     // ------------------------------------------------------------------------
     void update(int ticks);
     // ------------------------------------------------------------------------
+    void saveState(StateBuffer *buffer) const;
+    // ------------------------------------------------------------------------
+    void restoreState(StateBuffer *buffer);
+    // ------------------------------------------------------------------------
     void updateFlagTrans(const btTransform& off_base_trans = btTransform());
     // ------------------------------------------------------------------------
     void updateFlagGraphics(irr::scene::IAnimatedMeshSceneNode* flag_node);
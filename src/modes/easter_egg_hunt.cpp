@@ -21,6 +21,7 @@
 #include "items/item.hpp"
 #include "karts/abstract_kart.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 //-----------------------------------------------------------------------------
@@ -183,6 +184,30 @@ void EasterEggHunt::reset(bool restart)
     m_finish_time = 0;
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the number of eggs found in addition to the state of the linear
+ *  world. The eggs themselves are items and saved by the item manager.
+ */
+void EasterEggHunt::saveState(StateBuffer *buffer) const
+{
+    LinearWorld::saveState(buffer);
+    for (int eggs : m_eggs_collected)
+        buffer->add<int>(eggs);
+    buffer->add<int>(m_eggs_found);
+    buffer->add<float>(m_finish_time);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void EasterEggHunt::restoreState(StateBuffer *buffer)
+{
+    LinearWorld::restoreState(buffer);
+    for (unsigned int i = 0; i < m_eggs_collected.size(); i++)
+        m_eggs_collected[i] = buffer->get<int>();
+    m_eggs_found  = buffer->get<int>();
+    m_finish_time = buffer->get<float>();
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Override the base class method to change behavior. We don't want wrong
  *  direction messages in the easter egg mode since there is no direction there.
@@ -54,6 +54,8 @@ public:
 
     // overriding World methods
     virtual void reset(bool restart=false) OVERRIDE;
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
 
     virtual bool raceHasLaps() OVERRIDE { return false; }
 
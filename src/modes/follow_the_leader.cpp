@@ -23,6 +23,7 @@
 #include "karts/abstract_kart.hpp"
 #include "karts/controller/controller.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <ISceneManager.h>
@@ -85,6 +86,32 @@ void FollowTheLeaderRace::reset(bool restart)
     m_is_over_delay = 2.0f;
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the remaining elimination intervals in addition to the state of
+ *  the linear world.
+ */
+void FollowTheLeaderRace::saveState(StateBuffer *buffer) const
+{
+    LinearWorld::saveState(buffer);
+    buffer->add<uint32_t>((uint32_t)m_leader_intervals.size());
+    for (float interval : m_leader_intervals)
+        buffer->add<float>(interval);
+    buffer->add<float>(m_is_over_delay);
+    buffer->add<float>(m_last_eliminated_time);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void FollowTheLeaderRace::restoreState(StateBuffer *buffer)
+{
+    LinearWorld::restoreState(buffer);
+    m_leader_intervals.resize(buffer->get<uint32_t>());
+    for (unsigned int i = 0; i < m_leader_intervals.size(); i++)
+        m_leader_intervals[i] = buffer->get<float>();
+    m_is_over_delay        = buffer->get<float>();
+    m_last_eliminated_time = buffer->get<float>();
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Returns the number of points for a kart at a specified position.
  *  \param p Position (starting with 1).
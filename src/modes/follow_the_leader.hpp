@@ -47,6 +47,8 @@ public:
 
     // overriding World methods
     virtual void reset(bool restart=false) OVERRIDE;
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
     virtual const std::string& getIdent() const OVERRIDE;
     virtual const btTransform &getStartTransform(int index) OVERRIDE;
     virtual void init() OVERRIDE;
@@ -20,6 +20,7 @@
 #include "karts/controller/controller.hpp"
 
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <algorithm>
@@ -56,6 +57,28 @@ void FreeForAll::reset(bool restart)
     m_scores.resize(m_karts.size(), 0);
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the scores of all karts in addition to the state of the ranked
+ *  world.
+ */
+void FreeForAll::saveState(StateBuffer *buffer) const
+{
+    WorldWithRank::saveState(buffer);
+    buffer->add<bool>(m_count_down_reached_zero);
+    for (int score : m_scores)
+        buffer->add<int>(score);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void FreeForAll::restoreState(StateBuffer *buffer)
+{
+    WorldWithRank::restoreState(buffer);
+    m_count_down_reached_zero = buffer->get<bool>();
+    for (unsigned int i = 0; i < m_scores.size(); i++)
+        m_scores[i] = buffer->get<int>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Called when the match time ends.
  */
@@ -48,6 +48,10 @@ public:
     // ------------------------------------------------------------------------
     virtual void reset(bool restart=false) OVERRIDE;
     // ------------------------------------------------------------------------
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
+    // ------------------------------------------------------------------------
     virtual bool raceHasLaps() OVERRIDE                       { return false; }
     // ------------------------------------------------------------------------
     virtual const std::string& getIdent() const OVERRIDE;
@@ -31,6 +31,7 @@
 #include "tracks/track_sector.hpp"
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <climits>
@@ -136,6 +137,32 @@ void LinearWorld::reset(bool restart)
 
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the lap information of all karts in addition to the state of the
+ *  ranked world.
+ */
+void LinearWorld::saveState(StateBuffer *buffer) const
+{
+    WorldWithRank::saveState(buffer);
+    buffer->add<int>(m_fastest_lap_ticks);
+    buffer->addString(StringUtils::wideToUtf8(m_fastest_lap_kart_name));
+    buffer->add<float>(m_finish_timeout);
+    for (unsigned int i = 0; i < m_kart_info.size(); i++)
+        buffer->add<KartInfo>(m_kart_info[i]);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void LinearWorld::restoreState(StateBuffer *buffer)
+{
+    WorldWithRank::restoreState(buffer);
+    m_fastest_lap_ticks     = buffer->get<int>();
+    m_fastest_lap_kart_name = StringUtils::utf8ToWide(buffer->getString());
+    m_finish_timeout        = buffer->get<float>();
+    for (unsigned int i = 0; i < m_kart_info.size(); i++)
+        m_kart_info[i] = buffer->get<KartInfo>();
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** General update function called once per frame. This updates the kart
  *  sectors, which are then used to determine the kart positions.
@@ -128,6 +128,8 @@ public:
     virtual unsigned int getRescuePositionIndex(AbstractKart *kart) OVERRIDE;
     virtual btTransform getRescueTransform(unsigned int index) const OVERRIDE;
     virtual void  reset(bool restart=false) OVERRIDE;
+    virtual void  saveState(StateBuffer *buffer) const OVERRIDE;
+    virtual void  restoreState(StateBuffer *buffer) OVERRIDE;
     virtual void  newLap(unsigned int kart_index) OVERRIDE;
 
     // ------------------------------------------------------------------------
@@ -33,6 +33,7 @@
 #include "tracks/track_object_manager.hpp"
 #include "tracks/track_sector.hpp"
 #include "utils/constants.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <IMeshSceneNode.h>
@@ -356,6 +357,73 @@ void SoccerWorld::reset(bool restart)
         m_team_icon_draw_id[pos++] = id;
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the scorers, the goal and ball state in addition to the state of
+ *  the ranked world. The ball itself is saved with the track objects.
+ */
+void SoccerWorld::saveState(StateBuffer *buffer) const
+{
+    WorldWithRank::saveState(buffer);
+    buffer->add<bool>(m_count_down_reached_zero);
+    buffer->add<int>(m_ball_invalid_timer);
+    buffer->add<int>(m_ball_hitter);
+    buffer->add<float>(m_ball_heading);
+    buffer->add<int>(m_reset_ball_ticks);
+    buffer->add<int>(m_ticks_back_to_own_goal);
+    for (const btTransform &t : m_goal_transforms)
+        buffer->addTransform(t);
+    if (Track::getCurrentTrack()->hasNavMesh())
+        m_ball_track_sector->saveState(buffer);
+
+    for (const std::vector<ScorerData> *scorers :
+         { &m_red_scorers, &m_blue_scorers })
+    {
+        buffer->add<uint32_t>((uint32_t)scorers->size());
+        for (const ScorerData &sd : *scorers)
+        {
+            buffer->add<unsigned int>(sd.m_id);
+            buffer->add<bool>(sd.m_correct_goal);
+            buffer->add<float>(sd.m_time);
+            buffer->addString(sd.m_kart);
+            buffer->addString(StringUtils::wideToUtf8(sd.m_player));
+            buffer->addString(sd.m_country_code);
+            buffer->add<HandicapLevel>(sd.m_handicap_level);
+        }
+    }
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void SoccerWorld::restoreState(StateBuffer *buffer)
+{
+    WorldWithRank::restoreState(buffer);
+    m_count_down_reached_zero = buffer->get<bool>();
+    m_ball_invalid_timer      = buffer->get<int>();
+    m_ball_hitter             = buffer->get<int>();
+    m_ball_heading            = buffer->get<float>();
+    m_reset_ball_ticks        = buffer->get<int>();
+    m_ticks_back_to_own_goal  = buffer->get<int>();
+    for (btTransform &t : m_goal_transforms)
+        t = buffer->getTransform();
+    if (Track::getCurrentTrack()->hasNavMesh())
+        m_ball_track_sector->restoreState(buffer);
+
+    for (std::vector<ScorerData> *scorers : { &m_red_scorers, &m_blue_scorers })
+    {
+        scorers->resize(buffer->get<uint32_t>());
+        for (ScorerData &sd : *scorers)
+        {
+            sd.m_id             = buffer->get<unsigned int>();
+            sd.m_correct_goal   = buffer->get<bool>();
+            sd.m_time           = buffer->get<float>();
+            sd.m_kart           = buffer->getString();
+            sd.m_player         = StringUtils::utf8ToWide(buffer->getString());
+            sd.m_country_code   = buffer->getString();
+            sd.m_handicap_level = buffer->get<HandicapLevel>();
+        }
+    }
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 void SoccerWorld::onGo()
 {
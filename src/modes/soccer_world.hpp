@@ -138,6 +138,8 @@ public:
 
     // overriding World methods
     virtual void reset(bool restart=false) OVERRIDE;
+    virtual void saveState(StateBuffer *buffer) const OVERRIDE;
+    virtual void restoreState(StateBuffer *buffer) OVERRIDE;
 
     virtual unsigned int getRescuePositionIndex(AbstractKart *kart) OVERRIDE;
     virtual btTransform getRescueTransform(unsigned int rescue_pos) const
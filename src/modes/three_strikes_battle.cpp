@@ -33,6 +33,7 @@
 #include "tracks/track.hpp"
 #include "tracks/track_object_manager.hpp"
 #include "utils/constants.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 
 #include <algorithm>
@@ -164,6 +165,119 @@ void ThreeStrikesBattle::reset(bool restart)
     }
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the lives of all karts, the battle events, pending tires and the
+ *  spare tire karts in addition to the state of the ranked world. Tires
+ *  already lying on the track are not saved.
+ */
+void ThreeStrikesBattle::saveState(StateBuffer *buffer) const
+{
+    WorldWithRank::saveState(buffer);
+    for (const BattleInfo &info : m_kart_info)
+        buffer->add<BattleInfo>(info);
+
+    buffer->add<int>(m_insert_tire);
+    buffer->add<float>(m_tire_position.X);
+    buffer->add<float>(m_tire_position.Y);
+    buffer->add<float>(m_tire_position.Z);
+    for (int i = 0; i < 4; i++)
+    {
+        buffer->add<float>(m_tire_offsets[i].X);
+        buffer->add<float>(m_tire_offsets[i].Y);
+        buffer->add<float>(m_tire_offsets[i].Z);
+        buffer->add<float>(m_tire_radius[i]);
+    }
+    buffer->addString(m_tire_dir);
+    buffer->add<float>(m_tire_rotation);
+
+    buffer->add<int>(m_total_rescue);
+    buffer->add<int>(m_total_hit);
+    buffer->add<int>(m_next_sta_spawn_ticks);
+
+    buffer->add<uint32_t>((uint32_t)m_battle_events.size());
+    for (const BattleEvent &evt : m_battle_events)
+    {
+        buffer->add<float>(evt.m_time);
+        for (const BattleInfo &info : evt.m_kart_info)
+            buffer->add<BattleInfo>(info);
+    }
+
+    for (AbstractKart *kart : m_spare_tire_karts)
+    {
+        SpareTireAI* sta = dynamic_cast<SpareTireAI*>(kart->getController());
+        assert(sta);
+        sta->saveState(buffer);
+    }
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). Tires lying on the track are
+ *  removed.
+ */
+void ThreeStrikesBattle::restoreState(StateBuffer *buffer)
+{
+    WorldWithRank::restoreState(buffer);
+    for (unsigned int i = 0; i < m_kart_info.size(); i++)
+        m_kart_info[i] = buffer->get<BattleInfo>();
+
+    m_insert_tire = buffer->get<int>();
+    m_tire_position.X = buffer->get<float>();
+    m_tire_position.Y = buffer->get<float>();
+    m_tire_position.Z = buffer->get<float>();
+    for (int i = 0; i < 4; i++)
+    {
+        m_tire_offsets[i].X = buffer->get<float>();
+        m_tire_offsets[i].Y = buffer->get<float>();
+        m_tire_offsets[i].Z = buffer->get<float>();
+        m_tire_radius[i]    = buffer->get<float>();
+    }
+    m_tire_dir      = buffer->getString();
+    m_tire_rotation = buffer->get<float>();
+
+    m_total_rescue         = buffer->get<int>();
+    m_total_hit            = buffer->get<int>();
+    m_next_sta_spawn_ticks = buffer->get<int>();
+
+    m_battle_events.resize(buffer->get<uint32_t>());
+    for (BattleEvent &evt : m_battle_events)
+    {
+        evt.m_time = buffer->get<float>();
+        evt.m_kart_info.resize(m_kart_info.size());
+        for (unsigned int i = 0; i < evt.m_kart_info.size(); i++)
+            evt.m_kart_info[i] = buffer->get<BattleInfo>();
+    }
+
+    for (AbstractKart *kart : m_spare_tire_karts)
+    {
+        SpareTireAI* sta = dynamic_cast<SpareTireAI*>(kart->getController());
+        assert(sta);
+        sta->restoreState(buffer);
+    }
+
+    TrackObject *obj;
+    for_in(obj, m_tires)
+    {
+        Track::getCurrentTrack()->getTrackObjectManager()->removeObject(obj);
+    }
+    m_tires.clearWithoutDeleting();
+
+    // Show the tires of each kart according to its lives
+    for (unsigned int n = 0; n < m_karts.size(); n++)
+    {
+        scene::ISceneNode* kart_node = m_karts[n]->getNode();
+        core::list<scene::ISceneNode*>& children = kart_node->getChildren();
+        for (core::list<scene::ISceneNode*>::Iterator it = children.begin();
+             it != children.end(); it++)
+        {
+            scene::ISceneNode* curr = *it;
+            if (core::stringc(curr->getName()) == "tire1")
+                curr->setVisible(m_kart_info[n].m_lives >= 3);
+            else if (core::stringc(curr->getName()) == "tire2")
+                curr->setVisible(m_kart_info[n].m_lives >= 2);
+        }
+    }
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Adds two tires to each of the kart. The tires are used to represent
  *  lifes.
@@ -629,6 +743,7 @@ void ThreeStrikesBattle::loadCustomModels()
                                                        &sta_list);
 
             assert(sta_list.size() == pos.size());
+            kart_properties_manager->loadKartModels(sta_list);
             // Now add them
             for (unsigned int i = 0; i < pos.size(); i++)
             {
@@ -28,6 +28,7 @@
 #include "graphics/render_info.hpp"
 #include "io/file_manager.hpp"
 #include "input/input.hpp"
+#include "items/item_manager.hpp"
 #include "items/projectile_manager.hpp"
 #include "karts/controller/battle_ai.hpp"
 #include "karts/controller/end_controller.hpp"
@@ -50,7 +51,10 @@
 #include "tracks/track_object_manager.hpp"
 #include "utils/constants.hpp"
 #include "utils/profiler.hpp"
+#include "utils/state_buffer.hpp"
+#include "utils/stk_process.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/thread_pool.hpp"
 
 #include <algorithm>
 #include <assert.h>
@@ -59,7 +63,7 @@
 #include <stdexcept>
 
 
-World* World::m_world[PT_COUNT];
+World* World::m_world[STK_MAX_PROCESS_SLOTS];
 
 /** The main world class is used to handle the track and the karts.
  *  The end of the race is detected in two phases: first the (abstract)
@@ -134,7 +138,9 @@ void World::init()
     // mode class, which would not have been constructed at the time that this
     // constructor is called, so the wrong race gui would be created.
     // Grab the track file
-    Track *track = track_manager->getTrack(RaceManager::get()->getTrackName());
+    Track *track = m_process_type == PT_MAIN ?
+        track_manager->getTrackForSlot(RaceManager::get()->getTrackName()) :
+        track_manager->getTrack(RaceManager::get()->getTrackName());
     if (m_process_type == PT_MAIN)
     {
         Scripting::ScriptEngine::getInstance<Scripting::ScriptEngine>();
@@ -154,6 +160,13 @@ void World::init()
     unsigned int num_karts = RaceManager::get()->getNumberOfKarts();
     //assert(num_karts > 0);
 
+    // Load the kart models before the track, so that the materials of the
+    // kart meshes are not looked up in the temporary track materials.
+    std::vector<std::string> kart_idents;
+    for (unsigned int i = 0; i < num_karts; i++)
+        kart_idents.push_back(RaceManager::get()->getKartIdent(i));
+    kart_properties_manager->loadKartModels(kart_idents);
+
     // Load the track models - this must be done before the karts so that the
     // karts can be positioned properly on (and not in) the tracks.
     // This also defines the static Track::getCurrentTrack function.
@@ -276,6 +289,53 @@ void World::reset(bool restart)
     m_unfair_team = false;
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the simulation state of the race: the clock, all karts, items,
+ *  projectiles, check structures, track objects and race results. Game
+ *  modes save their own state in addition. The state can only be restored
+ *  into the same world.
+ *  \param buffer The buffer to append the state to.
+ */
+void World::saveState(StateBuffer *buffer) const
+{
+    WorldStatus::saveState(buffer);
+    buffer->add<int>(m_eliminated_karts);
+    buffer->add<int>(m_eliminated_players);
+    buffer->add<uint32_t>((uint32_t)m_karts.size());
+    for (auto &kart : m_karts)
+        kart->saveState(buffer);
+    Track::getCurrentTrack()->getItemManager()->saveState(buffer);
+    ProjectileManager::get()->saveState(buffer);
+    Track::getCurrentTrack()->getCheckManager()->saveState(buffer);
+    Track::getCurrentTrack()->getTrackObjectManager()->saveState(buffer);
+    RaceManager::get()->saveState(buffer);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState().
+ *  \param buffer The buffer to read the state from.
+ */
+void World::restoreState(StateBuffer *buffer)
+{
+    WorldStatus::restoreState(buffer);
+    m_eliminated_karts   = buffer->get<int>();
+    m_eliminated_players = buffer->get<int>();
+    if (buffer->get<uint32_t>() != m_karts.size())
+        throw std::runtime_error("Saved state has a different number of "
+                                 "karts.");
+    // Remove projectiles first, so that their physics bodies do not
+    // interact with the restored karts.
+    ProjectileManager::get()->cleanup();
+    for (auto &kart : m_karts)
+        kart->restoreState(buffer);
+    Track::getCurrentTrack()->getItemManager()->restoreState(buffer);
+    ProjectileManager::get()->restoreState(buffer);
+    Track::getCurrentTrack()->getCheckManager()->restoreState(buffer);
+    Track::getCurrentTrack()->getTrackObjectManager()->restoreState(buffer);
+    RaceManager::get()->restoreState(buffer);
+    Physics::get()->getPhysicsWorld()->resetLocalTime();
+}   // restoreState
+
 
 //-----------------------------------------------------------------------------
 /** Creates a kart, having a certain position, starting location, and local
@@ -381,9 +441,13 @@ Controller* World::loadAIController(AbstractKart* kart)
 //-----------------------------------------------------------------------------
 World::~World()
 {
-    material_manager->unloadAllTextures();
+    // Other simulations in this process share the scene manager, renderer
+    // and material textures, only the last world may clean them up.
+    const bool shared_cleanup = !hasOtherWorld(m_process_slot);
+    if (shared_cleanup)
+        material_manager->unloadAllTextures();
 
-    if (m_process_type == PT_MAIN)
+    if (m_process_type == PT_MAIN && shared_cleanup)
         irr_driver->onUnloadWorld();
 
     ProjectileManager::get()->cleanup();
@@ -393,6 +457,7 @@ World::~World()
     {
         if(Track::getCurrentTrack())
             Track::getCurrentTrack()->cleanup();
+        track_manager->releaseSlotTrack();
     }
     else
         Track::cleanChildTrack();
@@ -412,9 +477,9 @@ World::~World()
     if (m_process_type == PT_MAIN)
         Scripting::ScriptEngine::kill();
 
-    m_world[m_process_type] = NULL;
+    m_world[m_process_slot] = NULL;
 
-    if (m_process_type == PT_MAIN)
+    if (m_process_type == PT_MAIN && shared_cleanup)
         irr_driver->getSceneManager()->clear();
 
 #ifdef DEBUG
@@ -699,12 +764,37 @@ void World::update(int ticks)
     Track::getCurrentTrack()->getTrackObjectManager()->update(stk_config->ticks2Time(ticks));
     PROFILER_POP_CPU_MARKER();
 
+    const int kart_amount = (int)m_karts.size();
+
+    PROFILER_PUSH_CPU_MARKER("World::update (AI decide)", 0x30, 0x7F, 0x00);
+    // Let the AI controllers prepare their update in parallel. They only
+    // read the world, which is not modified until all of them are done, so
+    // the result does not depend on the number of threads. The serial kart
+    // updates below then apply their decisions.
+    std::vector<Controller*> ai_controllers;
+    for (int i = 0 ; i < kart_amount; ++i)
+    {
+        Controller* controller = m_karts[i]->getController();
+        SpareTireAI* sta = dynamic_cast<SpareTireAI*>(controller);
+        if (!controller->isPlayerController() &&
+            (!m_karts[i]->isEliminated() || (sta && sta->isMoving())))
+            ai_controllers.push_back(controller);
+    }
+    const ProcessType process_type = STKProcess::getType();
+    const unsigned int process_slot = STKProcess::getSlot();
+    ThreadPool::get()->parallelFor((unsigned int)ai_controllers.size(),
+        [&](unsigned int i)
+        {
+            STKProcess::init(process_type, process_slot);
+            ai_controllers[i]->decide(ticks);
+        });
+    PROFILER_POP_CPU_MARKER();
+
     PROFILER_PUSH_CPU_MARKER("World::update (Kart::upate)", 0x40, 0x7F, 0x00);
 
     // Update all the karts. This in turn will also update the controller,
     // which causes all AI steering commands set. So in the following 
     // physics update the new steering is taken into account.
-    const int kart_amount = (int)m_karts.size();
     for (int i = 0 ; i < kart_amount; ++i)
     {
         SpareTireAI* sta =
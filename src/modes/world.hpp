@@ -87,7 +87,7 @@ public:
     typedef std::vector<std::shared_ptr<AbstractKart> > KartList;
 private:
     /** A pointer to the global world object for a race. */
-    static World *m_world[PT_COUNT];
+    static World *m_world[STK_MAX_PROCESS_SLOTS];
     // ------------------------------------------------------------------------
     void setAITeam();
     // ------------------------------------------------------------------------
@@ -174,8 +174,8 @@ public:
     /** Returns a pointer to the (singleton) world object. */
     static World*   getWorld()
     {
-        ProcessType type = STKProcess::getType();
-        return m_world[type];
+        unsigned int slot = STKProcess::getSlot();
+        return m_world[slot];
     }
     // ------------------------------------------------------------------------
     /** Delete the )singleton) world object, if it exists, and sets the
@@ -183,21 +183,33 @@ public:
       *  has been deleted already. */
     static void     deleteWorld()
     {
-        ProcessType type = STKProcess::getType();
-        delete m_world[type];
-        m_world[type] = NULL;
+        unsigned int slot = STKProcess::getSlot();
+        delete m_world[slot];
+        m_world[slot] = NULL;
     }
     // ------------------------------------------------------------------------
     /** Sets the pointer to the world object. This is only used by
      *  the race_manager.*/
     static void     setWorld(World *world)
     {
-        ProcessType type = STKProcess::getType();
-        m_world[type] = world;
+        unsigned int slot = STKProcess::getSlot();
+        m_world[slot] = world;
     }
     // ------------------------------------------------------------------------
     static void     clear() { memset(m_world, 0, sizeof(m_world)); }
     // ------------------------------------------------------------------------
+    /** Returns true if a simulation slot other than the given one still has
+     *  a world. Shared graphics state must not be torn down in this case. */
+    static bool     hasOtherWorld(unsigned int slot)
+    {
+        for (unsigned int i = 0; i < STK_MAX_PROCESS_SLOTS; i++)
+        {
+            if (i != slot && m_world[i])
+                return true;
+        }
+        return false;
+    }
+    // ------------------------------------------------------------------------
 
     // Pure virtual functions
     // ======================
@@ -237,6 +249,8 @@ public:
     virtual void    updateGraphics(float dt);
     virtual void    terminateRace() OVERRIDE;
     virtual void    reset(bool restart=false) OVERRIDE;
+    virtual void    saveState(StateBuffer *buffer) const OVERRIDE;
+    virtual void    restoreState(StateBuffer *buffer) OVERRIDE;
     virtual void    getDefaultCollectibles(int *collectible_type,
                                            int *amount );
     // ------------------------------------------------------------------------
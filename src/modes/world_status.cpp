@@ -22,12 +22,14 @@
 #include "karts/abstract_kart.hpp"
 #include "modes/world.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/stk_process.hpp"
 
 #include <irrlicht.h>
 
 //-----------------------------------------------------------------------------
-WorldStatus::WorldStatus() : m_process_type(STKProcess::getType())
+WorldStatus::WorldStatus() : m_process_type(STKProcess::getType()),
+                             m_process_slot(STKProcess::getSlot())
 {
     m_clock_mode        = CLOCK_CHRONO;
     m_phase             = SETUP_PHASE;
@@ -68,6 +70,30 @@ void WorldStatus::reset(bool restart)
     }
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the race clock and phase.
+ *  \param buffer The buffer to append the state to.
+ */
+void WorldStatus::saveState(StateBuffer *buffer) const
+{
+    buffer->add<double>(m_time);
+    buffer->add<int>(m_time_ticks);
+    buffer->add<Phase>(m_phase.load());
+    buffer->add<int>(m_count_up_ticks);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState().
+ *  \param buffer The buffer to read the state from.
+ */
+void WorldStatus::restoreState(StateBuffer *buffer)
+{
+    m_time           = buffer->get<double>();
+    m_time_ticks     = buffer->get<int>();
+    m_phase          = buffer->get<Phase>();
+    m_count_up_ticks = buffer->get<int>();
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Destructor of WorldStatus.
  */
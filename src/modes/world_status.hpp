@@ -22,6 +22,7 @@
 #include <atomic>
 
 enum ProcessType : unsigned int;
+class StateBuffer;
 
 /**
  * \brief A class that manages the clock (countdown, chrono, etc.)
@@ -72,6 +73,9 @@ protected:
 
     /** Process type of this world (main or child). */
     const ProcessType m_process_type;
+
+    /** Simulation slot this world was created in. */
+    const unsigned int m_process_slot;
 private:
     /** The clock mode: normal counting forwards, or countdown */ 
     ClockType       m_clock_mode;
@@ -88,6 +92,8 @@ public:
     virtual ~WorldStatus();
 
     virtual void reset(bool restart);
+    virtual void saveState(StateBuffer *buffer) const;
+    virtual void restoreState(StateBuffer *buffer);
     virtual void updateTime(int ticks);
     virtual void update(int ticks);
     void         startReadySetGo();
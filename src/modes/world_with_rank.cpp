@@ -25,6 +25,7 @@
 #include "tracks/track.hpp"
 #include "tracks/track_sector.hpp"
 #include "utils/log.hpp"
+#include "utils/state_buffer.hpp"
 
 #include <iostream>
 
@@ -73,6 +74,28 @@ void WorldWithRank::reset(bool restart)
     }
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the kart ranks and track sectors in addition to the world state. */
+void WorldWithRank::saveState(StateBuffer *buffer) const
+{
+    World::saveState(buffer);
+    for (unsigned int i = 0; i < m_position_index.size(); i++)
+        buffer->add<int>(m_position_index[i]);
+    for (unsigned int i = 0; i < m_kart_track_sector.size(); i++)
+        m_kart_track_sector[i]->saveState(buffer);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void WorldWithRank::restoreState(StateBuffer *buffer)
+{
+    World::restoreState(buffer);
+    for (unsigned int i = 0; i < m_position_index.size(); i++)
+        m_position_index[i] = buffer->get<int>();
+    for (unsigned int i = 0; i < m_kart_track_sector.size(); i++)
+        m_kart_track_sector[i]->restoreState(buffer);
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Returns the kart with a given position.
  *  \param p The position of the kart, 1<=p<=num_karts).
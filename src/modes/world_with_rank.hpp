@@ -75,6 +75,8 @@ public:
         results will be incorrect */
     virtual void  init() OVERRIDE;
     virtual void  reset(bool restart=false) OVERRIDE;
+    virtual void  saveState(StateBuffer *buffer) const OVERRIDE;
+    virtual void  restoreState(StateBuffer *buffer) OVERRIDE;
 
     bool          displayRank() const { return m_display_rank; }
 
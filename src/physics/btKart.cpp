@@ -29,6 +29,7 @@
 #include "physics/triangle_mesh.hpp"
 #include "tracks/terrain_info.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 
 #define ROLLING_INFLUENCE_FIX
 
@@ -124,6 +125,70 @@ void btKart::reset()
 
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the vehicle state that is not part of the chassis body, i.e. the
+ *  additional impulse and rotation and the per wheel state.
+ */
+void btKart::saveState(StateBuffer *buffer) const
+{
+    buffer->addVec3(m_additional_impulse);
+    buffer->add<uint16_t>(m_ticks_additional_impulse);
+    buffer->add<float>(m_additional_rotation);
+    buffer->add<uint16_t>(m_ticks_additional_rotation);
+    buffer->add<int>(m_num_wheels_on_ground);
+    buffer->add<bool>(m_allow_sliding);
+    buffer->add<bool>(m_visual_wheels_touch_ground);
+    buffer->add<float>(m_min_speed);
+    buffer->add<float>(m_max_speed);
+    for (int i = 0; i < getNumWheels(); i++)
+    {
+        const btWheelInfo &wheel = m_wheelInfo[i];
+        buffer->add<float>(wheel.m_steering);
+        buffer->add<float>(wheel.m_engineForce);
+        buffer->add<float>(wheel.m_brake);
+        buffer->add<float>(wheel.m_skidInfo);
+        buffer->add<float>(wheel.m_wheelsSuspensionForce);
+        buffer->add<float>(wheel.m_suspensionRelativeVelocity);
+        buffer->add<float>(wheel.m_raycastInfo.m_suspensionLength);
+        buffer->add<bool>(wheel.m_raycastInfo.m_isInContact);
+        buffer->addVec3(wheel.m_raycastInfo.m_contactPointWS);
+        buffer->addVec3(wheel.m_raycastInfo.m_contactNormalWS);
+    }
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). The chassis body must already
+ *  be at its restored position, since the wheel transforms are recomputed
+ *  from it.
+ */
+void btKart::restoreState(StateBuffer *buffer)
+{
+    m_additional_impulse        = buffer->getVec3();
+    m_ticks_additional_impulse  = buffer->get<uint16_t>();
+    m_additional_rotation       = buffer->get<float>();
+    m_ticks_additional_rotation = buffer->get<uint16_t>();
+    m_num_wheels_on_ground      = buffer->get<int>();
+    m_allow_sliding             = buffer->get<bool>();
+    m_visual_wheels_touch_ground = buffer->get<bool>();
+    m_min_speed                 = buffer->get<float>();
+    m_max_speed                 = buffer->get<float>();
+    for (int i = 0; i < getNumWheels(); i++)
+    {
+        btWheelInfo &wheel = m_wheelInfo[i];
+        wheel.m_steering                   = buffer->get<float>();
+        wheel.m_engineForce                = buffer->get<float>();
+        wheel.m_brake                      = buffer->get<float>();
+        wheel.m_skidInfo                   = buffer->get<float>();
+        wheel.m_wheelsSuspensionForce      = buffer->get<float>();
+        wheel.m_suspensionRelativeVelocity = buffer->get<float>();
+        wheel.m_raycastInfo.m_suspensionLength = buffer->get<float>();
+        updateWheelTransform(i, false);
+        wheel.m_raycastInfo.m_isInContact      = buffer->get<bool>();
+        wheel.m_raycastInfo.m_contactPointWS   = buffer->getVec3();
+        wheel.m_raycastInfo.m_contactNormalWS  = buffer->getVec3();
+    }
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 const btTransform& btKart::getWheelTransformWS( int wheelIndex ) const
 {
@@ -23,6 +23,7 @@ class btDynamicsWorld;
 
 class btVehicleTuning;
 class Kart;
+class StateBuffer;
 struct btWheelContactPoint;
 
 /** rayCast vehicle, very special constraint that turn a rigidbody into a
@@ -174,6 +175,8 @@ public:
     void               updateAllWheelPositions();
     void               getVisualContactPoint(const btTransform& chassis_trans,
                                              btVector3 *left, btVector3 *right);
+    void               saveState(StateBuffer *buffer) const;
+    void               restoreState(StateBuffer *buffer);
         // ------------------------------------------------------------------------
     /** Returns true if both rear visual wheels touch the ground. */
     bool visualWheelsTouchGround() const
@@ -33,6 +33,7 @@
 #include "tracks/track_object.hpp"
 #include "utils/constants.hpp"
 #include "utils/mini_glm.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/mini_glm.hpp"
 
@@ -163,8 +164,19 @@ PhysicalObject::PhysicalObject(bool is_dynamic,
     m_flatten_kart       = settings.m_flatten_kart;
     m_reset_when_too_low = settings.m_reset_when_too_low;
     m_reset_height       = settings.m_reset_height;
-    m_on_kart_collision  = settings.m_on_kart_collision;
-    m_on_item_collision  = settings.m_on_item_collision;
+    // Build the declarations once instead of on every collision
+    m_on_kart_collision.clear();
+    if (!settings.m_on_kart_collision.empty())
+    {
+        m_on_kart_collision = "void " + settings.m_on_kart_collision +
+                              "(int, const string, const string)";
+    }
+    m_on_item_collision.clear();
+    if (!settings.m_on_item_collision.empty())
+    {
+        m_on_item_collision = "void " + settings.m_on_item_collision +
+                              "(int, int, const string)";
+    }
     m_current_transform.setOrigin(Vec3());
     m_current_transform.setRotation(
         btQuaternion(0.0f, 0.0f, 0.0f, 1.0f));
@@ -640,6 +652,53 @@ void PhysicalObject::update(float dt)
 
 }   // update
 
+// ----------------------------------------------------------------------------
+/** Saves whether the body is part of the physics world and, for dynamic
+ *  objects, the transform and velocities of the body. Static and animated
+ *  objects are moved by their animation, which only depends on the world
+ *  time.
+ *  \param buffer The buffer to append the state to.
+ */
+void PhysicalObject::saveState(StateBuffer *buffer) const
+{
+    buffer->add<bool>(m_body_added);
+    if (!m_is_dynamic) return;
+
+    buffer->addTransform(m_body->getWorldTransform());
+    buffer->addVec3(m_body->getLinearVelocity());
+    buffer->addVec3(m_body->getAngularVelocity());
+    buffer->add<int>(m_body->getActivationState());
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState().
+ *  \param buffer The buffer to read the state from.
+ */
+void PhysicalObject::restoreState(StateBuffer *buffer)
+{
+    if (buffer->get<bool>())
+        addBody();
+    else
+        removeBody();
+    if (!m_is_dynamic) return;
+
+    btTransform t = buffer->getTransform();
+    Vec3 lv = buffer->getVec3();
+    Vec3 av = buffer->getVec3();
+    m_body->setCenterOfMassTransform(t);
+    m_motion_state->setWorldTransform(t);
+    m_body->setInterpolationWorldTransform(t);
+    m_body->setLinearVelocity(lv);
+    m_body->setAngularVelocity(av);
+    m_body->setInterpolationLinearVelocity(lv);
+    m_body->setInterpolationAngularVelocity(av);
+    m_body->forceActivationState(buffer->get<int>());
+    m_current_transform = t;
+    m_last_transform = t;
+    m_last_lv = lv;
+    m_last_av = av;
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Does a raycast against this physical object. The physical object must
  *  have an 'exact' shape, i.e. be a triangle mesh (for other physical objects
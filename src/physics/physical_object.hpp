@@ -29,6 +29,7 @@
 #include "utils/vec3.hpp"
 
 class Material;
+class StateBuffer;
 class TrackObject;
 class XMLNode;
 
@@ -169,11 +170,11 @@ private:
     /** If m_reset_when_too_low this object is set back to its start
      *  position if its height is below this value. */
     float                 m_reset_height;
-    /** If non-empty, the name of the scripting function to call
+    /** If non-empty, the declaration of the scripting function to call
     * when a kart collides with this object
     */
     std::string           m_on_kart_collision;
-    /** If non-empty, the name of the scripting function to call
+    /** If non-empty, the declaration of the scripting function to call
     * when a (flyable) item collides with this object
     */
     std::string           m_on_item_collision;
@@ -207,6 +208,8 @@ public:
     virtual void handleExplosion(const Vec3& pos, bool directHit);
     void         update         (float dt);
     void         updateGraphics (float dt);
+    void         saveState      (StateBuffer *buffer) const;
+    void         restoreState   (StateBuffer *buffer);
     void         init           (const Settings &settings);
     void         move           (const Vec3& xyz, const core::vector3df& hpr);
     void         hit            (const Material *m, const Vec3 &normal);
@@ -246,9 +249,15 @@ public:
     // ------------------------------------------------------------------------
     float getRadius() const { return m_radius; }
     // ------------------------------------------------------------------------
-    const std::string& getOnKartCollisionFunction() const { return m_on_kart_collision; }
+    /** Returns the declaration of the scripting function to call when a kart
+     *  collides with this object, or an empty string. */
+    const std::string& getOnKartCollisionDeclaration() const
+                                                { return m_on_kart_collision; }
     // ------------------------------------------------------------------------
-    const std::string& getOnItemCollisionFunction() const { return m_on_item_collision; }
+    /** Returns the declaration of the scripting function to call when an
+     *  item collides with this object, or an empty string. */
+    const std::string& getOnItemCollisionDeclaration() const
+                                                { return m_on_item_collision; }
     // ------------------------------------------------------------------------
     TrackObject* getTrackObject() { return m_object; }
 
@@ -42,27 +42,27 @@
 #include "utils/stk_process.hpp"
 
 //=============================================================================
-Physics* g_physics[PT_COUNT];
+Physics* g_physics[STK_MAX_PROCESS_SLOTS];
 // ----------------------------------------------------------------------------
 Physics* Physics::get()
 {
-    ProcessType type = STKProcess::getType();
-    return g_physics[type];
+    unsigned int slot = STKProcess::getSlot();
+    return g_physics[slot];
 }   // get
 
 // ----------------------------------------------------------------------------
 void Physics::create()
 {
-    ProcessType type = STKProcess::getType();
-    g_physics[type] = new Physics();
+    unsigned int slot = STKProcess::getSlot();
+    g_physics[slot] = new Physics();
 }   // create
 
 // ----------------------------------------------------------------------------
 void Physics::destroy()
 {
-    ProcessType type = STKProcess::getType();
-    delete g_physics[type];
-    g_physics[type] = NULL;
+    unsigned int slot = STKProcess::getSlot();
+    delete g_physics[slot];
+    g_physics[slot] = NULL;
 }   // destroy
 
 // ----------------------------------------------------------------------------
@@ -196,6 +196,10 @@ void Physics::update(int ticks)
     std::vector<CollisionPair>::iterator p;
     // Child process currently has no scripting engine
     bool is_child = STKProcess::getType() == PT_CHILD;
+    Scripting::ScriptEngine* script_engine =
+        is_child ? NULL : Scripting::ScriptEngine::getInstance();
+    static const std::string kart_kart_collision =
+        "void onKartKartCollision(int, int)";
     for(p=m_all_collisions.begin(); p!=m_all_collisions.end(); ++p)
     {
         // Kart-kart collision
@@ -206,13 +210,13 @@ void Physics::update(int ticks)
                               p->getContactPointCS(0),
                               p->getUserPointer(1)->getPointerKart(),
                               p->getContactPointCS(1)                );
-            if (!is_child)
+            // Most tracks don't handle kart-kart collisions, so check for the
+            // script function first instead of preparing the call.
+            if (script_engine && script_engine->hasFunction(kart_kart_collision))
             {
-                Scripting::ScriptEngine* script_engine =
-                                                Scripting::ScriptEngine::getInstance();
                 int kartid1 = p->getUserPointer(0)->getPointerKart()->getWorldKartId();
                 int kartid2 = p->getUserPointer(1)->getPointerKart()->getWorldKartId();
-                script_engine->runFunction(false, "void onKartKartCollision(int, int)",
+                script_engine->runFunction(false, kart_kart_collision,
                     [=](asIScriptContext* ctx) {
                         ctx->SetArgDWord(0, kartid1);
                         ctx->SetArgDWord(1, kartid2);
@@ -228,21 +232,19 @@ void Physics::update(int ticks)
             AbstractKart *kart = p->getUserPointer(1)->getPointerKart();
             int kartId = kart->getWorldKartId();
             PhysicalObject* obj = p->getUserPointer(0)->getPointerPhysicalObject();
-            std::string obj_id = obj->getID();
-            std::string scripting_function = obj->getOnKartCollisionFunction();
-
-            TrackObject* to = obj->getTrackObject();
-            TrackObject* library = to->getParentLibrary();
-            std::string lib_id;
-            std::string* lib_id_ptr = NULL;
-            if (library != NULL)
-                lib_id = library->getID();
-            lib_id_ptr = &lib_id;
-
-            if (!is_child && scripting_function.size() > 0)
+            const std::string &scripting_function =
+                obj->getOnKartCollisionDeclaration();
+
+            if (script_engine && !scripting_function.empty() &&
+                script_engine->hasFunction(scripting_function))
             {
-                Scripting::ScriptEngine* script_engine = Scripting::ScriptEngine::getInstance();
-                script_engine->runFunction(true, "void " + scripting_function + "(int, const string, const string)",
+                std::string obj_id = obj->getID();
+                TrackObject* library = obj->getTrackObject()->getParentLibrary();
+                std::string lib_id;
+                if (library != NULL)
+                    lib_id = library->getID();
+                std::string* lib_id_ptr = &lib_id;
+                script_engine->runFunction(true, scripting_function,
                     [&](asIScriptContext* ctx) {
                         ctx->SetArgDWord(0, kartId);
                         ctx->SetArgObject(1, lib_id_ptr);
@@ -330,12 +332,13 @@ void Physics::update(int ticks)
             // -------------------------------
             Flyable* flyable = p->getUserPointer(0)->getPointerFlyable();
             PhysicalObject* obj = p->getUserPointer(1)->getPointerPhysicalObject();
-            std::string obj_id = obj->getID();
-            std::string scripting_function = obj->getOnItemCollisionFunction();
-            if (!is_child && scripting_function.size() > 0)
+            const std::string &scripting_function =
+                obj->getOnItemCollisionDeclaration();
+            if (script_engine && !scripting_function.empty() &&
+                script_engine->hasFunction(scripting_function))
             {
-                Scripting::ScriptEngine* script_engine = Scripting::ScriptEngine::getInstance();
-                script_engine->runFunction(true, "void " + scripting_function + "(int, int, const string)",
+                std::string obj_id = obj->getID();
+                script_engine->runFunction(true, scripting_function,
                         [&](asIScriptContext* ctx) {
                         ctx->SetArgDWord(0, (int)flyable->getType());
                         ctx->SetArgDWord(1, flyable->getOwnerId());
@@ -22,11 +22,48 @@
 #include "physics/physics.hpp"
 #include "utils/constants.hpp"
 #include "utils/log.hpp"
+#include "utils/string_utils.hpp"
 #include "utils/time.hpp"
 
 #include "btBulletDynamicsCommon.h"
 
-#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#ifdef WIN32
+#  include <process.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+    /** Header of a BVH file written by TriangleMesh::saveBvh(). The BVH is
+     *  stored in the in-memory layout of this build (see
+     *  btQuantizedBvh::serialize), so the header rejects files written by
+     *  a different platform or bullet version. Its size keeps the BVH
+     *  16 byte aligned. */
+    struct BvhFileHeader
+    {
+        char     m_magic[8];
+        uint32_t m_byte_order;
+        uint32_t m_pointer_size;
+        uint32_t m_bullet_version;
+        uint32_t m_num_triangles;
+        uint64_t m_hash;
+        uint64_t m_bvh_size;
+        uint64_t m_padding;
+    };
+    static_assert(sizeof(BvhFileHeader) % 16 == 0,
+                  "BVH must be 16 byte aligned");
+    const char     BVH_FILE_MAGIC[8] = { 'S','T','K','B','V','H','0','1' };
+    const uint32_t BVH_FILE_BYTE_ORDER = 0x01020304;
+}   // namespace
 
 // -----------------------------------------------------------------------------
 /** Constructor: Initialises all data structures with zero.
@@ -44,6 +81,8 @@ TriangleMesh::TriangleMesh(bool can_be_transformed) : m_mesh()
     // (and m_mesh->m_weldingThreshold at m_normals
     m_collision_shape  = NULL;
     m_collision_object = NULL;
+    m_bvh_data         = NULL;
+    m_bvh_data_size    = 0;
     m_user_pointer.set(this);
 }   // TriangleMesh
 
@@ -89,10 +128,13 @@ void TriangleMesh::addTriangle(const btVector3 &t1, const btVector3 &t2,
 // -----------------------------------------------------------------------------
 /** Creates a collision body only, which can be used for raycasting, but
  *  has no physical properties.
- *  @param serialized_bhv if non-null, load the serialized bhv from file instead
- *                        of builing it on the fly
+ *  @param serialized_bhv if non-null, the BVH is loaded from this file if it
+ *                        was written for the same triangles, otherwise it is
+ *                        built and saved to this file for later loads.
+ *  @param hash computeHash() of this mesh, only used with serialized_bhv.
  */
-void TriangleMesh::createCollisionShape(bool create_collision_object, const char* serialized_bhv)
+void TriangleMesh::createCollisionShape(bool create_collision_object, const char* serialized_bhv,
+                                        uint64_t hash)
 {
     if(m_triangleIndex2Material.size()==0)
     {
@@ -103,55 +145,24 @@ void TriangleMesh::createCollisionShape(bool create_collision_object, const char
         return;
     }
     // Now convert the triangle mesh into a static rigid body
-    btBvhTriangleMeshShape* bhv_triangle_mesh;
+    btBvhTriangleMeshShape* bhv_triangle_mesh = NULL;
 
     if (serialized_bhv != NULL)
     {
-        FILE *f = fopen(serialized_bhv, "rb");
-        fseek(f, 0, SEEK_END);
-        long pos = ftell(f);
-        assert(pos != -1L);
-        fseek(f, 0, SEEK_SET);
-
-        void* bytes = btAlignedAlloc(pos, 16);
-        fread(bytes, pos, 1, f);
-        fclose(f);
-
-        btOptimizedBvh* bhv = btOptimizedBvh::deSerializeInPlace(bytes, pos, !IS_LITTLE_ENDIAN);
-        if (bhv == NULL)
-        {
-            Log::warn("TriangleMesh", "Failed to load serialized BHV");
-            bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */);
-        }
-        else
+        btOptimizedBvh* bhv = loadBvh(serialized_bhv, hash);
+        if (bhv)
         {
             bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */,
                                                            false /* buildBvh */);
             bhv_triangle_mesh->setOptimizedBvh( bhv );
         }
-        // Do *NOT* free the bytes, 'deSerializeInPlace' makes the btOptimizedBvh object
-        // directly at this memory location
-        //free(bytes);
-
     }
-    else
+    if (!bhv_triangle_mesh)
     {
         bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */);
-
-        /*
-         // code to serialize triangle mesh
-        btOptimizedBvh* bvh = bhv_triangle_mesh->getOptimizedBvh();
-        unsigned int ssize = bvh->calculateSerializeBufferSize();
-        char* buffer = (char*)btAlignedAlloc(ssize, 16);
-        bool success = bvh->serialize(buffer, ssize, !IS_LITTLE_ENDIAN);
-        printf("serialization success = %i\n", success);
-
-        std::ofstream fileout("/tmp/btOptimizedBvh");
-        fileout.write(buffer, ssize);
-        fileout.close();
-
-        btAlignedFree(buffer);
-         */
+        if (serialized_bhv != NULL)
+            saveBvh(serialized_bhv, hash,
+                    bhv_triangle_mesh->getOptimizedBvh());
     }
 
     m_collision_shape = bhv_triangle_mesh;
@@ -183,11 +194,15 @@ void TriangleMesh::createCollisionShape(bool create_collision_object, const char
  */
 void TriangleMesh::createPhysicalBody(float friction,
                                       btCollisionObject::CollisionFlags flags,
-                                      const char* serializedBhv)
+                                      const char* serializedBhv,
+                                      uint64_t hash)
 {
     // We need the collision shape, but not the collision object (since
-    // this will be created when the dynamics body is anyway).
-    createCollisionShape(/*create_collision_object*/false, serializedBhv);
+    // this will be created when the dynamics body is anyway). A shape kept
+    // by removeBody() is reused.
+    if(!m_collision_shape)
+        createCollisionShape(/*create_collision_object*/false, serializedBhv,
+                             hash);
 
     btTransform startTransform;
     startTransform.setIdentity();
@@ -207,13 +222,12 @@ void TriangleMesh::createPhysicalBody(float friction,
 }   // createPhysicalBody
 
 // ----------------------------------------------------------------------------
-/** Removes the created body and/or collision object from the physics world.
- *  This is used when creating a temporary rigid body of the main track to get
- *  bullet raycasts. Then the main track is removed, and the track (main track
- *  including all additional objects which were loaded later) is converted
- *  again.
+/** Removes the physical body from the physics world, but keeps the collision
+ *  shape. A later createPhysicalBody() call reuses the shape, so the BVH
+ *  does not need to be rebuilt (e.g. when the track is kept in the
+ *  TrackCache).
  */
-void TriangleMesh::removeAll()
+void TriangleMesh::removeBody()
 {
     // Don't free the physical body if it was created outside this object.
     if(m_body && m_free_body)
@@ -224,6 +238,18 @@ void TriangleMesh::removeAll()
         m_body         = NULL;
         m_motion_state = NULL;
     }
+}   // removeBody
+
+// ----------------------------------------------------------------------------
+/** Removes the created body and/or collision object from the physics world.
+ *  This is used when creating a temporary rigid body of the main track to get
+ *  bullet raycasts. Then the main track is removed, and the track (main track
+ *  including all additional objects which were loaded later) is converted
+ *  again.
+ */
+void TriangleMesh::removeAll()
+{
+    removeBody();
     if(m_collision_object)
     {
         delete m_collision_object;
@@ -231,8 +257,185 @@ void TriangleMesh::removeAll()
     }
     delete m_collision_shape;
     m_collision_shape = NULL;
+    freeBvhData();
 }   // removeAll
 
+// ----------------------------------------------------------------------------
+/** Returns a hash of all triangles of this mesh, which identifies the BVH
+ *  built for it. */
+uint64_t TriangleMesh::computeHash() const
+{
+    // 64 bit FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const void *data, size_t size)
+    {
+        const unsigned char *bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    const uint32_t n = (uint32_t)m_mesh.getNumTriangles();
+    add(&n, sizeof(n));
+    for (unsigned int i = 0; i < n; i++)
+    {
+        btVector3 p[3];
+        getTriangle(i, p, p + 1, p + 2);
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            const float xyz[3] = { p[j].getX(), p[j].getY(), p[j].getZ() };
+            add(xyz, sizeof(xyz));
+        }
+    }
+    return hash;
+}   // computeHash
+
+// ----------------------------------------------------------------------------
+/** Loads a BVH written by saveBvh(). The file is memory mapped copy on
+ *  write, and the BVH is used in place: only the first page (the BVH object
+ *  itself) is modified when it is initialised, so all processes using the
+ *  same file share the memory of the BVH nodes.
+ *  \param filename Name of the file.
+ *  \param hash computeHash() of this mesh.
+ *  \return The BVH, or NULL if the file does not exist or does not belong
+ *          to this mesh.
+ */
+btOptimizedBvh* TriangleMesh::loadBvh(const char *filename, uint64_t hash)
+{
+    void *data = NULL;
+    size_t size = 0;
+#ifdef WIN32
+    FILE *f = fopen(filename, "rb");
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long pos = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (pos > 0)
+    {
+        size = (size_t)pos;
+        data = btAlignedAlloc(size, 16);
+        if (fread(data, size, 1, f) != 1)
+        {
+            btAlignedFree(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+    if (!data)
+        return NULL;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        size = (size_t)st.st_size;
+        data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+            data = NULL;
+    }
+    close(fd);
+    if (!data)
+        return NULL;
+#endif
+    m_bvh_data      = data;
+    m_bvh_data_size = size;
+
+    const BvhFileHeader *header = (const BvhFileHeader*)data;
+    btOptimizedBvh *bvh = NULL;
+    if (size >= sizeof(BvhFileHeader) &&
+        memcmp(header->m_magic, BVH_FILE_MAGIC, 8) == 0 &&
+        header->m_byte_order == BVH_FILE_BYTE_ORDER &&
+        header->m_pointer_size == sizeof(void*) &&
+        header->m_bullet_version == BT_BULLET_VERSION &&
+        header->m_num_triangles == (uint32_t)m_mesh.getNumTriangles() &&
+        header->m_hash == hash &&
+        header->m_bvh_size == size - sizeof(BvhFileHeader))
+    {
+        bvh = btOptimizedBvh::deSerializeInPlace(
+            (char*)data + sizeof(BvhFileHeader),
+            (unsigned int)header->m_bvh_size, /*swap endian*/false);
+    }
+    if (!bvh)
+    {
+        Log::warn("TriangleMesh", "Ignoring outdated BVH file '%s'.",
+                  filename);
+        freeBvhData();
+    }
+    return bvh;
+}   // loadBvh
+
+// ----------------------------------------------------------------------------
+/** Saves a BVH so that it can be loaded by loadBvh(). The file is first
+ *  written under a temporary name and then renamed, so that processes
+ *  loading the same track at the same time never read a partial file.
+ *  \param filename Name of the file.
+ *  \param hash computeHash() of this mesh.
+ *  \param bvh The BVH built for this mesh.
+ */
+void TriangleMesh::saveBvh(const char *filename, uint64_t hash,
+                           const btOptimizedBvh *bvh) const
+{
+    BvhFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.m_magic, BVH_FILE_MAGIC, 8);
+    header.m_byte_order     = BVH_FILE_BYTE_ORDER;
+    header.m_pointer_size   = sizeof(void*);
+    header.m_bullet_version = BT_BULLET_VERSION;
+    header.m_num_triangles  = (uint32_t)m_mesh.getNumTriangles();
+    header.m_hash           = hash;
+    header.m_bvh_size       = bvh->calculateSerializeBufferSize();
+
+    void *buffer = btAlignedAlloc((size_t)header.m_bvh_size, 16);
+    bool ok = bvh->serialize(buffer, (unsigned int)header.m_bvh_size,
+                             /*swap endian*/false);
+
+#ifdef WIN32
+    const int pid = _getpid();
+#else
+    const int pid = getpid();
+#endif
+    const std::string tmp_file = std::string(filename) + "." +
+        StringUtils::toString(pid) + "." + StringUtils::toString(
+        std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    FILE *f = ok ? fopen(tmp_file.c_str(), "wb") : NULL;
+    if (f)
+    {
+        ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+             fwrite(buffer, (size_t)header.m_bvh_size, 1, f) == 1;
+        ok = fclose(f) == 0 && ok;
+        if (ok)
+        {
+            // rename does not replace existing files on windows
+            remove(filename);
+            ok = rename(tmp_file.c_str(), filename) == 0;
+        }
+        if (!ok)
+            remove(tmp_file.c_str());
+    }
+    if (!f || !ok)
+        Log::warn("TriangleMesh", "Can not save BVH to '%s'.", filename);
+    btAlignedFree(buffer);
+}   // saveBvh
+
+// ----------------------------------------------------------------------------
+/** Releases the memory of a BVH loaded by loadBvh(). */
+void TriangleMesh::freeBvhData()
+{
+    if (!m_bvh_data)
+        return;
+#ifdef WIN32
+    btAlignedFree(m_bvh_data);
+#else
+    munmap(m_bvh_data, m_bvh_data_size);
+#endif
+    m_bvh_data      = NULL;
+    m_bvh_data_size = 0;
+}   // freeBvhData
+
 // -----------------------------------------------------------------------------
 /** Interpolates the normal at the given position for the triangle with
  *  a given index. The position must be inside of the given triangle.
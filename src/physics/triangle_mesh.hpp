@@ -19,6 +19,7 @@
 #ifndef HEADER_TRIANGLE_MESH_HPP
 #define HEADER_TRIANGLE_MESH_HPP
 
+#include <cstdint>
 #include <vector>
 #include "btBulletDynamicsCommon.h"
 
@@ -46,6 +47,13 @@ private:
     btDefaultMotionState        *m_motion_state;
     btCollisionShape            *m_collision_shape;
 
+    /** The file contents of a BVH loaded by loadBvh(), which is used in
+     *  place by m_collision_shape. NULL if the BVH was built. */
+    void                        *m_bvh_data;
+
+    /** Size of m_bvh_data in bytes. */
+    size_t                       m_bvh_data_size;
+
     /** The three normals for each triangle. */
     AlignedArray<btVector3>      m_normals;
 
@@ -57,6 +65,11 @@ private:
      *  to the current transform of the body. */
     bool m_can_be_transformed;
 
+    btOptimizedBvh* loadBvh(const char *filename, uint64_t hash);
+    void            saveBvh(const char *filename, uint64_t hash,
+                            const btOptimizedBvh *bvh) const;
+    void            freeBvhData();
+
 public:
     class RigidBodyTriangleMesh : public btRigidBody
     {
@@ -76,12 +89,16 @@ public:
                      const btVector3 &t3, const btVector3 &n1,
                      const btVector3 &n2, const btVector3 &n3,
                      const Material* m);
-    void createCollisionShape(bool create_collision_object=true, const char* serialized_bhv=NULL);
+    void createCollisionShape(bool create_collision_object=true, const char* serialized_bhv=NULL,
+                              uint64_t hash=0);
     void createPhysicalBody(float friction,
                             btCollisionObject::CollisionFlags flags=
                                (btCollisionObject::CollisionFlags)0,
-                            const char* serializedBhv = NULL);
+                            const char* serializedBhv = NULL,
+                            uint64_t hash = 0);
     void removeAll();
+    void removeBody();
+    uint64_t computeHash() const;
     void removeCollisionObject();
     btVector3 getInterpolatedNormal(unsigned int index,
                                     const btVector3 &position) const;
@@ -39,31 +39,32 @@
 #include "scriptengine/property_animator.hpp"
 #include "tracks/track_manager.hpp"
 #include "utils/ptr_vector.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/stk_process.hpp"
 #include "utils/string_utils.hpp"
 
 //=============================================================================================
-RaceManager* g_race_manager[PT_COUNT];
+RaceManager* g_race_manager[STK_MAX_PROCESS_SLOTS];
 //---------------------------------------------------------------------------------------------
 RaceManager* RaceManager::get()
 {
-    ProcessType type = STKProcess::getType();
-    return g_race_manager[type];
+    unsigned int slot = STKProcess::getSlot();
+    return g_race_manager[slot];
 }   // get
 
 //---------------------------------------------------------------------------------------------
 void RaceManager::create()
 {
-    ProcessType type = STKProcess::getType();
-    g_race_manager[type] = new RaceManager();
+    unsigned int slot = STKProcess::getSlot();
+    g_race_manager[slot] = new RaceManager();
 }   // create
 
 //---------------------------------------------------------------------------------------------
 void RaceManager::destroy()
 {
-    ProcessType type = STKProcess::getType();
-    delete g_race_manager[type];
-    g_race_manager[type] = NULL;
+    unsigned int slot = STKProcess::getSlot();
+    delete g_race_manager[slot];
+    g_race_manager[slot] = NULL;
 }   // destroy
 
 //---------------------------------------------------------------------------------------------
@@ -115,6 +116,38 @@ void RaceManager::reset()
     m_num_finished_players = 0;
 }  // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the number of finished karts and the per kart results of the
+ *  current race.
+ */
+void RaceManager::saveState(StateBuffer *buffer) const
+{
+    buffer->add<unsigned int>(m_num_finished_karts);
+    buffer->add<unsigned int>(m_num_finished_players);
+    for (const KartStatus &status : m_kart_status)
+    {
+        buffer->add<int>(status.m_score);
+        buffer->add<int>(status.m_last_score);
+        buffer->add<float>(status.m_overall_time);
+        buffer->add<float>(status.m_last_time);
+    }
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void RaceManager::restoreState(StateBuffer *buffer)
+{
+    m_num_finished_karts   = buffer->get<unsigned int>();
+    m_num_finished_players = buffer->get<unsigned int>();
+    for (KartStatus &status : m_kart_status)
+    {
+        status.m_score        = buffer->get<int>();
+        status.m_last_score   = buffer->get<int>();
+        status.m_overall_time = buffer->get<float>();
+        status.m_last_time    = buffer->get<float>();
+    }
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Sets the default list of AI karts to use.
  *  \param ai_kart_list List of the identifier of the karts to use.
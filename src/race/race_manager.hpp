@@ -35,6 +35,7 @@
 
 class AbstractKart;
 class SavedGrandPrix;
+class StateBuffer;
 class Track;
 
 static const std::string IDENT_STD      ("STANDARD"        );
@@ -324,6 +325,8 @@ public:
         ~RaceManager();
 
     void reset();
+    void saveState(StateBuffer *buffer) const;
+    void restoreState(StateBuffer *buffer);
     void setPlayerKart(unsigned int player_id, const std::string &kart_name);
     void setPlayerKart(unsigned int player_id,
                        const RemoteKartInfo& ki);
@@ -95,14 +95,15 @@ bool AnimatedProperty::update(double dt)
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
 
-PropertyAnimator* PropertyAnimator::s_instance = NULL;
+PropertyAnimator* PropertyAnimator::s_instance[STK_MAX_PROCESS_SLOTS] = {};
 
 PropertyAnimator* PropertyAnimator::get()
 {
-    if (s_instance == NULL)
-        s_instance = new PropertyAnimator();
+    PropertyAnimator*& instance = s_instance[STKProcess::getSlot()];
+    if (instance == NULL)
+        instance = new PropertyAnimator();
 
-    return s_instance;
+    return instance;
 }
 
 // ----------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 
 #include "utils/no_copy.hpp"
 #include "utils/ptr_vector.hpp"
+#include "utils/stk_process.hpp"
 
 enum AnimatablePropery
 {
@@ -59,7 +60,7 @@ public:
 class PropertyAnimator
 {
     PtrVector<AnimatedProperty> m_properties;
-    static PropertyAnimator* s_instance;
+    static PropertyAnimator* s_instance[STK_MAX_PROCESS_SLOTS];
 public:
 
     static PropertyAnimator* get();
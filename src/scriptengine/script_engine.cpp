@@ -85,6 +85,9 @@ namespace Scripting
     {
         // Release the engine
         m_pending_timeouts.clearAndDeleteAll();
+        for (asIScriptContext* ctx : m_free_contexts)
+            ctx->Release();
+        m_free_contexts.clear();
         m_engine->DiscardModule(MODULE_ID_MAIN_SCRIPT_FILE);
         m_engine->Release();
     }
@@ -187,11 +190,12 @@ namespace Scripting
             return;
         }
 
-        asIScriptContext *ctx = m_engine->CreateContext();
+        asIScriptContext *ctx = requestContext();
         if (ctx == NULL)
         {
             Log::error("Scripting", "evalScript: Failed to create the context.");
             //m_engine->Release();
+            func->Release();
             return;
         }
 
@@ -199,7 +203,8 @@ namespace Scripting
         if (r < 0)
         {
             Log::error("Scripting", "evalScript: Failed to prepare the context.");
-            ctx->Release();
+            returnContext(ctx);
+            func->Release();
             return;
         }
 
@@ -222,7 +227,7 @@ namespace Scripting
             }
         }
 
-        ctx->Release();
+        returnContext(ctx);
         func->Release();
     }
 
@@ -230,7 +235,7 @@ namespace Scripting
 
     void ScriptEngine::runDelegate(asIScriptFunction* delegate)
     {
-        asIScriptContext *ctx = m_engine->CreateContext();
+        asIScriptContext *ctx = requestContext();
         if (ctx == NULL)
         {
             Log::error("Scripting", "runMethod: Failed to create the context.");
@@ -242,7 +247,7 @@ namespace Scripting
         if (r < 0)
         {
             Log::error("Scripting", "runMethod: Failed to prepare the context.");
-            ctx->Release();
+            returnContext(ctx);
             return;
         }
 
@@ -267,7 +272,7 @@ namespace Scripting
             }
         }
 
-        ctx->Release();
+        returnContext(ctx);
     }
 
     //-----------------------------------------------------------------------------
@@ -324,7 +329,8 @@ namespace Scripting
     /** runs the specified script
     *  \param string scriptName = name of script to run
     */
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name)
+    void ScriptEngine::runFunction(bool warn_if_not_found,
+                                   const std::string& function_name)
     {
         std::function<void(asIScriptContext*)> callback;
         std::function<void(asIScriptContext*)> get_return_value;
@@ -333,71 +339,110 @@ namespace Scripting
 
     //-----------------------------------------------------------------------------
 
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name,
-        std::function<void(asIScriptContext*)> callback)
+    void ScriptEngine::runFunction(bool warn_if_not_found,
+        const std::string& function_name,
+        const std::function<void(asIScriptContext*)>& callback)
     {
         std::function<void(asIScriptContext*)> get_return_value;
         runFunction(warn_if_not_found, function_name, callback, get_return_value);
     }
 
     //-----------------------------------------------------------------------------
-
-    /** runs the specified script
-    *  \param string scriptName = name of script to run
+    /** Returns the script function with the given declaration, or NULL if the
+    *  loaded scripts don't define it. The result is cached, so only the first
+    *  call for each declaration searches the module.
+    *  \param function_name The declaration of the function, e.g.
+    *         "void onStart()".
     */
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name,
-        std::function<void(asIScriptContext*)> callback,
-        std::function<void(asIScriptContext*)> get_return_value)
+    asIScriptFunction* ScriptEngine::getFunction(const std::string& function_name)
     {
-        int r; //int for error checking
-
-        asIScriptFunction *func;
-
-        // TODO: allow splitting in multiple files
-        std::string script_filename = "scripting.as";
         auto cached_function = m_functions_cache.find(function_name);
-        if (cached_function == m_functions_cache.end())
+        if (cached_function != m_functions_cache.end())
         {
-            // Find the function for the function we want to execute.
-            //      This is how you call a normal function with arguments
-            //      asIScriptFunction *func = engine->GetModule(0)->GetFunctionByDecl("void func(arg1Type, arg2Type)");
-            asIScriptModule* module = m_engine->GetModule(MODULE_ID_MAIN_SCRIPT_FILE);
+            // Script present in cache
+            return cached_function->second;
+        }
 
-            if (module == NULL)
-            {
-#ifndef SERVER_ONLY
-                if (warn_if_not_found)
-                    Log::warn("Scripting", "Scripting function was not found : %s (module not found)", function_name.c_str());
-                else
-                    Log::debug("Scripting", "Scripting function was not found : %s (module not found)", function_name.c_str());
-#endif
-                m_functions_cache[function_name] = NULL; // remember that this function is unavailable
-                return;
-            }
+        // Find the function for the function we want to execute.
+        //      This is how you call a normal function with arguments
+        //      asIScriptFunction *func = engine->GetModule(0)->GetFunctionByDecl("void func(arg1Type, arg2Type)");
+        asIScriptModule* module = m_engine->GetModule(MODULE_ID_MAIN_SCRIPT_FILE);
 
-            func = module->GetFunctionByDecl(function_name.c_str());
-            
-            if (func == NULL)
-            {
+        if (module == NULL)
+        {
 #ifndef SERVER_ONLY
-                if (warn_if_not_found)
-                    Log::warn("Scripting", "Scripting function was not found : %s", function_name.c_str());
-                else
-                    Log::debug("Scripting", "Scripting function was not found : %s", function_name.c_str());
+            Log::debug("Scripting", "Scripting function was not found : %s (module not found)", function_name.c_str());
 #endif
-                m_functions_cache[function_name] = NULL; // remember that this function is unavailable
-                return;
-            }
-
-            m_functions_cache[function_name] = func;
-            func->AddRef();
+            m_functions_cache[function_name] = NULL; // remember that this function is unavailable
+            return NULL;
         }
-        else
+
+        asIScriptFunction* func = module->GetFunctionByDecl(function_name.c_str());
+
+        if (func == NULL)
         {
-            // Script present in cache
-            func = cached_function->second;
+#ifndef SERVER_ONLY
+            Log::debug("Scripting", "Scripting function was not found : %s", function_name.c_str());
+#endif
+            m_functions_cache[function_name] = NULL; // remember that this function is unavailable
+            return NULL;
         }
 
+        m_functions_cache[function_name] = func;
+        func->AddRef();
+        return func;
+    }   // getFunction
+
+    //-----------------------------------------------------------------------------
+    /** Returns true if the loaded scripts define a function with the given
+    *  declaration. This allows callers to skip preparing the arguments for
+    *  handlers that don't exist, e.g. for every collision.
+    *  \param function_name The declaration of the function.
+    */
+    bool ScriptEngine::hasFunction(const std::string& function_name)
+    {
+        return getFunction(function_name) != NULL;
+    }   // hasFunction
+
+    //-----------------------------------------------------------------------------
+    /** Returns an unused context, either from the pool of free contexts or a
+    *  newly created one. It must be given back with returnContext(). Nested
+    *  calls (a script function triggering another one) each get their own
+    *  context.
+    */
+    asIScriptContext* ScriptEngine::requestContext()
+    {
+        if (m_free_contexts.empty())
+            return m_engine->CreateContext();
+        asIScriptContext* ctx = m_free_contexts.back();
+        m_free_contexts.pop_back();
+        return ctx;
+    }   // requestContext
+
+    //-----------------------------------------------------------------------------
+    /** Puts a context that was returned by requestContext() back into the
+    *  pool so it can be reused.
+    */
+    void ScriptEngine::returnContext(asIScriptContext* ctx)
+    {
+        // Release the references the context holds to the last function
+        ctx->Unprepare();
+        m_free_contexts.push_back(ctx);
+    }   // returnContext
+
+    //-----------------------------------------------------------------------------
+
+    /** runs the specified script
+    *  \param string scriptName = name of script to run
+    */
+    void ScriptEngine::runFunction(bool warn_if_not_found,
+        const std::string& function_name,
+        const std::function<void(asIScriptContext*)>& callback,
+        const std::function<void(asIScriptContext*)>& get_return_value)
+    {
+        int r; //int for error checking
+
+        asIScriptFunction *func = getFunction(function_name);
         if (func == NULL)
         {
             if (warn_if_not_found)
@@ -405,8 +450,8 @@ namespace Scripting
             return; // function unavailable
         }
 
-        // Create a context that will execute the script.
-        asIScriptContext *ctx = m_engine->CreateContext();
+        // Get a context that will execute the script.
+        asIScriptContext *ctx = requestContext();
         if (ctx == NULL)
         {
             Log::error("Scripting", "Failed to create the context.");
@@ -423,7 +468,7 @@ namespace Scripting
         if (r < 0)
         {
             Log::error("Scripting", "Failed to prepare the context.");
-            ctx->Release();
+            returnContext(ctx);
             //m_engine->Release();
             return;
         }
@@ -471,8 +516,8 @@ namespace Scripting
                 get_return_value(ctx);
         }
 
-        // We must release the contexts when no longer using them
-        ctx->Release();
+        // The context can be reused for the next function
+        returnContext(ctx);
     }
 
     //-----------------------------------------------------------------------------
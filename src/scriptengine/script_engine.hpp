@@ -26,8 +26,9 @@
 
 #include <angelscript.h>
 #include <functional>
-#include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class TrackObjectPresentation;
 
@@ -67,12 +68,16 @@ namespace Scripting
     public:
 
 
-        void runFunction(bool warn_if_not_found, std::string function_name);
-        void runFunction(bool warn_if_not_found, std::string function_name,
-            std::function<void(asIScriptContext*)> callback);
-        void runFunction(bool warn_if_not_found, std::string function_name,
-            std::function<void(asIScriptContext*)> callback,
-            std::function<void(asIScriptContext*)> get_return_value);
+        void runFunction(bool warn_if_not_found,
+            const std::string& function_name);
+        void runFunction(bool warn_if_not_found,
+            const std::string& function_name,
+            const std::function<void(asIScriptContext*)>& callback);
+        void runFunction(bool warn_if_not_found,
+            const std::string& function_name,
+            const std::function<void(asIScriptContext*)>& callback,
+            const std::function<void(asIScriptContext*)>& get_return_value);
+        bool hasFunction(const std::string& function_name);
         void runDelegate(asIScriptFunction* delegate_fn);
         void evalScript(std::string script_fragment);
         void cleanupCache();
@@ -88,10 +93,22 @@ namespace Scripting
 
     private:
         asIScriptEngine *m_engine;
-        std::map<std::string, asIScriptFunction*> m_functions_cache;
+
+        /** Maps a function declaration to the script function, NULL if the
+         *  loaded scripts don't define it. */
+        std::unordered_map<std::string, asIScriptFunction*> m_functions_cache;
+
+        /** Contexts that are not executing anything and can be reused.
+         *  Creating a context is expensive, and functions are run for
+         *  every collision. */
+        std::vector<asIScriptContext*> m_free_contexts;
+
         PtrVector<PendingTimeout> m_pending_timeouts;
 
         void configureEngine(asIScriptEngine *engine);
+        asIScriptFunction* getFunction(const std::string& function_name);
+        asIScriptContext* requestContext();
+        void returnContext(asIScriptContext* ctx);
     };   // class ScriptEngine
 
 }
@@ -25,19 +25,29 @@
 #include "tracks/track.hpp"
 #include "tracks/track_manager.hpp"
 #include "utils/log.hpp"
+#include "utils/string_utils.hpp"
+#include "utils/thread_pool.hpp"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
 #include <queue>
+#include <thread>
+
+#ifdef WIN32
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif
 
 // -----------------------------------------------------------------------------
 ArenaGraph::ArenaGraph(const std::string &navmesh, const XMLNode *node)
           : Graph()
 {
     loadNavmesh(navmesh);
-    buildGraph();
-    // Compute shortest distance from all nodes
-    for (unsigned int i = 0; i < getNumNodes(); i++)
-        computeDijkstra(i);
+    buildGrid();
+    computeAllPaths(navmesh);
 
     setNearbyNodesOfAllNodes();
     if (node && RaceManager::get()->getMinorMode() == RaceManager::MINOR_MODE_SOCCER)
@@ -166,12 +176,14 @@ void ArenaGraph::loadNavmesh(const std::string &navmesh)
 }   // loadNavmesh
 
 // ----------------------------------------------------------------------------
+/** Initialises the distance and parent tables with the direct connections
+ *  between adjacent nodes.
+ */
 void ArenaGraph::buildGraph()
 {
     const unsigned int n_nodes = getNumNodes();
 
-    m_distance_matrix = std::vector<std::vector<float>>
-        (n_nodes, std::vector<float>(n_nodes, 9999.9f));
+    m_distance_matrix.assign(n_nodes * n_nodes, 9999.9f);
     for (unsigned int i = 0; i < n_nodes; i++)
     {
         ArenaNode* cur_node = getNode(i);
@@ -179,22 +191,21 @@ void ArenaGraph::buildGraph()
         {
             Vec3 diff = getNode(adjacent)->getCenter() - cur_node->getCenter();
             float distance = diff.length();
-            m_distance_matrix[i][adjacent] = distance;
+            m_distance_matrix[i * n_nodes + adjacent] = distance;
         }
-        m_distance_matrix[i][i] = 0.0f;
+        m_distance_matrix[i * n_nodes + i] = 0.0f;
     }
 
     // Allocate and initialise the previous node data structure:
-    m_parent_node = std::vector<std::vector<int16_t>>
-        (n_nodes, std::vector<int16_t>(n_nodes, Graph::UNKNOWN_SECTOR));
+    m_parent_node.resize(n_nodes * n_nodes);
     for (unsigned int i = 0; i < n_nodes; i++)
     {
         for (unsigned int j = 0; j < n_nodes; j++)
         {
-            if (i == j || m_distance_matrix[i][j] >= 9899.9f)
-                m_parent_node[i][j] = -1;
+            if (i == j || m_distance_matrix[i * n_nodes + j] >= 9899.9f)
+                m_parent_node[i * n_nodes + j] = -1;
             else
-                m_parent_node[i][j] = i;
+                m_parent_node[i * n_nodes + j] = i;
         }   // for j
     }   // for i
 
@@ -207,8 +218,13 @@ void ArenaGraph::buildGraph()
  *  source to j and m_parent_node[source][j] stores the last vertex visited on
  *  the shortest path from i to j before visiting j. Suppose the shortest path
  *  from i to j is i->......->k->j  then m_parent_node[i][j] = k
+ *  Only the row of 'source' is written, so this can be run for different
+ *  sources in parallel.
+ *  \param edges The length of each connection, in the same order as
+ *         ArenaNode::getAdjacentNodes().
  */
-void ArenaGraph::computeDijkstra(int source)
+void ArenaGraph::computeDijkstra(int source,
+                                 const std::vector<std::vector<float> > &edges)
 {
     // Stores the distance (float) to 'source' from a specified node (int)
     typedef std::pair<int, float> IndDistPair;
@@ -226,6 +242,8 @@ void ArenaGraph::computeDijkstra(int source)
     IndDistPair begin(source, 0.0f);
     queue.push(begin);
     const unsigned int n = getNumNodes();
+    float* distance = &m_distance_matrix[source * n];
+    int16_t* parent = &m_parent_node[source * n];
     std::vector<bool> visited;
     visited.resize(n, false);
     while (!queue.empty())
@@ -237,17 +255,19 @@ void ArenaGraph::computeDijkstra(int source)
         if (visited[cur_index]) continue;
         visited[cur_index] = true;
 
-        for (const int& adjacent : getNode(cur_index)->getAdjacentNodes())
+        const std::vector<int>& adjacents =
+            getNode(cur_index)->getAdjacentNodes();
+        for (unsigned int k = 0; k < adjacents.size(); k++)
         {
+            const int adjacent = adjacents[k];
             // Distance already computed, can be ignored
             if (visited[adjacent]) continue;
 
-            float new_dist =
-                current.second + m_distance_matrix[cur_index][adjacent];
-            if (new_dist < m_distance_matrix[source][adjacent])
+            float new_dist = current.second + edges[cur_index][k];
+            if (new_dist < distance[adjacent])
             {
-                m_distance_matrix[source][adjacent] = new_dist;
-                m_parent_node[source][adjacent] = cur_index;
+                distance[adjacent] = new_dist;
+                parent[adjacent] = cur_index;
             }
             IndDistPair pair(adjacent, new_dist);
             queue.push(pair);
@@ -255,6 +275,185 @@ void ArenaGraph::computeDijkstra(int source)
     }
 }   // computeDijkstra
 
+// ----------------------------------------------------------------------------
+/** Computes the shortest paths between all nodes. The result only depends on
+ *  the navmesh, so it is saved to a binary file beside the navmesh (or in
+ *  the cache directory if the track directory is not writable) and read
+ *  from there on later loads.
+ *  \param navmesh Full path of the navmesh file.
+ */
+void ArenaGraph::computeAllPaths(const std::string &navmesh)
+{
+    const unsigned int n = getNumNodes();
+    if (n == 0)
+        return;
+
+    const uint64_t hash = computeNavmeshHash();
+    const std::string local_file = StringUtils::removeExtension(navmesh)
+                                 + ".paths";
+    char hash_string[32];
+    sprintf(hash_string, "%016llx", (unsigned long long)hash);
+    const std::string cache_file = file_manager->getCachedTexturesDir()
+                                 + "navmesh-" + hash_string + ".paths";
+    if (loadPathCache(local_file, hash) || loadPathCache(cache_file, hash))
+        return;
+
+    buildGraph();
+    // Length of each connection, which stays constant while the rows of
+    // the distance matrix are updated in parallel.
+    std::vector<std::vector<float> > edges(n);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        for (const int& adjacent : getNode(i)->getAdjacentNodes())
+            edges[i].push_back(m_distance_matrix[i * n + adjacent]);
+    }
+    // Compute shortest distance from all nodes
+    ThreadPool::get()->parallelFor(n, [this, &edges](unsigned int i)
+    {
+        computeDijkstra(i, edges);
+    });
+
+    if (!savePathCache(local_file, hash))
+        savePathCache(cache_file, hash);
+}   // computeAllPaths
+
+// ----------------------------------------------------------------------------
+/** Returns a hash of everything the shortest paths depend on, i.e. the
+ *  center and adjacent nodes of each node. Used to detect stale path
+ *  files.
+ */
+uint64_t ArenaGraph::computeNavmeshHash() const
+{
+    // 64 bit FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const void *data, size_t size)
+    {
+        const unsigned char *bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    const uint32_t n = getNumNodes();
+    add(&n, sizeof(n));
+    for (unsigned int i = 0; i < n; i++)
+    {
+        ArenaNode* node = getNode(i);
+        const float center[3] = { node->getCenter().getX(),
+                                  node->getCenter().getY(),
+                                  node->getCenter().getZ() };
+        add(center, sizeof(center));
+        const std::vector<int>& adjacents = node->getAdjacentNodes();
+        const uint32_t count = (uint32_t)adjacents.size();
+        add(&count, sizeof(count));
+        if (count > 0)
+            add(adjacents.data(), count * sizeof(int));
+    }
+    return hash;
+}   // computeNavmeshHash
+
+// ----------------------------------------------------------------------------
+namespace
+{
+    /** Header of a saved path file. The tables are stored in native byte
+     *  order, the byte order mark rejects files from other platforms. */
+    struct PathCacheHeader
+    {
+        char     m_magic[8];
+        uint32_t m_byte_order;
+        uint32_t m_num_nodes;
+        uint64_t m_hash;
+    };
+    const char     PATH_CACHE_MAGIC[8] = { 'S','T','K','P','A','T','H','1' };
+    const uint32_t PATH_CACHE_BYTE_ORDER = 0x01020304;
+}   // namespace
+
+// ----------------------------------------------------------------------------
+/** Reads the shortest path tables from a file written by savePathCache().
+ *  \return True if the file exists and matches the current navmesh.
+ */
+bool ArenaGraph::loadPathCache(const std::string &filename, uint64_t hash)
+{
+    FILE *f = fopen(filename.c_str(), "rb");
+    if (!f)
+        return false;
+
+    const size_t n = getNumNodes();
+    PathCacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              memcmp(header.m_magic, PATH_CACHE_MAGIC, 8) == 0 &&
+              header.m_byte_order == PATH_CACHE_BYTE_ORDER &&
+              header.m_num_nodes == n && header.m_hash == hash;
+    if (ok)
+    {
+        m_distance_matrix.resize(n * n);
+        m_parent_node.resize(n * n);
+        ok = fread(m_distance_matrix.data(), sizeof(float), n * n, f)
+                 == n * n &&
+             fread(m_parent_node.data(), sizeof(int16_t), n * n, f) == n * n;
+        // Parents are used as node indices, so never trust them blindly
+        for (size_t i = 0; ok && i < m_parent_node.size(); i++)
+        {
+            const int16_t parent = m_parent_node[i];
+            ok = parent >= -1 && parent < (int)n;
+        }
+    }
+    fclose(f);
+    if (!ok)
+    {
+        Log::warn("ArenaGraph", "Ignoring outdated path file '%s'.",
+                  filename.c_str());
+        m_distance_matrix.clear();
+        m_parent_node.clear();
+    }
+    return ok;
+}   // loadPathCache
+
+// ----------------------------------------------------------------------------
+/** Saves the shortest path tables. The file is first written under a
+ *  temporary name and then renamed, so that processes loading the same
+ *  arena at the same time never read a partial file.
+ *  \return True if the file was written.
+ */
+bool ArenaGraph::savePathCache(const std::string &filename,
+                               uint64_t hash) const
+{
+#ifdef WIN32
+    const int pid = _getpid();
+#else
+    const int pid = getpid();
+#endif
+    const std::string tmp_file = filename + "." +
+        StringUtils::toString(pid) + "." + StringUtils::toString(
+        std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    FILE *f = fopen(tmp_file.c_str(), "wb");
+    if (!f)
+        return false;
+
+    const size_t n = getNumNodes();
+    PathCacheHeader header;
+    memcpy(header.m_magic, PATH_CACHE_MAGIC, 8);
+    header.m_byte_order = PATH_CACHE_BYTE_ORDER;
+    header.m_num_nodes  = (uint32_t)n;
+    header.m_hash       = hash;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(m_distance_matrix.data(), sizeof(float), n * n, f)
+                  == n * n &&
+              fwrite(m_parent_node.data(), sizeof(int16_t), n * n, f)
+                  == n * n;
+    ok = fclose(f) == 0 && ok;
+    if (ok)
+    {
+        // rename does not replace existing files on windows
+        remove(filename.c_str());
+        ok = rename(tmp_file.c_str(), filename.c_str()) == 0;
+    }
+    if (!ok)
+        remove(tmp_file.c_str());
+    return ok;
+}   // savePathCache
+
 // ----------------------------------------------------------------------------
 /** THIS FUNCTION IS ONLY USED FOR UNIT-TESTING, to verify that the new
  *  Dijkstra algorithm gives the same results.
@@ -268,6 +467,7 @@ void ArenaGraph::computeDijkstra(int source)
 void ArenaGraph::computeFloydWarshall()
 {
     unsigned int n = getNumNodes();
+    std::vector<float>& d = m_distance_matrix;
 
     for (unsigned int k = 0; k < n; k++)
     {
@@ -275,12 +475,10 @@ void ArenaGraph::computeFloydWarshall()
         {
             for (unsigned int j = 0; j < n; j++)
             {
-                if ((m_distance_matrix[i][k] + m_distance_matrix[k][j]) <
-                    m_distance_matrix[i][j])
+                if ((d[i * n + k] + d[k * n + j]) < d[i * n + j])
                 {
-                    m_distance_matrix[i][j] =
-                        m_distance_matrix[i][k] + m_distance_matrix[k][j];
-                    m_parent_node[i][j] = m_parent_node[k][j];
+                    d[i * n + j] = d[i * n + k] + d[k * n + j];
+                    m_parent_node[i * n + j] = m_parent_node[k * n + j];
                 }
             }
         }
@@ -332,24 +530,31 @@ void ArenaGraph::setNearbyNodesOfAllNodes()
 {
     // Only save the nearby 8 nodes
     const unsigned int try_count = 8;
-    for (unsigned int i = 0; i < getNumNodes(); i++)
+    const unsigned int n = getNumNodes();
+    std::vector<int> order;
+    order.reserve(n);
+    for (unsigned int i = 0; i < n; i++)
     {
-        // Get the distance to all nodes at i
-        ArenaNode* cur_node = getNode(i);
-        std::vector<int> nearby_nodes;
-        std::vector<float> dist = m_distance_matrix[i];
-
-        // Skip the same node
-        dist[i] = 999999.0f;
-        for (unsigned int j = 0; j < try_count; j++)
+        // Sort the other nodes by distance to i, ties by index
+        const float* dist = &m_distance_matrix[i * n];
+        order.clear();
+        for (unsigned int j = 0; j < n; j++)
         {
-            std::vector<float>::iterator it =
-                std::min_element(dist.begin(), dist.end());
-            const int pos = int(it - dist.begin());
-            nearby_nodes.push_back(pos);
-            dist[pos] = 999999.0f;
+            // Skip the same node
+            if (j != i)
+                order.push_back(j);
         }
-        cur_node->setNearbyNodes(nearby_nodes);
+        const unsigned int count = std::min(try_count, n - 1);
+        std::partial_sort(order.begin(), order.begin() + count, order.end(),
+            [dist](int a, int b)
+            {
+                return dist[a] < dist[b] || (dist[a] == dist[b] && a < b);
+            });
+        std::vector<int> nearby_nodes(order.begin(), order.begin() + count);
+        // With less than try_count other nodes, the remaining entries are
+        // filled with node 0
+        nearby_nodes.resize(try_count, 0);
+        getNode(i)->setNearbyNodes(nearby_nodes);
     }
 
 }   // setNearbyNodesOfAllNodes
@@ -358,14 +563,14 @@ void ArenaGraph::setNearbyNodesOfAllNodes()
 /** Determines the full path from 'from' to 'to' and returns it in a
  *  std::vector (in reverse order). Used only for unit testing.
  */
-std::vector<int16_t> ArenaGraph::getPathFromTo(int from, int to,
-                      const std::vector< std::vector< int16_t > >& parent_node)
+std::vector<int16_t> ArenaGraph::getPathFromTo(int from, int to) const
 {
+    const unsigned int n = getNumNodes();
     std::vector<int16_t> path;
     path.push_back(to);
     while(from!=to)
     {
-        to = parent_node[from][to];
+        to = m_parent_node[from * n + to];
         path.push_back(to);
     }
     return path;
@@ -22,6 +22,7 @@
 #include "tracks/graph.hpp"
 #include "utils/cpp2011.hpp"
 
+#include <cstdint>
 #include <set>
 
 class ArenaNode;
@@ -34,11 +35,13 @@ class XMLNode;
 class ArenaGraph : public Graph
 {
 private:
-    /** The actual graph data structure, it is an adjacency matrix. */
-    std::vector<std::vector<float>> m_distance_matrix;
+    /** Shortest path distances between all nodes, stored row by row:
+     *  m_distance_matrix[i*n+j] is the distance from node i to node j. */
+    std::vector<float> m_distance_matrix;
 
-    /** The matrix that is used to store computed shortest paths. */
-    std::vector<std::vector<int16_t>> m_parent_node;
+    /** The matrix that is used to store computed shortest paths, with the
+     *  same layout as m_distance_matrix. */
+    std::vector<int16_t> m_parent_node;
 
     /** Used in soccer mode to colorize the goal lines in minimap. */
     std::set<int> m_red_node;
@@ -54,19 +57,27 @@ private:
     // ------------------------------------------------------------------------
     void setNearbyNodesOfAllNodes();
     // ------------------------------------------------------------------------
-    void computeDijkstra(int n);
+    void computeDijkstra(int source,
+                         const std::vector<std::vector<float> > &edges);
+    // ------------------------------------------------------------------------
+    void computeAllPaths(const std::string &navmesh);
+    // ------------------------------------------------------------------------
+    uint64_t computeNavmeshHash() const;
+    // ------------------------------------------------------------------------
+    bool loadPathCache(const std::string &filename, uint64_t hash);
+    // ------------------------------------------------------------------------
+    bool savePathCache(const std::string &filename, uint64_t hash) const;
     // ------------------------------------------------------------------------
     void computeFloydWarshall();
     // ------------------------------------------------------------------------
-    static std::vector<int16_t> getPathFromTo(int from, int to,
-                     const std::vector< std::vector< int16_t > >& parent_node);
+    std::vector<int16_t> getPathFromTo(int from, int to) const;
     // ------------------------------------------------------------------------
     virtual bool hasLapLine() const OVERRIDE                  { return false; }
     // ------------------------------------------------------------------------
     virtual void differentNodeColor(int n, video::SColor* c) const OVERRIDE;
 
 public:
-    static ArenaGraph* get()     { return dynamic_cast<ArenaGraph*>(m_graph); }
+    static ArenaGraph* get()     { return dynamic_cast<ArenaGraph*>(Graph::get()); }
     // ------------------------------------------------------------------------
     ArenaGraph(const std::string &navmesh, const XMLNode *node = NULL);
     // ------------------------------------------------------------------------
@@ -82,7 +93,7 @@ public:
     {
         if (i == Graph::UNKNOWN_SECTOR || j == Graph::UNKNOWN_SECTOR)
             return Graph::UNKNOWN_SECTOR;
-        return (int)(m_parent_node[j][i]);
+        return (int)(m_parent_node[j * getNumNodes() + i]);
     }
     // ------------------------------------------------------------------------
     /** Returns the distance between any two nodes */
@@ -90,7 +101,7 @@ public:
     {
         if (from == Graph::UNKNOWN_SECTOR || to == Graph::UNKNOWN_SECTOR)
             return 99999.0f;
-        return m_distance_matrix[from][to];
+        return m_distance_matrix[from * getNumNodes() + to];
     }
 
 };   // ArenaGraph
@@ -25,6 +25,7 @@
 #include "modes/linear_world.hpp"
 #include "race/race_manager.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 
 /** Constructor for a lap line.
  *  \param check_manager Pointer to the check manager, which is needed when
@@ -49,6 +50,22 @@ void CheckLap::reset(const Track &track)
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+void CheckLap::saveState(StateBuffer *buffer) const
+{
+    CheckStructure::saveState(buffer);
+    for (unsigned int i = 0; i < m_previous_distance.size(); i++)
+        buffer->add<float>(m_previous_distance[i]);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void CheckLap::restoreState(StateBuffer *buffer)
+{
+    CheckStructure::restoreState(buffer);
+    for (unsigned int i = 0; i < m_previous_distance.size(); i++)
+        m_previous_distance[i] = buffer->get<float>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** True if going from old_pos to new_pos crosses this checkline. This function
  *  is called from update (of the checkline structure).
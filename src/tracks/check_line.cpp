@@ -28,6 +28,7 @@
 #include "modes/world.hpp"
 
 #include "race/race_manager.hpp"
+#include "utils/state_buffer.hpp"
 
 #include "irrlicht.h"
 
@@ -96,6 +97,22 @@ void CheckLine::reset(const Track &track)
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+void CheckLine::saveState(StateBuffer *buffer) const
+{
+    CheckStructure::saveState(buffer);
+    for (unsigned int i = 0; i < m_previous_sign.size(); i++)
+        buffer->add<bool>(m_previous_sign[i]);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void CheckLine::restoreState(StateBuffer *buffer)
+{
+    CheckStructure::restoreState(buffer);
+    for (unsigned int i = 0; i < m_previous_sign.size(); i++)
+        m_previous_sign[i] = buffer->get<bool>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 void CheckLine::resetAfterKartMove(unsigned int kart_index)
 {
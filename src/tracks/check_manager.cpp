@@ -116,6 +116,22 @@ void CheckManager::reset(const Track &track)
         (*i)->reset(track);
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the state of all checks. */
+void CheckManager::saveState(StateBuffer *buffer) const
+{
+    for (const CheckStructure *check : m_all_checks)
+        check->saveState(buffer);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void CheckManager::restoreState(StateBuffer *buffer)
+{
+    for (CheckStructure *check : m_all_checks)
+        check->restoreState(buffer);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Called after a kart is moved (e.g. after a rescue) to reset any cached
  *  check information. Without this an incorrect crossing of a checkline
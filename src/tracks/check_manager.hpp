@@ -28,6 +28,7 @@
 class AbstractKart;
 class CheckStructure;
 class Flyable;
+class StateBuffer;
 class Track;
 class XMLNode;
 class Vec3;
@@ -48,6 +49,8 @@ public:
     void   load(const XMLNode &node);
     void   update(float dt);
     void   reset(const Track &track);
+    void   saveState(StateBuffer *buffer) const;
+    void   restoreState(StateBuffer *buffer);
     void   resetAfterKartMove(AbstractKart *kart);
     unsigned int getLapLineIndex() const;
     int    getChecklineTriggering(const Vec3 &from, const Vec3 &to) const;
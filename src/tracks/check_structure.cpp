@@ -27,6 +27,7 @@
 #include "tracks/check_lap.hpp"
 #include "tracks/check_manager.hpp"
 #include "tracks/track.hpp"
+#include "utils/state_buffer.hpp"
 
 #include <algorithm>
 
@@ -103,6 +104,28 @@ void CheckStructure::reset(const Track &track)
     }   // for i<getNumKarts
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the per kart activation state and previous positions. */
+void CheckStructure::saveState(StateBuffer *buffer) const
+{
+    for (unsigned int i = 0; i < m_is_active.size(); i++)
+    {
+        buffer->add<bool>(m_is_active[i]);
+        buffer->addVec3(m_previous_position[i]);
+    }
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void CheckStructure::restoreState(StateBuffer *buffer)
+{
+    for (unsigned int i = 0; i < m_is_active.size(); i++)
+    {
+        m_is_active[i]         = buffer->get<bool>();
+        m_previous_position[i] = buffer->getVec3();
+    }
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Updates all check structures. Called one per time step.
  *  \param dt Time since last call.
@@ -25,6 +25,7 @@
 #include "utils/vec3.hpp"
 
 class CheckManager;
+class StateBuffer;
 class Track;
 class XMLNode;
 
@@ -121,6 +122,8 @@ public:
                              int indx)=0;
     virtual void trigger(unsigned int kart_index);
     virtual void reset(const Track &track);
+    virtual void saveState(StateBuffer *buffer) const;
+    virtual void restoreState(StateBuffer *buffer);
 
     // ------------------------------------------------------------------------
     /** Returns the type of this check structure. */
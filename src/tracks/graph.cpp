@@ -31,10 +31,14 @@
 #include "tracks/track.hpp"
 #include "utils/log.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 const int Graph::UNKNOWN_SECTOR = -1;
 const float Graph::MIN_HEIGHT_TESTING = -1.0f;
 const float Graph::MAX_HEIGHT_TESTING = 5.0f;
-Graph *Graph::m_graph = NULL;
+Graph *Graph::m_graph[STK_MAX_PROCESS_SLOTS] = {};
 // -----------------------------------------------------------------------------
 Graph::Graph()
 {
@@ -46,6 +50,9 @@ Graph::Graph()
     m_bb_min      = Vec3( 99999,  99999,  99999);
     m_bb_max      = Vec3(-99999, -99999, -99999);
     memset(m_bb_nodes, 0, 4 * sizeof(int));
+    m_grid_min_x = m_grid_min_z = 0.0f;
+    m_grid_cell_size = 1.0f;
+    m_grid_width = m_grid_height = 0;
 }  // Graph
 
 // -----------------------------------------------------------------------------
@@ -481,6 +488,34 @@ void Graph::findRoadSector(const Vec3& xyz, int *sector,
     // the current one
     int indx       = *sector;
 
+    // Without a list of sectors only the quads in the grid cell of xyz
+    // need to be tested. Of all quads containing xyz the first one in the
+    // order of the linear search below is used.
+    if (!all_sectors && !m_grid_start.empty())
+    {
+        const int n = (int)m_all_nodes.size();
+        *sector = UNKNOWN_SECTOR;
+        const float fx = (xyz.getX() - m_grid_min_x) / m_grid_cell_size;
+        const float fz = (xyz.getZ() - m_grid_min_z) / m_grid_cell_size;
+        if (!(fx >= 0.0f && fx < (float)m_grid_width &&
+              fz >= 0.0f && fz < (float)m_grid_height))
+            return;
+        const int cell = (int)fz * m_grid_width + (int)fx;
+        int best_order = n;
+        for (int k = m_grid_start[cell]; k < m_grid_start[cell + 1]; k++)
+        {
+            const int i = m_grid_quads[k];
+            const int order = (i - indx - 1 + n) % n;
+            if (order < best_order &&
+                m_all_nodes[i]->pointInside(xyz, ignore_vertical))
+            {
+                *sector    = i;
+                best_order = order;
+            }
+        }
+        return;
+    }
+
     // If a current sector is given, and max_lookahead is specify, only test
     // the next max_lookahead quads instead of testing the whole graph.
     // This is necessary for the AI: if the track contains a loop, e.g.:
@@ -567,6 +602,13 @@ int Graph::findOutOfRoadSector(const Vec3& xyz, const int curr_sector,
         if(current_sector<0) current_sector += getNumNodes();
     }
 
+    if (!all_sectors && !m_grid_start.empty() &&
+        std::isfinite(xyz.getX()) && std::isfinite(xyz.getZ()))
+    {
+        return findOutOfRoadSectorInGrid(xyz, current_sector,
+                                         ignore_vertical);
+    }
+
     int   min_sector = UNKNOWN_SECTOR;
     float min_dist_2 = 999999.0f*999999.0f;
 
@@ -622,6 +664,201 @@ int Graph::findOutOfRoadSector(const Vec3& xyz, const int curr_sector,
     return 0;
 }   // findOutOfRoadSector
 
+//-----------------------------------------------------------------------------
+/** Tests all quads of one grid cell for findOutOfRoadSectorInGrid(). The
+ *  two entries of the best_* arrays correspond to the two phases of
+ *  findOutOfRoadSector(): index 0 only accepts quads that pass the height
+ *  test, index 1 accepts any quad. Ties in distance are broken like in the
+ *  linear search, i.e. the quad tested first (lowest order) wins.
+ */
+void Graph::visitGridCell(int cell, const Vec3 &xyz, int start,
+                          bool ignore_vertical, int *best_sector,
+                          float *best_dist_2, int *best_order) const
+{
+    const int n = (int)m_all_nodes.size();
+    for (int k = m_grid_start[cell]; k < m_grid_start[cell + 1]; k++)
+    {
+        const int i = m_grid_quads[k];
+        const Quad* q = m_all_nodes[i];
+        if (q->isIgnored())
+            continue;
+        const float dist_2 = q->getDistance2FromPoint(xyz);
+        const int order = (i - start - 1 + n) % n;
+        const float dist = xyz.getY() - q->getMinHeight();
+        const bool height_ok = (dist < 5.0f && dist > -1.0f) ||
+                               q->is3DQuad() || ignore_vertical;
+        for (int phase = height_ok ? 0 : 1; phase < 2; phase++)
+        {
+            if (dist_2 < best_dist_2[phase] ||
+                (dist_2 == best_dist_2[phase] && order < best_order[phase]))
+            {
+                best_sector[phase] = i;
+                best_dist_2[phase] = dist_2;
+                best_order[phase]  = order;
+            }
+        }
+    }
+}   // visitGridCell
+
+//-----------------------------------------------------------------------------
+/** Grid based version of findOutOfRoadSector() without a list of sectors.
+ *  The grid cells are visited in rings of increasing distance around xyz.
+ *  Since the centre line of a quad is inside its 2d bounding box, all quads
+ *  not found after ring r are at least r cell sizes away, so the search can
+ *  stop as soon as a quad closer than that (which passes the height test)
+ *  is found.
+ *  \param start The sector before the first sector tested by the linear
+ *         search, used to break ties the same way.
+ */
+int Graph::findOutOfRoadSectorInGrid(const Vec3 &xyz, int start,
+                                     bool ignore_vertical) const
+{
+    const float max_dist_2 = 999999.0f*999999.0f;
+    int   best_sector[2] = { UNKNOWN_SECTOR, UNKNOWN_SECTOR };
+    float best_dist_2[2] = { max_dist_2, max_dist_2 };
+    int   best_order[2]  = { (int)m_all_nodes.size(),
+                             (int)m_all_nodes.size() };
+
+    // Cell of xyz, which can be outside of the grid.
+    const float fx = std::floor((xyz.getX() - m_grid_min_x) / m_grid_cell_size);
+    const float fz = std::floor((xyz.getZ() - m_grid_min_z) / m_grid_cell_size);
+    const float limit = 1.0e6f;
+    const int cx = (int)std::max(-limit, std::min(limit, fx));
+    const int cz = (int)std::max(-limit, std::min(limit, fz));
+
+    // First ring that touches the grid, and the ring that covers all of it.
+    const int r_min = std::max(0, std::max(std::max(-cx, cx - m_grid_width  + 1),
+                                           std::max(-cz, cz - m_grid_height + 1)));
+    const int r_max = std::max(std::max(cx, m_grid_width  - 1 - cx),
+                               std::max(cz, m_grid_height - 1 - cz));
+    for (int r = r_min; r <= r_max; r++)
+    {
+        for (int z = std::max(cz - r, 0);
+             z <= std::min(cz + r, m_grid_height - 1); z++)
+        {
+            // Inner rows only contain the first and last cell of the ring.
+            const int step = (z == cz - r || z == cz + r) ? 1 : 2 * r;
+            for (int x = cx - r; x <= cx + r; x += step)
+            {
+                if (x < 0 || x >= m_grid_width)
+                    continue;
+                visitGridCell(z * m_grid_width + x, xyz, start,
+                              ignore_vertical, best_sector, best_dist_2,
+                              best_order);
+            }
+        }
+        const float covered = r * m_grid_cell_size;
+        if (best_sector[0] != UNKNOWN_SECTOR &&
+            best_dist_2[0] < covered * covered)
+            return best_sector[0];
+    }
+
+    if (best_sector[0] != UNKNOWN_SECTOR)
+        return best_sector[0];
+    if (best_sector[1] != UNKNOWN_SECTOR)
+        return best_sector[1];
+    Log::warn("Graph", "unknown sector found.");
+    return 0;
+}   // findOutOfRoadSectorInGrid
+
+//-----------------------------------------------------------------------------
+/** Builds the uniform grid used by findRoadSector() and
+ *  findOutOfRoadSector(). Must be called once all quads are created. The
+ *  cell size is the average 2d size of the quads, so each cell usually
+ *  contains only a few quads.
+ */
+void Graph::buildGrid()
+{
+    m_grid_start.clear();
+    m_grid_quads.clear();
+    const int n = (int)m_all_nodes.size();
+    if (n == 0)
+        return;
+
+    // 2d bounding box (min x, min z, max x, max z) of each quad. 3d quads
+    // test points in a box that extends up to 5 units along the normal of
+    // the quad (see BoundingBox3D), so their box is enlarged.
+    std::vector<float> bounds(4 * n);
+    float min_x =  std::numeric_limits<float>::max(), min_z = min_x;
+    float max_x = -std::numeric_limits<float>::max(), max_z = max_x;
+    float total_size = 0.0f;
+    for (int i = 0; i < n; i++)
+    {
+        const Quad &q = *m_all_nodes[i];
+        float *b = &bounds[4 * i];
+        b[0] = b[2] = q[0].getX();
+        b[1] = b[3] = q[0].getZ();
+        for (int j = 1; j < 4; j++)
+        {
+            b[0] = std::min(b[0], q[j].getX());
+            b[1] = std::min(b[1], q[j].getZ());
+            b[2] = std::max(b[2], q[j].getX());
+            b[3] = std::max(b[3], q[j].getZ());
+        }
+        if (q.is3DQuad())
+        {
+            b[0] -= 5.0f; b[1] -= 5.0f;
+            b[2] += 5.0f; b[3] += 5.0f;
+        }
+        min_x = std::min(min_x, b[0]);
+        min_z = std::min(min_z, b[1]);
+        max_x = std::max(max_x, b[2]);
+        max_z = std::max(max_z, b[3]);
+        total_size += std::max(b[2] - b[0], b[3] - b[1]);
+    }
+
+    // Limit the number of cells in case of a few very small quads on a
+    // large track.
+    const size_t max_cells = std::max((size_t)4096, (size_t)16 * n);
+    m_grid_cell_size = std::max(total_size / n, 1.0f);
+    for (;;)
+    {
+        m_grid_width  = (int)((max_x - min_x) / m_grid_cell_size) + 1;
+        m_grid_height = (int)((max_z - min_z) / m_grid_cell_size) + 1;
+        if ((size_t)m_grid_width * m_grid_height <= max_cells)
+            break;
+        m_grid_cell_size *= 2.0f;
+    }
+    m_grid_min_x = min_x;
+    m_grid_min_z = min_z;
+
+    // Sort the quad indices into the cells, first counting the number of
+    // quads per cell.
+    m_grid_start.assign(m_grid_width * m_grid_height + 1, 0);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        std::vector<int> cursor;
+        if (pass == 1)
+        {
+            for (unsigned int c = 1; c < m_grid_start.size(); c++)
+                m_grid_start[c] += m_grid_start[c - 1];
+            m_grid_quads.resize(m_grid_start.back());
+            cursor.assign(m_grid_start.begin(), m_grid_start.end() - 1);
+        }
+        for (int i = 0; i < n; i++)
+        {
+            const float *b = &bounds[4 * i];
+            const int x0 = (int)((b[0] - min_x) / m_grid_cell_size);
+            const int z0 = (int)((b[1] - min_z) / m_grid_cell_size);
+            const int x1 = std::min((int)((b[2] - min_x) / m_grid_cell_size),
+                                    m_grid_width - 1);
+            const int z1 = std::min((int)((b[3] - min_z) / m_grid_cell_size),
+                                    m_grid_height - 1);
+            for (int z = z0; z <= z1; z++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    const int cell = z * m_grid_width + x;
+                    if (pass == 0)
+                        m_grid_start[cell + 1]++;
+                    else
+                        m_grid_quads[cursor[cell]++] = i;
+                }
+            }
+        }
+    }
+}   // buildGrid
+
 //-----------------------------------------------------------------------------
 void Graph::loadBoundingBoxNodes()
 {
@@ -20,6 +20,7 @@
 #define HEADER_GRAPH_HPP
 
 #include "utils/no_copy.hpp"
+#include "utils/stk_process.hpp"
 #include "utils/vec3.hpp"
 
 #include <dimension2d.h>
@@ -52,7 +53,7 @@ class RenderTarget;
 class Graph : public NoCopy
 {
 protected:
-    static Graph* m_graph;
+    static Graph* m_graph[STK_MAX_PROCESS_SLOTS];
 
     std::vector<Quad*> m_all_nodes;
 
@@ -66,6 +67,8 @@ protected:
     // ------------------------------------------------------------------------
     /** Map 4 bounding box points to 4 closest graph nodes. */
     void loadBoundingBoxNodes();
+    // ------------------------------------------------------------------------
+    void buildGrid();
 
 private:
     /** The 2d bounding box, used for hashing. */
@@ -75,6 +78,23 @@ private:
     /** The 4 closest graph nodes to the bounding box. */
     int m_bb_nodes[4];
 
+    /** A uniform 2d grid (in x/z) over all quads, used to speed up
+     *  findRoadSector() and findOutOfRoadSector(). Cell i contains the
+     *  quad indices m_grid_quads[m_grid_start[i]] up to (excluding)
+     *  m_grid_quads[m_grid_start[i+1]], which are all quads whose 2d
+     *  bounding box overlaps the cell. Empty if no grid was built. */
+    std::vector<int> m_grid_start;
+    std::vector<int> m_grid_quads;
+
+    /** Minimum x and z coordinate of the grid. */
+    float m_grid_min_x, m_grid_min_z;
+
+    /** Side length of a grid cell. */
+    float m_grid_cell_size;
+
+    /** Number of grid cells in x and z direction. */
+    int m_grid_width, m_grid_height;
+
     /** The node of the graph mesh. */
     scene::ISceneNode *m_node;
 
@@ -106,6 +126,13 @@ private:
     virtual bool hasLapLine() const = 0;
     // ------------------------------------------------------------------------
     virtual void differentNodeColor(int n, video::SColor* c) const = 0;
+    // ------------------------------------------------------------------------
+    void visitGridCell(int cell, const Vec3 &xyz, int start,
+                       bool ignore_vertical, int *best_sector,
+                       float *best_dist_2, int *best_order) const;
+    // ------------------------------------------------------------------------
+    int findOutOfRoadSectorInGrid(const Vec3 &xyz, int start,
+                                  bool ignore_vertical) const;
 
 public:
     static const int UNKNOWN_SECTOR;
@@ -116,13 +143,13 @@ public:
     /** Returns the one instance of this object. It is possible that there
      *  is no instance created (e.g. arena without navmesh) so we don't assert
      *  that an instance exist. */
-    static Graph* get() { return m_graph; }
+    static Graph* get() { return m_graph[STKProcess::getSlot()]; }
     // ------------------------------------------------------------------------
     /** Set the graph (either drive or arena graph for now). */
     static void setGraph(Graph* graph)
     {
-        assert(m_graph == NULL);
-        m_graph = graph;
+        assert(m_graph[STKProcess::getSlot()] == NULL);
+        m_graph[STKProcess::getSlot()] = graph;
     }   // setGraph
     // ------------------------------------------------------------------------
     /** Cleans up the graph. It is possible that this function is called even
@@ -130,13 +157,24 @@ public:
      *  error if there is no instance. */
     static void destroy()
     {
-        if (m_graph)
+        Graph*& graph = m_graph[STKProcess::getSlot()];
+        if (graph)
         {
-            delete m_graph;
-            m_graph = NULL;
+            delete graph;
+            graph = NULL;
         }
     }   // destroy
     // ------------------------------------------------------------------------
+    /** Removes the graph of this process slot without deleting it, e.g.
+     *  to keep it in the TrackCache. Returns the graph (can be NULL). */
+    static Graph* release()
+    {
+        Graph*& graph = m_graph[STKProcess::getSlot()];
+        Graph* released = graph;
+        graph = NULL;
+        return released;
+    }   // release
+    // ------------------------------------------------------------------------
     Graph();
     // ------------------------------------------------------------------------
     virtual ~Graph();
@@ -92,7 +92,7 @@ using namespace irr;
 
 const float Track::NOHIT               = -99999.9f;
 bool        Track::m_dont_load_navmesh = false;
-std::atomic<Track*> Track::m_current_track[PT_COUNT];
+std::atomic<Track*> Track::m_current_track[STK_MAX_PROCESS_SLOTS];
 
 // ----------------------------------------------------------------------------
 Track::Track(const std::string &filename)
@@ -118,6 +118,7 @@ Track::Track(const std::string &filename)
     m_screenshot            = "";
     m_version               = 0;
     m_track_mesh            = NULL;
+    m_assets_from_cache     = false;
     m_gfx_effect_mesh       = NULL;
     m_internal              = false;
     m_enable_auto_rescue    = true;  // Below set to false in arenas
@@ -232,6 +233,7 @@ bool Track::isInGroup(const std::string &group_name)
 void Track::removeCachedData()
 {
     m_materials_loaded = false;
+    m_prefetched_textures.clear();
 }   // cleanCachedData
 
 //-----------------------------------------------------------------------------
@@ -265,7 +267,11 @@ void Track::cleanup()
     file_manager->popTextureSearchPath();
     file_manager->popModelSearchPath();
 
-    Graph::destroy();
+    // A cached graph is owned by the TrackCache
+    if (m_cache_key.empty())
+        Graph::destroy();
+    else
+        Graph::release();
     m_item_manager = nullptr;
 #ifndef SERVER_ONLY
     if (CVS->isGLSL())
@@ -314,11 +320,24 @@ void Track::cleanup()
     if (CVS->isGLSL())
         m_sun->drop();
 #endif
-    delete m_track_mesh;
+    if (m_cache_key.empty())
+    {
+        delete m_track_mesh;
+        delete m_gfx_effect_mesh;
+    }
+    else
+    {
+        // Keep the collision shapes (and their BVH) for the next race on
+        // this track, only the rigid body belongs to this race's physics.
+        if (m_cache_assets.m_track_mesh)
+            m_cache_assets.m_track_mesh->removeBody();
+        TrackCache::checkin(m_cache_key, m_cache_assets);
+        m_cache_key.clear();
+        m_cache_assets = TrackCache::Assets();
+    }
     m_track_mesh = NULL;
-
-    delete m_gfx_effect_mesh;
     m_gfx_effect_mesh = NULL;
+    m_assets_from_cache = false;
 
 #ifndef SERVER_ONLY
     if (CVS->isGLSL())
@@ -382,6 +401,7 @@ void Track::cleanup()
     {
         // remove temporary materials loaded by the material manager
         material_manager->popTempMaterial();
+        m_prefetched_textures.clear();
     }
 
 #ifndef SERVER_ONLY
@@ -412,7 +432,7 @@ void Track::cleanup()
     m_meta_library.clear();
     Scripting::ScriptEngine::getInstance()->cleanupCache();
 
-    m_current_track[PT_MAIN] = NULL;
+    m_current_track[STKProcess::getSlot()] = NULL;
 }   // cleanup
 
 //-----------------------------------------------------------------------------
@@ -677,9 +697,11 @@ void Track::createPhysicsModel(unsigned int main_track_count)
 
     // Now convert all objects that are only used for the physics
     // (like invisible walls).
+    // Cached meshes already contain all triangles and collision shapes.
     for (unsigned int i = 0; i<m_static_physics_only_nodes.size(); i++)
     {
-        convertTrackToBullet(m_static_physics_only_nodes[i]);
+        if (!m_assets_from_cache)
+            convertTrackToBullet(m_static_physics_only_nodes[i]);
         m_static_physics_only_nodes[i]->setVisible(false);
         m_static_physics_only_nodes[i]->grab();
         irr_driver->removeNode(m_static_physics_only_nodes[i]);
@@ -687,23 +709,93 @@ void Track::createPhysicsModel(unsigned int main_track_count)
 
     for (unsigned int i = 0; i<m_object_physics_only_nodes.size(); i++)
     {
-        convertTrackToBullet(m_object_physics_only_nodes[i]);
+        if (!m_assets_from_cache)
+            convertTrackToBullet(m_object_physics_only_nodes[i]);
         m_object_physics_only_nodes[i]->setVisible(false);
         m_object_physics_only_nodes[i]->grab();
         irr_driver->removeNode(m_object_physics_only_nodes[i]);
     }
 
-    m_track_mesh->removeAll();
-    m_gfx_effect_mesh->removeAll();
+    if (!m_assets_from_cache)
+    {
+        m_track_mesh->removeAll();
+        m_gfx_effect_mesh->removeAll();
+    }
     for(unsigned int i=main_track_count; i<m_all_nodes.size(); i++)
     {
-        convertTrackToBullet(m_all_nodes[i]);
+        if (!m_assets_from_cache)
+            convertTrackToBullet(m_all_nodes[i]);
         uploadNodeVertexBuffer(m_all_nodes[i]);
     }
-    m_track_mesh->createPhysicalBody(m_friction);
-    m_gfx_effect_mesh->createCollisionShape();
+    if (m_assets_from_cache)
+    {
+        m_track_mesh->createPhysicalBody(m_friction);
+    }
+    else
+    {
+        // Building the BVHs is the slowest part, so they are saved to and
+        // loaded from the cache directory.
+        const uint64_t track_hash = m_track_mesh->computeHash();
+        const std::string track_bvh = getBvhFile("track", track_hash);
+        const bool track_bvh_cached = file_manager->fileExists(track_bvh);
+        m_track_mesh->createPhysicalBody(m_friction,
+            (btCollisionObject::CollisionFlags)0, track_bvh.c_str(),
+            track_hash);
+        const uint64_t gfx_hash = m_gfx_effect_mesh->computeHash();
+        const std::string gfx_bvh = getBvhFile("gfx", gfx_hash);
+        const bool gfx_bvh_cached = file_manager->fileExists(gfx_bvh);
+        m_gfx_effect_mesh->createCollisionShape(true, gfx_bvh.c_str(),
+                                                gfx_hash);
+        // A new file means the track changed, the BVHs of the old version
+        // are not used anymore.
+        if (!track_bvh_cached)
+            removeStaleBvhFiles("track", track_bvh);
+        if (!gfx_bvh_cached)
+            removeStaleBvhFiles("gfx", gfx_bvh);
+    }
 }   // createPhysicsModel
 
+// -----------------------------------------------------------------------------
+/** Returns the name of the file the BVH of a collision mesh of this track
+ *  is cached in. The name contains a hash of the mesh, so modified tracks
+ *  (or different versions of an add-on) do not overwrite each other.
+ *  \param name Name of the mesh, e.g. "track".
+ *  \param hash TriangleMesh::computeHash() of the mesh.
+ */
+std::string Track::getBvhFile(const std::string &name, uint64_t hash) const
+{
+    char hash_string[32];
+    sprintf(hash_string, "%016llx", (unsigned long long)hash);
+    return file_manager->getCachedTexturesDir() + m_ident + "-" + name +
+           "-" + hash_string + ".bvh";
+}   // getBvhFile
+
+// -----------------------------------------------------------------------------
+/** Removes the cached BVH files of a collision mesh of this track that were
+ *  written for other versions of the mesh (see getBvhFile()).
+ *  \param name Name of the mesh, e.g. "track".
+ *  \param keep The file of the current version of the mesh.
+ */
+void Track::removeStaleBvhFiles(const std::string &name,
+                                const std::string &keep) const
+{
+    const std::string dir = file_manager->getCachedTexturesDir();
+    const std::string prefix = m_ident + "-" + name + "-";
+    // The prefix is followed by the 16 digits of the hash
+    const size_t length = prefix.size() + 16 + 4;
+    std::set<std::string> files;
+    file_manager->listFiles(files, dir);
+    for (const std::string &file : files)
+    {
+        if (file.size() != length ||
+            !StringUtils::startsWith(file, prefix) ||
+            file.compare(length - 4, 4, ".bvh") != 0 || dir + file == keep)
+            continue;
+        Log::info("Track", "Removing outdated BVH file '%s'.", file.c_str());
+        file_manager->removeFile(dir + file);
+    }
+}   // removeStaleBvhFiles
+
 // -----------------------------------------------------------------------------
 
 
@@ -947,8 +1039,16 @@ bool Track::loadMainTrack(const XMLNode &root)
     assert(m_track_mesh==NULL);
     assert(m_gfx_effect_mesh==NULL);
 
-    m_track_mesh      = new TriangleMesh(/*can_be_transformed*/false);
-    m_gfx_effect_mesh = new TriangleMesh(/*can_be_transformed*/false);
+    if (m_assets_from_cache)
+    {
+        m_track_mesh      = m_cache_assets.m_track_mesh;
+        m_gfx_effect_mesh = m_cache_assets.m_gfx_effect_mesh;
+    }
+    else
+    {
+        m_track_mesh      = new TriangleMesh(/*can_be_transformed*/false);
+        m_gfx_effect_mesh = new TriangleMesh(/*can_be_transformed*/false);
+    }
 	auto ri = std::make_shared<RenderInfo>(0.f, false, makeObjectId(ObjectType::OT_BACKGROUND,0));
 
     const XMLNode *track_node = root.getNode("track");
@@ -1141,7 +1241,8 @@ bool Track::loadMainTrack(const XMLNode &root)
     // This will (at this stage) only convert the main track model.
     for(unsigned int i=0; i<m_all_nodes.size(); i++)
     {
-        convertTrackToBullet(m_all_nodes[i]);
+        if (!m_assets_from_cache)
+            convertTrackToBullet(m_all_nodes[i]);
         uploadNodeVertexBuffer(m_all_nodes[i]);
     }
 
@@ -1150,7 +1251,8 @@ bool Track::loadMainTrack(const XMLNode &root)
         Log::fatal("track", "m_track_mesh == NULL, cannot loadMainTrack\n");
     }
 
-    m_gfx_effect_mesh->createCollisionShape();
+    if (!m_assets_from_cache)
+        m_gfx_effect_mesh->createCollisionShape();
     scene_node->setMaterialFlag(video::EMF_LIGHTING, true);
     scene_node->setMaterialFlag(video::EMF_GOURAUD_SHADING, true);
 
@@ -1436,7 +1538,7 @@ static void recursiveUpdatePhysics(std::vector<TrackObject*>& tos)
  */
 void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
 {
-    assert(m_current_track[PT_MAIN].load() == NULL);
+    assert(m_current_track[STKProcess::getSlot()].load() == NULL);
 
     // Use m_filename to also get the path, not only the identifier
     STKTexManager::getInstance()
@@ -1466,6 +1568,7 @@ void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
 #endif
 
     // First read the temporary materials.xml file if it exists
+    const unsigned int first_material = material_manager->getNumMaterials();
     try
     {
         std::string materials_file = m_root+"materials.xml";
@@ -1483,6 +1586,14 @@ void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
         // no temporary materials.xml file, ignore
         (void)e;
     }
+    // Decode the textures of the new materials in parallel before the
+    // geometry requests them one by one. Nothing is added if the materials
+    // of a cached track are still loaded, so keep the old textures then.
+    if (material_manager->getNumMaterials() > first_material)
+    {
+        m_prefetched_textures =
+            material_manager->prefetchTextures(first_material);
+    }
 
     // Start building the scene graph
     // Soccer field with navmesh requires it
@@ -1500,8 +1611,22 @@ void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
         throw std::runtime_error(msg.str());
     }
 
-    m_current_track[PT_MAIN] = this;
-    m_current_track[PT_CHILD] = NULL;
+    m_current_track[STKProcess::getSlot()] = this;
+    if (STKProcess::getSlot() == PT_MAIN)
+        m_current_track[PT_CHILD] = NULL;
+
+    // The graph and collision meshes only depend on the track, the mode,
+    // the direction and the race mode (which decides e.g. if checkline
+    // requirements are computed), so they can be reused from an earlier
+    // race. The drive graph reads the direction from the race manager, and
+    // reverse_track only differs from it for tracks without reverse mode.
+    std::string cache_key = StringUtils::insertValues("%s|%d|%d|%d",
+        m_filename.c_str(), mode_id,
+        (int)RaceManager::get()->getReverseTrack(),
+        (int)RaceManager::get()->getMinorMode());
+    m_assets_from_cache = TrackCache::checkout(cache_key, &m_cache_assets);
+    if (m_assets_from_cache)
+        m_cache_key = cache_key;
 
     // Load the graph only now: this function is called from world, after
     // the race gui was created. The race gui is needed since it stores
@@ -1525,7 +1650,12 @@ void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
         }   // for i<root->getNumNodes()
     }
 
-    if (!m_is_arena && !m_is_soccer && !m_is_cutscene) 
+    if (m_assets_from_cache)
+    {
+        if (m_cache_assets.m_graph)
+            Graph::setGraph(m_cache_assets.m_graph);
+    }
+    else if (!m_is_arena && !m_is_soccer && !m_is_cutscene)
         loadDriveGraph(mode_id, reverse_track);
     else if ((m_is_arena || m_is_soccer) && !m_is_cutscene && m_has_navmesh)
         loadArenaGraph(*root);
@@ -1827,11 +1957,20 @@ void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
     }
 
     World *world = World::getWorld();
-    if (world->useChecklineRequirements())
+    if (world->useChecklineRequirements() && !m_assets_from_cache)
     {
         DriveGraph::get()->computeChecklineRequirements();
     }
 
+    // All static data is built now, keep it for the next race.
+    if (!m_assets_from_cache)
+    {
+        m_cache_key                      = cache_key;
+        m_cache_assets.m_graph           = Graph::get();
+        m_cache_assets.m_track_mesh      = m_track_mesh;
+        m_cache_assets.m_gfx_effect_mesh = m_gfx_effect_mesh;
+    }
+
     EasterEggHunt *easter_world = dynamic_cast<EasterEggHunt*>(world);
     if(easter_world)
     {
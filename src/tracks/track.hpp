@@ -38,6 +38,7 @@ using namespace irr;
 
 #include "LinearMath/btTransform.h"
 
+#include "tracks/track_cache.hpp"
 #include "utils/aligned_array.hpp"
 #include "utils/log.hpp"
 #include "utils/vec3.hpp"
@@ -62,6 +63,11 @@ class TrackObjectManager;
 class TriangleMesh;
 class XMLNode;
 
+namespace SP
+{
+    class SPTexture;
+}
+
 /**
   * \ingroup tracks
   */
@@ -71,7 +77,7 @@ private:
 
     /** If a race is in progress, this stores the active track object.
      *  NULL otherwise. */
-    static std::atomic<Track*> m_current_track[PT_COUNT];
+    static std::atomic<Track*> m_current_track[STK_MAX_PROCESS_SLOTS];
 
 #ifdef DEBUG
     unsigned int             m_magic_number;
@@ -134,6 +140,11 @@ private:
      * for the overworld to keep its textures loaded. */
     bool m_materials_loaded;
 
+    /** Textures of this track's materials loaded in parallel before the
+     *  geometry. They are kept as long as the materials are loaded, so that
+     *  textures which no mesh uses yet are not freed after the first race. */
+    std::vector<std::shared_ptr<SP::SPTexture> > m_prefetched_textures;
+
     /** True if this track (textures and track data) should be cached. Used
      *  for the overworld. */
     bool m_cache_track;
@@ -162,6 +173,15 @@ private:
      *  allowing the kart to drive in/partly under water), but the
      *  actual surface position is needed for the water splash effect. */
     TriangleMesh*            m_gfx_effect_mesh;
+    /** Key of this track (and mode, direction and race mode) in the
+     *  TrackCache. Empty if the graph and meshes are not cached. */
+    std::string              m_cache_key;
+    /** The graph and meshes that are checked in to the TrackCache at
+     *  cleanup time. */
+    TrackCache::Assets       m_cache_assets;
+    /** True if the graph and meshes were taken from the TrackCache, in
+     *  which case they are not built again. */
+    bool                     m_assets_from_cache;
     /** Minimum coordinates of this track. */
     Vec3                     m_aabb_min;
     /** Maximum coordinates of this track. */
@@ -359,14 +379,29 @@ private:
     void handleSky(const XMLNode &root, const std::string &filename);
     void freeCachedMeshVertexBuffer();
     void copyFromMainProcess();
+    std::string getBvhFile(const std::string &name, uint64_t hash) const;
+    void removeStaleBvhFiles(const std::string &name,
+                             const std::string &keep) const;
 public:
 
     /** Static function to get the current track. NULL if no current
      *  track is defined (i.e. no race is active atm) */
     static Track* getCurrentTrack()
     {
-        ProcessType type = STKProcess::getType();
-        return m_current_track[type];
+        unsigned int slot = STKProcess::getSlot();
+        return m_current_track[slot];
+    }
+    // ------------------------------------------------------------------------
+    /** Returns true if the given track is the current track of any
+     *  simulation slot. */
+    static bool isLoadedInAnySlot(const Track* track)
+    {
+        for (unsigned int i = 0; i < STK_MAX_PROCESS_SLOTS; i++)
+        {
+            if (m_current_track[i] == track)
+                return true;
+        }
+        return false;
     }
     // ------------------------------------------------------------------------
     Track* clone()
@@ -0,0 +1,146 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2020 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "tracks/track_cache.hpp"
+
+#include "physics/triangle_mesh.hpp"
+#include "tracks/graph.hpp"
+
+std::multimap<std::string, TrackCache::Entry> TrackCache::m_entries;
+std::mutex    TrackCache::m_mutex;
+unsigned int  TrackCache::m_max_entries = 8;
+unsigned long TrackCache::m_use_counter = 0;
+
+// ----------------------------------------------------------------------------
+/** Takes an unused entry with the given key out of the cache.
+ *  \param key The key of the track, built from the track, mode, direction
+ *         and race mode in Track::loadTrackModel().
+ *  \param assets On success the cached assets, which now belong to the
+ *         caller until they are checked in again.
+ *  \return True if an entry was found.
+ */
+bool TrackCache::checkout(const std::string &key, Assets *assets)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto range = m_entries.equal_range(key);
+    for (auto it = range.first; it != range.second; it++)
+    {
+        if (it->second.m_in_use)
+            continue;
+        it->second.m_in_use = true;
+        *assets = it->second.m_assets;
+        return true;
+    }
+    return false;
+}   // checkout
+
+// ----------------------------------------------------------------------------
+/** Returns assets to the cache once a race is done with them. Assets that
+ *  were checked out before are marked as unused again, new assets are added
+ *  to the cache. If the cache is disabled the assets are deleted.
+ *  The physical body of the track mesh must already be removed.
+ *  \param key The key of the track.
+ *  \param assets The assets to cache.
+ */
+void TrackCache::checkin(const std::string &key, const Assets &assets)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto range = m_entries.equal_range(key);
+    auto it = range.first;
+    for (; it != range.second; it++)
+    {
+        if (it->second.m_assets.m_track_mesh == assets.m_track_mesh)
+            break;
+    }
+    if (it == range.second)
+    {
+        if (m_max_entries == 0)
+        {
+            deleteAssets(assets);
+            return;
+        }
+        Entry entry;
+        entry.m_assets = assets;
+        it = m_entries.insert(std::make_pair(key, entry));
+    }
+    it->second.m_in_use    = false;
+    it->second.m_last_used = ++m_use_counter;
+    evict();
+}   // checkin
+
+// ----------------------------------------------------------------------------
+/** Deletes the least recently used unused entries until at most
+ *  m_max_entries are cached. Entries in use are never evicted, so the cache
+ *  can temporarily be larger than the limit. Must be called with m_mutex
+ *  locked.
+ */
+void TrackCache::evict()
+{
+    while (m_entries.size() > m_max_entries)
+    {
+        auto oldest = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+        {
+            if (it->second.m_in_use)
+                continue;
+            if (oldest == m_entries.end() ||
+                it->second.m_last_used < oldest->second.m_last_used)
+                oldest = it;
+        }
+        if (oldest == m_entries.end())
+            return;
+        deleteAssets(oldest->second.m_assets);
+        m_entries.erase(oldest);
+    }
+}   // evict
+
+// ----------------------------------------------------------------------------
+void TrackCache::deleteAssets(const Assets &assets)
+{
+    delete assets.m_graph;
+    delete assets.m_track_mesh;
+    delete assets.m_gfx_effect_mesh;
+}   // deleteAssets
+
+// ----------------------------------------------------------------------------
+/** Deletes all entries that are not in use. */
+void TrackCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (it->second.m_in_use)
+        {
+            it++;
+            continue;
+        }
+        deleteAssets(it->second.m_assets);
+        it = m_entries.erase(it);
+    }
+}   // clear
+
+// ----------------------------------------------------------------------------
+/** Sets the maximum number of cached entries and evicts entries if there
+ *  are more. 0 disables the cache.
+ */
+void TrackCache::setMaxEntries(unsigned int n)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_entries = n;
+    evict();
+}   // setMaxEntries
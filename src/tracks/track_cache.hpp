@@ -0,0 +1,99 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2020 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_TRACK_CACHE_HPP
+#define HEADER_TRACK_CACHE_HPP
+
+#include <map>
+#include <mutex>
+#include <string>
+
+class Graph;
+class TriangleMesh;
+
+/**
+ *  \brief Keeps the expensive, static parts of loaded tracks resident
+ *  between races.
+ *  When a track is cleaned up, its drive or arena graph and its collision
+ *  meshes (including the BVH) are checked into this cache instead of being
+ *  deleted. The next race on the same track, mode and direction checks them
+ *  out again, which skips rebuilding the graph and converting the track
+ *  into bullet triangles. Each entry is used by at most one race at a time,
+ *  so races running in parallel on the same track use separate copies.
+ *  Unused entries are evicted in least recently used order once more than
+ *  getMaxEntries() entries are cached.
+ * \ingroup tracks
+ */
+class TrackCache
+{
+public:
+    /** The cached data of a track. Any of the pointers can be NULL, e.g. an
+     *  arena without navmesh has no graph. */
+    struct Assets
+    {
+        Graph        *m_graph;
+        TriangleMesh *m_track_mesh;
+        TriangleMesh *m_gfx_effect_mesh;
+        Assets() : m_graph(NULL), m_track_mesh(NULL),
+                   m_gfx_effect_mesh(NULL) {}
+    };   // Assets
+
+private:
+    struct Entry
+    {
+        Assets        m_assets;
+        /** True while a race is using these assets. */
+        bool          m_in_use;
+        /** Value of m_use_counter when this entry was last checked in. */
+        unsigned long m_last_used;
+    };   // Entry
+
+    /** All cached entries, indexed by their key. The same key can be
+     *  cached more than once if several races used it at the same time. */
+    static std::multimap<std::string, Entry> m_entries;
+
+    /** Protects all static data, races in different slots can load and
+     *  clean up tracks at the same time. */
+    static std::mutex m_mutex;
+
+    /** Maximum number of cached entries, 0 disables the cache. */
+    static unsigned int m_max_entries;
+
+    /** Counter used to find the least recently used entry. */
+    static unsigned long m_use_counter;
+
+    static void deleteAssets(const Assets &assets);
+    static void evict();
+
+public:
+    static bool checkout(const std::string &key, Assets *assets);
+    static void checkin(const std::string &key, const Assets &assets);
+    static void clear();
+    static void setMaxEntries(unsigned int n);
+    // ------------------------------------------------------------------------
+    /** Returns the maximum number of cached entries. */
+    static unsigned int getMaxEntries()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_max_entries;
+    }   // getMaxEntries
+};   // TrackCache
+
+#endif
+
+/* EOF */
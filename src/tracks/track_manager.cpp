@@ -22,6 +22,7 @@
 #include "graphics/irr_driver.hpp"
 #include "io/file_manager.hpp"
 #include "tracks/track.hpp"
+#include "utils/stk_process.hpp"
 
 #include <algorithm>
 #include <iostream>
@@ -44,6 +45,8 @@ TrackManager::~TrackManager()
 {
     for(Tracks::iterator i = m_tracks.begin(); i != m_tracks.end(); ++i)
         delete *i;
+    for (auto& slot_track : m_slot_tracks)
+        delete slot_track.second;
 }   // ~TrackManager
 
 //-----------------------------------------------------------------------------
@@ -93,6 +96,39 @@ Track* TrackManager::getTrack(const std::string& ident) const
 
 }   // getTrack
 
+//-----------------------------------------------------------------------------
+/** Returns the track object the current simulation slot should race on.
+ *  A track object holds the loaded model, physics and item state of a race,
+ *  so if the shared object is already loaded by another slot, a private
+ *  object is created for this slot. It is freed by releaseSlotTrack().
+ *  \param ident Identifier = basename of the directory the track is in.
+ *  \return      The track object, or NULL if not found
+ */
+Track* TrackManager::getTrackForSlot(const std::string& ident)
+{
+    Track* track = getTrack(ident);
+    if (!track || !Track::isLoadedInAnySlot(track))
+        return track;
+
+    releaseSlotTrack();
+    Track* slot_track = new Track(track->getFilename());
+    m_slot_tracks[STKProcess::getSlot()] = slot_track;
+    return slot_track;
+}   // getTrackForSlot
+
+//-----------------------------------------------------------------------------
+/** Frees the private track object of the current simulation slot (if any),
+ *  called once its world was cleaned up.
+ */
+void TrackManager::releaseSlotTrack()
+{
+    auto it = m_slot_tracks.find(STKProcess::getSlot());
+    if (it == m_slot_tracks.end())
+        return;
+    delete it->second;
+    m_slot_tracks.erase(it);
+}   // releaseSlotTrack
+
 //-----------------------------------------------------------------------------
 /** Removes all cached data from all tracks. This is called when the screen
  *  resolution is changed and all textures need to be bound again.
@@ -43,6 +43,10 @@ private:
     /** All track objects. */
     Tracks                                   m_tracks;
 
+    /** Private track objects of simulation slots that race on a track whose
+     *  shared object in m_tracks is already used by another slot. */
+    std::map<unsigned int, Track*>           m_slot_tracks;
+
     typedef std::map<std::string, std::vector<int> > Group2Indices;
     /** List of all racing track groups. */
     Group2Indices                            m_track_groups;
@@ -84,6 +88,8 @@ public:
     void  removeAllCachedData();
     int   getNumberOfRaceTracks() const;
     Track* getTrack(const std::string& ident) const;
+    Track* getTrackForSlot(const std::string& ident);
+    void   releaseSlotTrack();
     // ------------------------------------------------------------------------
     /** Sets a list of track as being unavailable (e.g. in network mode the
      *  track is not on all connected machines.
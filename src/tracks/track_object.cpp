@@ -37,6 +37,7 @@
 #include "scriptengine/script_engine.hpp"
 #include "tracks/track.hpp"
 #include "tracks/model_definition_loader.hpp"
+#include "utils/state_buffer.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/objecttype.h"
 
@@ -84,6 +85,7 @@ TrackObject::TrackObject(const core::vector3df& xyz, const core::vector3df& hpr,
     m_is_driveable    = false;
     m_soccer_ball     = false;
     m_initially_visible = false;
+    m_created_in_race = true;
     m_type            = "";
     m_render_info     = std::make_shared<RenderInfo>(0.f, false, newObjectId(OT_PICKUP));
 
@@ -133,6 +135,7 @@ void TrackObject::init(const XMLNode &xml_node, scene::ISceneNode* parent,
     bool lod_instance = false;
     xml_node.get("lod_instance", &lod_instance);
 
+    m_created_in_race = false;
     m_soccer_ball = false;
     xml_node.get("soccer_ball", &m_soccer_ball);
     if (m_soccer_ball && m_render_info) {
@@ -475,6 +478,37 @@ void TrackObject::reset()
     if (m_physical_object) m_physical_object->reset();
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves if this object is enabled, and the state of its animation and
+ *  physical object.
+ *  \param buffer The buffer to append the state to.
+ */
+void TrackObject::saveState(StateBuffer *buffer) const
+{
+    buffer->add<bool>(m_enabled);
+    if (m_animator       ) m_animator->saveState(buffer);
+    if (m_physical_object) m_physical_object->saveState(buffer);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). Children are restored as
+ *  objects of their own, and the physical object restores its body, so
+ *  only the presentation of this object is enabled or disabled here.
+ *  \param buffer The buffer to read the state from.
+ */
+void TrackObject::restoreState(StateBuffer *buffer)
+{
+    const bool enabled = buffer->get<bool>();
+    if (enabled != m_enabled)
+    {
+        m_enabled = enabled;
+        if (m_presentation != NULL)
+            m_presentation->setEnable(m_enabled);
+    }
+    if (m_animator       ) m_animator->restoreState(buffer);
+    if (m_physical_object) m_physical_object->restoreState(buffer);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Enables or disables this object. This affects the visibility, i.e.
  *  disabled objects will not be displayed anymore.
@@ -553,6 +587,39 @@ void TrackObject::update(float dt)
     if (m_animator) m_animator->updateWithWorldTicks(true/*has_physics*/);
 }   // update
 
+// ----------------------------------------------------------------------------
+/** Returns a combination of UpdateCategory values describing which parts
+ *  of this object can change over time. This doesn't change after the
+ *  object is created, so the TrackObjectManager uses it to only update the
+ *  objects that are not static.
+ */
+unsigned int TrackObject::getUpdateCategories() const
+{
+    unsigned int categories = UC_STATIC;
+    if (m_animator)
+        categories |= UC_ANIMATED;
+    if (m_physical_object && m_physical_object->isDynamic())
+        categories |= UC_PHYSICS;
+    if (m_presentation && m_presentation->needsUpdate())
+        categories |= UC_PRESENTATION;
+    return categories;
+}   // getUpdateCategories
+
+// ----------------------------------------------------------------------------
+/** Returns true if updating this object now would change anything: the
+ *  animation is playing, the rigid body is not sleeping in bullet, or the
+ *  presentation still has work to do.
+ */
+bool TrackObject::isAwake() const
+{
+    if (m_animator && m_animator->isPlaying())
+        return true;
+    if (m_physical_object && m_physical_object->isDynamic() &&
+        m_physical_object->getBody()->isActive())
+        return true;
+    return m_presentation && m_presentation->needsUpdate();
+}   // isAwake
+
 // ----------------------------------------------------------------------------
 /** Does a raycast against the track object. The object must have a physical
  *  object.
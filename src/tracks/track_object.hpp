@@ -33,6 +33,7 @@
 
 class ModelDefinitionLoader;
 class RenderInfo;
+class StateBuffer;
 class ThreeDAnimation;
 class XMLNode;
 
@@ -50,6 +51,22 @@ class TrackObject
     // eye candy (to reduce work for physics), ...
     //enum TrackObjectType {TO_PHYSICAL, TO_GRAPHICAL};
 
+public:
+    /** The reasons why an object changes over time, see
+     *  getUpdateCategories(). An object without any of these is static and
+     *  never needs to be updated. */
+    enum UpdateCategory
+    {
+        UC_STATIC       = 0,
+        /** The object has an IPO animation. */
+        UC_ANIMATED     = 1,
+        /** The object has a dynamic physical object. */
+        UC_PHYSICS      = 2,
+        /** The presentation is updated, e.g. particles, billboards or
+         *  the scripts of a library object. */
+        UC_PRESENTATION = 4
+    };
+
 private:
     /** True if the object is currently being displayed. */
     bool                     m_enabled;
@@ -96,6 +113,11 @@ protected:
 
     bool                           m_initially_visible;
 
+    /** True if this object was created while the race is running (e.g. a
+     *  tire lost in a three strikes battle, or a script trigger). Such
+     *  objects are not part of a saved race state. */
+    bool                           m_created_in_race;
+
     std::string                     m_visibility_condition;
 
     void init(const XMLNode &xml_node, scene::ISceneNode* parent,
@@ -118,11 +140,15 @@ public:
     virtual      ~TrackObject();
     virtual void update(float dt);
     virtual void updateGraphics(float dt);
+    unsigned int getUpdateCategories() const;
+    bool isAwake() const;
     void move(const core::vector3df& xyz, const core::vector3df& hpr,
               const core::vector3df& scale, bool updateRigidBody,
               bool isAbsoluteCoord);
 
     virtual void reset();
+    void saveState(StateBuffer *buffer) const;
+    void restoreState(StateBuffer *buffer);
     const core::vector3df& getPosition() const;
     const core::vector3df  getAbsolutePosition() const;
     const core::vector3df  getAbsoluteCenterPosition() const;
@@ -236,6 +262,9 @@ public:
     }
     void setInitiallyVisible(bool val)           { m_initially_visible = val; }
     // ------------------------------------------------------------------------
+    /** Returns true if this object was created while the race is running. */
+    bool isCreatedInRace() const { return m_created_in_race; }
+    // ------------------------------------------------------------------------
     /** Returns if a kart can drive on this object. */
     bool isDriveable() const { return m_is_driveable; }
     // ------------------------------------------------------------------------
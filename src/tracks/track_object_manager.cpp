@@ -27,6 +27,7 @@
 #include "physics/physical_object.hpp"
 #include "tracks/track_object.hpp"
 #include "utils/log.hpp"
+#include "utils/state_buffer.hpp"
 
 #include <IMeshSceneNode.h>
 #include <ISceneManager.h>
@@ -54,6 +55,7 @@ void TrackObjectManager::add(const XMLNode &xml_node, scene::ISceneNode* parent,
         m_all_objects.push_back(obj);
         if(obj->isDriveable())
             m_driveable_objects.push_back(obj);
+        addUpdatedObject(obj);
     }
     catch (std::exception& e)
     {
@@ -62,6 +64,19 @@ void TrackObjectManager::add(const XMLNode &xml_node, scene::ISceneNode* parent,
     }
 }   // add
 
+// ----------------------------------------------------------------------------
+/** Adds an object to the list of updated objects, unless it is static.
+ */
+void TrackObjectManager::addUpdatedObject(TrackObject *obj)
+{
+    if (obj->getUpdateCategories() == TrackObject::UC_STATIC)
+        return;
+    UpdatedObject updated;
+    updated.m_object           = obj;
+    updated.m_graphics_pending = true;
+    m_updated_objects.push_back(updated);
+}   // addUpdatedObject
+
 // ----------------------------------------------------------------------------
 /** Initialises all track objects.
  */
@@ -102,8 +117,57 @@ void TrackObjectManager::reset()
         curr->reset();
         curr->resetEnabled();
     }
+    // Objects are moved back to their start position
+    for (UpdatedObject &updated : m_updated_objects)
+        updated.m_graphics_pending = true;
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the state of all track objects that were loaded with the track.
+ *  Objects created during the race are not saved, see
+ *  TrackObject::isCreatedInRace().
+ *  \param buffer The buffer to append the state to.
+ */
+void TrackObjectManager::saveState(StateBuffer *buffer) const
+{
+    uint32_t count = 0;
+    for (const TrackObject* curr : m_all_objects)
+    {
+        if (!curr->isCreatedInRace())
+            count++;
+    }
+    buffer->add<uint32_t>(count);
+    for (const TrackObject* curr : m_all_objects)
+    {
+        if (!curr->isCreatedInRace())
+            curr->saveState(buffer);
+    }
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState().
+ *  \param buffer The buffer to read the state from.
+ */
+void TrackObjectManager::restoreState(StateBuffer *buffer)
+{
+    uint32_t count = 0;
+    for (const TrackObject* curr : m_all_objects)
+    {
+        if (!curr->isCreatedInRace())
+            count++;
+    }
+    if (buffer->get<uint32_t>() != count)
+        throw std::runtime_error("Saved state has a different number of "
+                                 "track objects.");
+    for (TrackObject* curr : m_all_objects)
+    {
+        if (!curr->isCreatedInRace())
+            curr->restoreState(buffer);
+    }
+    for (UpdatedObject &updated : m_updated_objects)
+        updated.m_graphics_pending = true;
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** returns a reference to the track object
  *  with a particular ID
@@ -160,28 +224,34 @@ void TrackObjectManager::handleExplosion(const Vec3 &pos, const PhysicalObject *
 }   // handleExplosion
 
 // ----------------------------------------------------------------------------
-/** Updates all track objects.
+/** Updates the graphics of all objects that are awake or were updated since
+ *  the last call.
  *  \param dt Time step size.
  */
 void TrackObjectManager::updateGraphics(float dt)
 {
-    TrackObject* curr;
-    for_in(curr, m_all_objects)
+    for (UpdatedObject &updated : m_updated_objects)
     {
-        curr->updateGraphics(dt);
+        if (updated.m_graphics_pending || updated.m_object->isAwake())
+            updated.m_object->updateGraphics(dt);
+        updated.m_graphics_pending = false;
     }
 }   // updateGraphics
 
 // ----------------------------------------------------------------------------
-/** Updates all track objects.
+/** Updates all track objects that are awake. Static objects are never
+ *  updated, and objects whose animation is stopped or whose rigid body is
+ *  sleeping are skipped until they are woken up again.
  *  \param dt Time step size.
  */
 void TrackObjectManager::update(float dt)
 {
-    TrackObject* curr;
-    for_in (curr, m_all_objects)
+    for (UpdatedObject &updated : m_updated_objects)
     {
-        curr->update(dt);
+        if (!updated.m_object->isAwake())
+            continue;
+        updated.m_object->update(dt);
+        updated.m_graphics_pending = true;
     }
 }   // update
 
@@ -251,6 +321,7 @@ bool TrackObjectManager::castRay(const btVector3 &from,
 void TrackObjectManager::insertObject(TrackObject* object)
 {
     m_all_objects.push_back(object);
+    addUpdatedObject(object);
 }
 
 // ----------------------------------------------------------------------------
@@ -260,6 +331,14 @@ void TrackObjectManager::insertObject(TrackObject* object)
  */
 void TrackObjectManager::removeObject(TrackObject* obj)
 {
+    for (unsigned int i = 0; i < m_updated_objects.size(); i++)
+    {
+        if (m_updated_objects[i].m_object == obj)
+        {
+            m_updated_objects.erase(m_updated_objects.begin() + i);
+            break;
+        }
+    }
     m_all_objects.remove(obj);
     delete obj;
 }   // removeObject
@@ -27,6 +27,7 @@ class Track;
 class Vec3;
 class XMLNode;
 class LODNode;
+class StateBuffer;
 
 #include <map>
 #include <vector>
@@ -51,11 +52,29 @@ protected:
     /** A second list which holds all objects that karts can drive on. */
     PtrVector<TrackObject, REF> m_driveable_objects;
 
+    /** An object that is not static, see TrackObject::getUpdateCategories. */
+    struct UpdatedObject
+    {
+        TrackObject *m_object;
+        /** True if the object was updated since the last call to
+         *  updateGraphics(), so its graphical position must be updated even
+         *  if it fell asleep in the meantime. */
+        bool         m_graphics_pending;
+    };
+
+    /** All objects that are not static. Only these objects are updated,
+     *  since on most tracks nearly all objects never move. */
+    std::vector<UpdatedObject> m_updated_objects;
+
+    void addUpdatedObject(TrackObject *obj);
+
 public:
          TrackObjectManager();
         ~TrackObjectManager();
     void reset();
     void init();
+    void saveState(StateBuffer *buffer) const;
+    void restoreState(StateBuffer *buffer);
     void add(const XMLNode &xml_node, scene::ISceneNode* parent,
              ModelDefinitionLoader& model_def_loader,
              TrackObject* parent_library);
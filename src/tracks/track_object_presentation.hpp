@@ -90,6 +90,11 @@ public:
     }
     virtual void updateGraphics(float dt) {}
     virtual void update(float dt) {}
+    // ------------------------------------------------------------------------
+    /** Returns true if update() or updateGraphics() currently have any work
+     *  to do. Presentations that return false when they are created are
+     *  never updated. */
+    virtual bool needsUpdate() const { return false; }
     virtual void move(const core::vector3df& xyz, const core::vector3df& hpr,
         const core::vector3df& scale, bool isAbsoluteCoord) {}
 
@@ -205,6 +210,12 @@ public:
         m_reset_executed = false;
         TrackObjectPresentationSceneNode::reset();
     }
+    // ------------------------------------------------------------------------
+    /** The onStart and onReset script functions still need to be run. */
+    virtual bool needsUpdate() const OVERRIDE
+    {
+        return !m_start_executed || !m_reset_executed;
+    }
     virtual void move(const core::vector3df& xyz, const core::vector3df& hpr,
         const core::vector3df& scale, bool isAbsoluteCoord) OVERRIDE;
 };   // TrackObjectPresentationLibraryNode
@@ -286,6 +297,7 @@ public:
                                      scene::ISceneNode* parent);
     virtual ~TrackObjectPresentationBillboard();
     virtual void updateGraphics(float dt) OVERRIDE;
+    virtual bool needsUpdate() const OVERRIDE { return true; }
 };   // TrackObjectPresentationBillboard
 
 
@@ -308,6 +320,7 @@ public:
     virtual ~TrackObjectPresentationParticles();
 
     virtual void updateGraphics(float dt) OVERRIDE;
+    virtual bool needsUpdate() const OVERRIDE { return true; }
     void triggerParticles();
     void stop();
     void stopIn(double delay);
@@ -27,6 +27,7 @@
 #include "tracks/arena_node.hpp"
 #include "tracks/drive_graph.hpp"
 #include "tracks/drive_node.hpp"
+#include "utils/state_buffer.hpp"
 
 // ----------------------------------------------------------------------------
 /** Initialises the object, and sets the current graph node to be undefined.
@@ -46,6 +47,34 @@ void TrackSector::reset()
     m_last_triggered_checkline   = -1;
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the current and last valid sector of the object. */
+void TrackSector::saveState(StateBuffer *buffer) const
+{
+    buffer->add<int>(m_current_graph_node);
+    buffer->add<int>(m_estimated_valid_graph_node);
+    buffer->add<int>(m_last_valid_graph_node);
+    buffer->addVec3(m_current_track_coords);
+    buffer->addVec3(m_estimated_valid_track_coords);
+    buffer->addVec3(m_latest_valid_track_coords);
+    buffer->add<bool>(m_on_road);
+    buffer->add<int>(m_last_triggered_checkline);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state written by saveState(). */
+void TrackSector::restoreState(StateBuffer *buffer)
+{
+    m_current_graph_node           = buffer->get<int>();
+    m_estimated_valid_graph_node   = buffer->get<int>();
+    m_last_valid_graph_node        = buffer->get<int>();
+    m_current_track_coords         = buffer->getVec3();
+    m_estimated_valid_track_coords = buffer->getVec3();
+    m_latest_valid_track_coords    = buffer->getVec3();
+    m_on_road                      = buffer->get<bool>();
+    m_last_triggered_checkline     = buffer->get<int>();
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Updates the current graph node index, and the track coordinates for
  *  the specified point.
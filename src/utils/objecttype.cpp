@@ -1,5 +1,6 @@
 #include "objecttype.h"
 #include "utils/log.hpp"
+#include "utils/stk_process.hpp"
 #include <iostream>
 #include <unordered_map>
 #include <vector>
@@ -8,7 +9,7 @@ ObjectType getOT(const std::string & debug_name) {
 	return OT_UNKNOWN;
 	return OT_NONE;
 }
-static uint32_t last_object_id[NUM_OT] = {0};
+static uint32_t last_object_id[STK_MAX_PROCESS_SLOTS][NUM_OT] = {{0}};
 static std::unordered_map<std::string, uint32_t> unknown_ot;
 static std::vector<std::string> unknown_ot_name;
 
@@ -22,7 +23,7 @@ ObjectID makeObjectId(ObjectType ot, uint32_t i) {
 	return ((uint32_t)ot << OBJECT_TYPE_SHIFT) + i;
 }
 ObjectID newObjectId(ObjectType ot) {
-	return makeObjectId(ot, ++last_object_id[ot]);
+	return makeObjectId(ot, ++last_object_id[STKProcess::getSlot()][ot]);
 }
 ObjectID newObjectId(const std::string & debug_name) {
 	ObjectType ot = getOT(debug_name);
@@ -41,5 +42,5 @@ ObjectID newObjectId(const std::string & debug_name) {
 }
 void resetObjectId() {
 	for(int i=0; i<NUM_OT; i++)
-		last_object_id[i] = 0;
+		last_object_id[STKProcess::getSlot()][i] = 0;
 }
@@ -17,35 +17,15 @@
 
 #include "profiler.hpp"
 
-#include "graphics/glwrap.hpp"
-#include "graphics/irr_driver.hpp"
-#include "graphics/2dutils.hpp"
-#include "graphics/irr_driver.hpp"
-#include "io/file_manager.hpp"
 #include "utils/file_utils.hpp"
-#include "utils/string_utils.hpp"
-#include "utils/tls.hpp"
-#include "utils/vs.hpp"
+#include "utils/log.hpp"
 
 #include <algorithm>
+#include <cstdio>
 #include <fstream>
-#include <ostream>
-#include <stack>
-#include <sstream>
 
 Profiler profiler;
 
-// Unit is in pencentage of the screen dimensions
-#define MARGIN_X    0.02f    // left and right margin
-#define MARGIN_Y    0.02f    // top margin
-#define LINE_HEIGHT 0.030f   // height of a line representing a thread
-
-#define MARKERS_NAMES_POS     core::rect<s32>(50,100,150,600)
-#define GPU_MARKERS_NAMES_POS core::rect<s32>(50,165,150,300)
-
-// The width of the profiler corresponds to TIME_DRAWN_MS milliseconds
-#define TIME_DRAWN_MS 30.0f 
-
 // --- Begin portable precise timer ---
 #ifdef WIN32
     #define WIN32_LEAN_AND_MEAN
@@ -73,17 +53,51 @@ Profiler profiler;
 #endif
 // --- End portable precise timer ---
 
+namespace
+{
+    /** A marker that was pushed but not popped yet. */
+    struct OpenMarker
+    {
+        std::string m_name;
+        double      m_start;
+    };   // OpenMarker
+
+    /** The stack of open markers of each thread. */
+    thread_local std::vector<OpenMarker> g_open_markers;
+
+    thread_local int g_thread_id = -1;
+
+    // ------------------------------------------------------------------------
+    /** Writes s as JSON string. */
+    void writeJSONString(std::ostream& out, const std::string& s)
+    {
+        out << '"';
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if ((unsigned char)c < 0x20)
+            {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", (unsigned char)c);
+                out << buf;
+            }
+            else
+                out << c;
+        }
+        out << '"';
+    }   // writeJSONString
+}   // namespace
+
 //-----------------------------------------------------------------------------
 Profiler::Profiler()
 {
-    m_time_last_sync      = getTimeMilliseconds();
-    m_time_between_sync   = 0.0;
-    m_freeze_state        = UNFROZEN;
-
-    m_max_frames          = 20 * 120;
-    m_current_frame       = 0;
-    m_has_wrapped_around  = false;
-    m_threads_used = 1;
+    m_enabled              = false;
+    m_max_trace_events     = 1 << 20;
+    m_dropped_trace_events = 0;
+    m_frames               = 0;
+    m_time_start           = getTimeMilliseconds();
+    m_threads_used         = 0;
 }   // Profile
 
 //-----------------------------------------------------------------------------
@@ -91,122 +105,187 @@ Profiler::~Profiler()
 {
 }   // ~Profiler
 
-thread_local int g_thread_id = -1;
-const int MAX_THREADS = 10;
 //-----------------------------------------------------------------------------
-/** It is split from the constructor so that it can be avoided allocating
- *  unnecessary memory when the profiler is never used (for example in no
- *  graphics). */
-void Profiler::init()
-{
-    m_all_threads_data.resize(MAX_THREADS);
-
-    // Add this thread to the thread mapping
-    m_thread_mapping[0] = std::this_thread::get_id();
-    m_gpu_times.resize(Q_LAST * m_max_frames);
-}   // init
-
-//-----------------------------------------------------------------------------
-/** Returns a unique index for a thread. If the calling thread is not yet in
- *  the mapping, it will assign a new unique id to this thread. */
+/** Returns a unique index for a thread. If the calling thread does not have
+ *  an index yet, it will assign a new unique id to this thread. */
 int Profiler::getThreadID()
 {
-    std::thread::id thread = std::this_thread::get_id();
-    int i = 0;
-    while(i < m_threads_used)
-    {
-        if (m_threads_used >= MAX_THREADS)
-        {
-            g_thread_id = MAX_THREADS - 1;
-            return g_thread_id;
-        }
+    if (g_thread_id < 0)
         g_thread_id = m_threads_used.fetch_add(1);
-    }
     return g_thread_id;
 }   // getThreadID
 
+//-----------------------------------------------------------------------------
+/** Returns the index of a marker name in m_names, and adds the name if it is
+ *  new. Must be called with m_mutex locked. */
+unsigned Profiler::getNameIndex(const std::string& name)
+{
+    auto it = m_name_index.find(name);
+    if (it != m_name_index.end())
+        return it->second;
+    unsigned index = (unsigned)m_names.size();
+    m_names.push_back(name);
+    m_timings.push_back(Timing());
+    m_name_index[name] = index;
+    return index;
+}   // getNameIndex
+
 //-----------------------------------------------------------------------------
 /// Push a new marker that starts now
 void Profiler::pushCPUMarker(const char* name, const video::SColor& colour)
 {
+    g_open_markers.push_back({ name, getTimeMilliseconds() });
 }   // pushCPUMarker
 
 //-----------------------------------------------------------------------------
 /// Stop the last pushed marker
 void Profiler::popCPUMarker()
 {
+    // The marker was pushed while the profiler was disabled
+    if (g_open_markers.empty())
+        return;
+    const double end = getTimeMilliseconds();
+    OpenMarker marker = std::move(g_open_markers.back());
+    g_open_markers.pop_back();
+    if (!isEnabled())
+        return;
+
+    const double duration = end - marker.m_start;
+    const int thread_id = getThreadID();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const unsigned index = getNameIndex(marker.m_name);
+    Timing& timing = m_timings[index];
+    timing.m_count++;
+    timing.m_total += duration;
+    timing.m_max = std::max(timing.m_max, duration);
+    if (m_trace_events.size() < m_max_trace_events)
+    {
+        m_trace_events.push_back({ index, (unsigned)thread_id,
+                                   marker.m_start - m_time_start, duration });
+    }
+    else
+        m_dropped_trace_events++;
 }   // popCPUMarker
 
 //-----------------------------------------------------------------------------
-/** Switches the profiler either on or off.
+/** Adds a time that was not measured with markers, e.g. a GPU timer query.
+ *  It is only aggregated and not added to the trace.
+ *  \param name Name to aggregate the time under.
+ *  \param ms The time in ms.
  */
-void Profiler::toggleStatus()
+void Profiler::addTime(const std::string& name, double ms)
 {
-}   // toggleStatus
+    if (!isEnabled())
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Timing& timing = m_timings[getNameIndex(name)];
+    timing.m_count++;
+    timing.m_total += ms;
+    timing.m_max = std::max(timing.m_max, ms);
+}   // addTime
 
 //-----------------------------------------------------------------------------
-/** Saves all data for the current frame, and starts the next frame in the
- *  circular buffer. Any events that are currently active (e.g. in a separate
- *  thread) will be split in two parts: the beginning (till now) in the current
- *  frame, the rest will be added to the next frame.
+/** Marks the end of a frame (a race step in pystk), used to compute the
+ *  average time per frame.
  */
 void Profiler::synchronizeFrame()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frames++;
 }   // synchronizeFrame
 
 //-----------------------------------------------------------------------------
-/** Saves the collected profile data to a file. Filename is based on the
- *  stdout name (with -profile appended).
+/** Switches the profiler either on or off. Recorded data is kept.
  */
-void Profiler::writeToFile()
+void Profiler::setEnabled(bool enabled)
 {
-    std::string base_name =
-               file_manager->getUserConfigFile(file_manager->getStdoutName());
-    // First CPU data
-    for (int thread_id = 0; thread_id < m_threads_used; thread_id++)
-    {
-        std::ofstream f(FileUtils::getPortableWritingPath(
-            base_name + ".profile-cpu-" + StringUtils::toString(thread_id)));
-        ThreadData &td = m_all_threads_data[thread_id];
-        f << "#  ";
-        for (unsigned int i = 0; i < td.m_ordered_headings.size(); i++)
-            f << "\"" << td.m_ordered_headings[i] << "(" << i+1 <<")\"   ";
-        f << std::endl;
-        int start = m_has_wrapped_around ? m_current_frame + 1 : 0;
-        if (start > m_max_frames) start -= m_max_frames;
-        while (start != m_current_frame)
-        {
-            for (unsigned int i = 0; i < td.m_ordered_headings.size(); i++)
-            {
-                const EventData &ed = td.m_all_event_data[td.m_ordered_headings[i]];
-                f << int(ed.getMarker(start).getDuration()*1000) << " ";
-            }   // for i i new_headings
-            f << std::endl;
-            start = (start + 1) % m_max_frames;
-        }   // while start != m_current_frame
-        f.close();
-    }   // for all thread_ids
-
-    std::ofstream f_gpu(FileUtils::getPortableWritingPath(base_name + ".profile-gpu"));
-    f_gpu << "# ";
-
-    for (unsigned i = 0; i < Q_LAST; i++)
-    {
-        f_gpu << "\"" << irr_driver->getGPUQueryPhaseName(i) << "(" << i+1 << ")\"   ";
-    }   // for i < Q_LAST
-    f_gpu << std::endl;
+    m_enabled = enabled;
+}   // setEnabled
+
+//-----------------------------------------------------------------------------
+/** Removes all recorded timings and trace events.
+ */
+void Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Timing& timing : m_timings)
+        timing = Timing();
+    m_trace_events.clear();
+    m_dropped_trace_events = 0;
+    m_frames = 0;
+    m_time_start = getTimeMilliseconds();
+}   // reset
 
-    int start = m_has_wrapped_around ? m_current_frame + 1 : 0;
-    if (start > m_max_frames) start -= m_max_frames;
-    while (start != m_current_frame)
+//-----------------------------------------------------------------------------
+/** Returns the aggregated timings of all markers recorded since the last
+ *  reset, indexed by marker name.
+ */
+std::map<std::string, Profiler::Timing> Profiler::getTimings()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<std::string, Timing> timings;
+    for (unsigned i = 0; i < m_names.size(); i++)
     {
-        for (unsigned i = 0; i < Q_LAST; i++)
-        {
-            f_gpu << m_gpu_times[start*Q_LAST + i] << "   ";
-        }   // for i < Q_LAST
-        f_gpu << std::endl;
-        start = (start + 1) % m_max_frames;
+        if (m_timings[i].m_count > 0)
+            timings[m_names[i]] = m_timings[i];
     }
-    f_gpu.close();
+    return timings;
+}   // getTimings
 
-}   // writeFile
+//-----------------------------------------------------------------------------
+/** Returns the number of frames since the last reset. */
+unsigned long Profiler::getFrames()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_frames;
+}   // getFrames
+
+//-----------------------------------------------------------------------------
+/** Sets the maximum number of markers kept for the trace, further markers
+ *  are only aggregated. */
+void Profiler::setMaxTraceEvents(size_t n)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_trace_events = n;
+    if (m_trace_events.size() > n)
+        m_trace_events.resize(n);
+}   // setMaxTraceEvents
+
+//-----------------------------------------------------------------------------
+/** Saves all markers recorded since the last reset in the Chrome trace event
+ *  format, which can be opened in chrome://tracing or Perfetto.
+ *  \param filename Name of the file to write.
+ *  \return False if the file could not be written.
+ */
+bool Profiler::writeChromeTrace(const std::string& filename)
+{
+    std::ofstream f(FileUtils::getPortableWritingPath(filename));
+    if (!f.is_open())
+    {
+        Log::error("Profiler", "Cannot write trace '%s'.", filename.c_str());
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_dropped_trace_events > 0)
+    {
+        Log::warn("Profiler", "Trace is incomplete, %lu markers were "
+                  "dropped.", m_dropped_trace_events);
+    }
+    f << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    f.precision(3);
+    f << std::fixed;
+    for (size_t i = 0; i < m_trace_events.size(); i++)
+    {
+        const TraceEvent& e = m_trace_events[i];
+        if (i > 0)
+            f << ",";
+        f << "\n{\"name\":";
+        writeJSONString(f, m_names[e.m_name]);
+        // Times in the trace format are in microseconds
+        f << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.m_thread
+          << ",\"ts\":" << e.m_start * 1000.0
+          << ",\"dur\":" << e.m_duration * 1000.0 << "}";
+    }
+    f << "\n]}\n";
+    return f.good();
+}   // writeChromeTrace
@@ -20,17 +20,11 @@
 
 #include <irrlicht.h>
 
-#include <assert.h>
 #include <atomic>
-#include <iostream>
-#include <list>
 #include <map>
-#include <ostream>
-#include <stack>
-#include <streambuf>
+#include <mutex>
 #include <string>
 #include <vector>
-#include <thread>
 
 enum QueryPerf
 {
@@ -65,230 +59,155 @@ extern Profiler profiler;
 
 double getTimeMilliseconds();
 
-// #define ENABLE_PROFILER
+// The markers are always compiled in, and only record anything if the
+// profiler is enabled at run time (see Profiler::setEnabled()).
+#define PROFILER_PUSH_CPU_MARKER(name, r, g, b)                          \
+    do                                                                   \
+    {                                                                    \
+        if (profiler.isEnabled())                                        \
+            profiler.pushCPUMarker(name, video::SColor(0xFF, r, g, b));  \
+    } while (0)
 
-#ifdef ENABLE_PROFILER
-    #define PROFILER_PUSH_CPU_MARKER(name, r, g, b) \
-        profiler.pushCPUMarker(name, video::SColor(0xFF, r, g, b))
+#define PROFILER_POP_CPU_MARKER()  \
+    profiler.popCPUMarker()
 
-    #define PROFILER_POP_CPU_MARKER()  \
-        profiler.popCPUMarker()
+#define PROFILER_SYNC_FRAME()                \
+    do                                       \
+    {                                        \
+        if (profiler.isEnabled())            \
+            profiler.synchronizeFrame();     \
+    } while (0)
 
-    #define PROFILER_SYNC_FRAME()   \
-        profiler.synchronizeFrame()
-
-    #define PROFILER_DRAW() \
-        profiler.draw()
-#else
-    #define PROFILER_PUSH_CPU_MARKER(name, r, g, b)
-    #define PROFILER_POP_CPU_MARKER()
-    #define PROFILER_SYNC_FRAME()
-    #define PROFILER_DRAW()
-#endif
+#define PROFILER_DRAW()
 
 using namespace irr;
 
 // ============================================================================
-/** \brief class that allows run-time graphical profiling through the use 
- *  of markers.
+/** \brief Records the time spent between pairs of markers at run time.
+ *  Markers are pushed and popped with PROFILER_PUSH_CPU_MARKER and
+ *  PROFILER_POP_CPU_MARKER, and can be nested and used from any thread.
+ *  While the profiler is disabled (the default) a push only costs the test
+ *  of an atomic flag. The timings of all markers with the same name are
+ *  aggregated, and each marker is also kept as event for a trace in the
+ *  Chrome trace event format (chrome://tracing or Perfetto).
  * \ingroup utils
  */
 class Profiler
 {
-private:
+public:
     // ------------------------------------------------------------------------
-    class Marker
-    {
-    private:
-        /** An event that is started (pushed) stores the start time in this
-         *  variable. */
-        double  m_start;
-
-        /** Duration of the event in this frame (accumulated if this event
-         *  should be recorded more than once). */
-
-        double  m_duration;
-        /** Distance of marker from root (for nested events), used to
-         *  adjust vertical height when drawing. */
-        size_t  m_layer;
-    public:
-        // --------------------------------------------------------------------
-        Marker() { m_start = 0; m_duration = 0; m_layer = 0; }
-
-        // --------------------------------------------------------------------
-        Marker(double start, size_t layer=0)
-           : m_start(start), m_duration(0), m_layer(layer)
-        {
-        }
-        // --------------------------------------------------------------------
-        Marker(const Marker& ref)
-            : m_start(ref.m_start), m_duration(ref.m_duration), 
-              m_layer(ref.m_layer)
-        {
-        }
-        // --------------------------------------------------------------------
-        /** Returns the start time of this event marker. */
-        double getStart() const { return m_start;  }
-        // --------------------------------------------------------------------
-        /** Returns the end time of this event marker. */
-        double getEnd() const { return m_start+m_duration; }
-        // --------------------------------------------------------------------
-        /** Returns the duration of this event. */
-        double getDuration() const { return m_duration;  }
-        // --------------------------------------------------------------------
-        size_t getLayer() const { return m_layer;  }
-        // --------------------------------------------------------------------
-        /** Called when an entry in the cyclic buffer is reused. Makes sure
-         *  that time for a new event can be accumulated. */
-        void clear() { m_duration = 0; }
-        // --------------------------------------------------------------------
-        /** Sets start time and layer for this event. */
-        void setStart(double start, size_t layer = 0)
-        {
-            m_start = start; m_layer = layer;
-        }   // setStart
-        // --------------------------------------------------------------------
-        /** Sets the end time of this event. */
-        void setEnd(double end)
-        {
-            m_duration += (end - m_start);
-        }   // setEnd
-
-    };   // class Marker
-
-    // ========================================================================
-    /** The data for one event. It contains the events colours, all markers
-     * for the buffer period and a stack to detect nesting of markers.
-     */
-    class EventData
+    /** The aggregated timings of all markers with the same name. */
+    struct Timing
     {
-    private:
-        /** Colour to use in the on-screen display */
-        video::SColor m_colour;
-
-        /** Vector of all buffered markers. */
-        std::vector<Marker> m_all_markers;
-
-    public:
-        EventData() {}
-        EventData(video::SColor colour, int max_size)
-        {
-            m_all_markers.resize(max_size);
-            m_colour = colour;
-        }   // EventData
-        // --------------------------------------------------------------------
-        /** Records the start of an event for a given frame. */
-        void setStart(size_t frame, double start, int layer)
-        {
-            assert(frame < m_all_markers.capacity());
-            m_all_markers[frame].setStart(start, layer);
-        }   // setStart
-        // --------------------------------------------------------------------
-        /** Records the end of an event for a given frame. */
-        void setEnd(size_t frame, double end)
-        {
-            assert(frame < m_all_markers.capacity());
-            m_all_markers[frame].setEnd(end);
-        }   // setEnd
-        // --------------------------------------------------------------------
-        const Marker& getMarker(int n) const { return m_all_markers[n]; }
-        Marker& getMarker(int n) { return m_all_markers[n]; }
-        // --------------------------------------------------------------------
-        /** Returns the colour for this event. */
-        video::SColor getColour() const { return m_colour;  }
-        // --------------------------------------------------------------------
-    };   // EventData
-
-    // ========================================================================
-    /** The mapping of event names to the corresponding EventData. */
-    typedef std::map<std::string, EventData> AllEventData;
-    // ========================================================================
-    struct ThreadData
-    {
-        /** Stack of events to detect nesting. */
-        std::vector< std::string > m_event_stack;
-
-        /** This stores the event names in the order in which they occur.
-        *  This means that 'outer' events occur here before any child
-        *  events. This list is then used to determine the order in which the
-        *  bar graphs are drawn, which results in the proper nesting of events.*/
-        std::vector<std::string> m_ordered_headings;
-
-        AllEventData m_all_event_data;
-    };   // class ThreadData
+        /** Number of times the marker was recorded. */
+        unsigned long m_count;
 
-    // ========================================================================
+        /** Total and maximum time spent in the marker in ms. */
+        double        m_total;
+        double        m_max;
 
-    /** Data structure containing all currently buffered markers. The index
-     *  is the thread id. */
-    std::vector< ThreadData> m_all_threads_data;
+        Timing() : m_count(0), m_total(0.0), m_max(0.0) {}
+    };   // Timing
 
-    /** A mapping of thread_t pointers to a unique integer (starting from 0).*/
-    std::vector<std::thread::id> m_thread_mapping;
+private:
+    // ------------------------------------------------------------------------
+    /** A recorded marker, used for the trace. */
+    struct TraceEvent
+    {
+        /** Index of the name in m_names. */
+        unsigned m_name;
+        unsigned m_thread;
+        /** Start time relative to m_time_start and duration, both in ms. */
+        double   m_start;
+        double   m_duration;
+    };   // TraceEvent
 
-    /** Buffer for the GPU times (in ms). */
-    std::vector<int> m_gpu_times;
+    /** True if markers are recorded. */
+    std::atomic<bool> m_enabled;
 
-    /** Counts the threads used. */
-    std::atomic<int> m_threads_used;
+    /** Protects all data below, markers can be recorded from any thread. */
+    std::mutex m_mutex;
 
-    /** Index of the current frame in the buffer. */
-    int m_current_frame;
+    /** All marker names, and the index of each name in m_names. */
+    std::vector<std::string> m_names;
+    std::map<std::string, unsigned> m_name_index;
 
-    /** We don't need the bool, but easiest way to get a lock for the whole
-     *  instance (since we need to avoid that a synch is done which changes
-     *  the current frame while another threaded uses this variable, or
-     *  while a new thread is added. */
-    bool m_lock;
+    /** Aggregated timings, indexed like m_names. */
+    std::vector<Timing> m_timings;
 
-    /** True if the circular buffer has wrapped around. */
-    bool m_has_wrapped_around;
+    /** All recorded markers, at most m_max_trace_events. */
+    std::vector<TraceEvent> m_trace_events;
 
-    /** The maximum number of frames to be buffered. Used to minimise
-     *  reallocations. */
-    int m_max_frames;
+    size_t m_max_trace_events;
 
-    /** Time of last sync. All start/end times are stored relative
-     *  to this time. */
-    double m_time_last_sync;
+    /** Number of markers not added to the trace since it was full. */
+    unsigned long m_dropped_trace_events;
 
-    /** Time between now and last sync, used to scale the GUI bar. */
-    double m_time_between_sync;
+    /** Number of frames (e.g. race steps) since the last reset. */
+    unsigned long m_frames;
 
-    /** List of all event names. This list is sorted to make sure
-     *  if the circular buffer is dumped more than once the order
-     *  of events remains the same. */
-    std::vector<std::string> m_all_event_names;
+    /** Time of the last reset, all trace events are relative to it. */
+    double m_time_start;
 
-    // Handling freeze/unfreeze by clicking on the display
-    enum FreezeState
-    {
-        UNFROZEN,
-        WAITING_FOR_FREEZE,
-        FROZEN,
-        WAITING_FOR_UNFREEZE,
-    };
-
-    FreezeState     m_freeze_state;
+    /** Counts the threads used, to give each thread an id in the trace. */
+    std::atomic<int> m_threads_used;
 
-private:
-    int  getThreadID();
-    void drawBackground();
+    int      getThreadID();
+    unsigned getNameIndex(const std::string& name);
 
 public:
              Profiler();
     virtual ~Profiler();
-    void     init();
     void     pushCPUMarker(const char* name="N/A",
                            const video::SColor& color=video::SColor());
     void     popCPUMarker();
-    void     toggleStatus(); 
+    void     addTime(const std::string& name, double ms);
     void     synchronizeFrame();
-    void     writeToFile();
+    void     setEnabled(bool enabled);
+    void     reset();
+    std::map<std::string, Timing> getTimings();
+    unsigned long getFrames();
+    bool     writeChromeTrace(const std::string& filename);
+    void     setMaxTraceEvents(size_t n);
 
     // ------------------------------------------------------------------------
-    bool isFrozen() const { return m_freeze_state == FROZEN; }
+    /** Returns true if markers are recorded. */
+    bool isEnabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }   // isEnabled
 
 };
 
+// ============================================================================
+/** \brief Pushes a CPU marker for the lifetime of this object, so that the
+ *  marker is also popped if the scope is left by an exception. Like
+ *  PROFILER_PUSH_CPU_MARKER nothing is recorded if the profiler is disabled.
+ * \ingroup utils
+ */
+class ProfilerScope
+{
+private:
+    /** True if a marker was pushed and must be popped again. */
+    bool m_pushed;
+
+public:
+    ProfilerScope(const char* name, unsigned char r, unsigned char g,
+                  unsigned char b)
+    {
+        m_pushed = profiler.isEnabled();
+        if (m_pushed)
+            profiler.pushCPUMarker(name, video::SColor(0xFF, r, g, b));
+    }   // ProfilerScope
+    // ------------------------------------------------------------------------
+    ~ProfilerScope()
+    {
+        if (m_pushed)
+            profiler.popCPUMarker();
+    }   // ~ProfilerScope
+    // ------------------------------------------------------------------------
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+};   // ProfilerScope
+
 #endif // PROFILER_HPP
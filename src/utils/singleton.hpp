@@ -23,19 +23,22 @@
 #define SINGLETON_HPP
 
 #include "utils/log.hpp"
+#include "utils/stk_process.hpp"
 
 /*! \class AbstractSingleton
  *  \brief Manages the abstract singleton at runtime.
  *  This has been designed to allow multi-inheritance. This is advised to
  *  re-declare getInstance, but whithout templates parameters in the inheriting
  *  classes.
+ *  There is one instance per simulation slot (see STKProcess::getSlot()),
+ *  since abstract singletons hold per-race state (scripts, weather).
  */
 template <typename T>
 class AbstractSingleton
 {
     protected:
         /*! \brief Constructor */
-        AbstractSingleton() { m_singleton = NULL; }
+        AbstractSingleton() { m_singleton[STKProcess::getSlot()] = NULL; }
         /*! \brief Destructor */
         virtual ~AbstractSingleton()
         {
@@ -52,10 +55,11 @@ class AbstractSingleton
         template<typename S>
         static S *getInstance ()
         {
-            if (m_singleton == NULL)
-                m_singleton = new S;
+            T*& singleton = m_singleton[STKProcess::getSlot()];
+            if (singleton == NULL)
+                singleton = new S;
 
-            S* result = (dynamic_cast<S*> (m_singleton));
+            S* result = (dynamic_cast<S*> (singleton));
             if (result == NULL)
                 Log::debug("Singleton", "THE SINGLETON HAS NOT BEEN REALOCATED, IT IS NOT OF THE REQUESTED TYPE.");
             return result;
@@ -63,24 +67,26 @@ class AbstractSingleton
         /*! \brief Used to get the instance. */
         static T *getInstance()
         {
-            return m_singleton;
+            return m_singleton[STKProcess::getSlot()];
         }
 
         /*! \brief Used to kill the singleton, if needed. */
         static void kill ()
         {
-            if (m_singleton)
+            T*& singleton = m_singleton[STKProcess::getSlot()];
+            if (singleton)
             {
-                delete m_singleton;
-                m_singleton = NULL;
+                delete singleton;
+                singleton = NULL;
             }
         }
 
     private:
-        static T *m_singleton;
+        static T *m_singleton[STK_MAX_PROCESS_SLOTS];
 };
 
-template <typename T> T *AbstractSingleton<T>::m_singleton = NULL;
+template <typename T>
+T *AbstractSingleton<T>::m_singleton[STK_MAX_PROCESS_SLOTS] = {};
 
 template <typename T>
 class Singleton
@@ -0,0 +1,139 @@
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2020 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_STATE_BUFFER_HPP
+#define HEADER_STATE_BUFFER_HPP
+
+#include "LinearMath/btTransform.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/**
+ *  \brief A flat byte buffer used to save and restore the simulation state
+ *  of a race in memory.
+ *  Values are stored in native byte order without any compression, so a
+ *  buffer can only be restored by the same build that saved it, into a race
+ *  with the same track, karts and mode. All saveState()/restoreState()
+ *  functions must read exactly what they wrote, in the same order.
+ * \ingroup utils
+ */
+class StateBuffer
+{
+private:
+    /** The serialized state. */
+    std::string m_data;
+
+    /** Current read position in m_data. */
+    size_t m_read_pos;
+
+public:
+    StateBuffer() : m_read_pos(0) {}
+    // ------------------------------------------------------------------------
+    StateBuffer(const std::string &data) : m_data(data), m_read_pos(0) {}
+    // ------------------------------------------------------------------------
+    /** Appends a trivially copyable value. */
+    template<typename T>
+    void add(const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "StateBuffer can only store trivially copyable types");
+        m_data.append((const char*)&value, sizeof(T));
+    }   // add
+    // ------------------------------------------------------------------------
+    /** Reads the next trivially copyable value. */
+    template<typename T>
+    T get()
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "StateBuffer can only store trivially copyable types");
+        if (m_read_pos + sizeof(T) > m_data.size())
+            throw std::runtime_error("StateBuffer: read past end of state");
+        T value;
+        memcpy(&value, m_data.data() + m_read_pos, sizeof(T));
+        m_read_pos += sizeof(T);
+        return value;
+    }   // get
+    // ------------------------------------------------------------------------
+    void addVec3(const btVector3 &v)
+    {
+        add<float>(v.getX()); add<float>(v.getY()); add<float>(v.getZ());
+    }   // addVec3
+    // ------------------------------------------------------------------------
+    btVector3 getVec3()
+    {
+        float x = get<float>(), y = get<float>(), z = get<float>();
+        return btVector3(x, y, z);
+    }   // getVec3
+    // ------------------------------------------------------------------------
+    void addQuaternion(const btQuaternion &q)
+    {
+        add<float>(q.getX()); add<float>(q.getY());
+        add<float>(q.getZ()); add<float>(q.getW());
+    }   // addQuaternion
+    // ------------------------------------------------------------------------
+    btQuaternion getQuaternion()
+    {
+        float x = get<float>(), y = get<float>(), z = get<float>(),
+              w = get<float>();
+        return btQuaternion(x, y, z, w);
+    }   // getQuaternion
+    // ------------------------------------------------------------------------
+    /** Appends the origin and the full basis of a transform. Unlike a
+     *  quaternion this restores the transform bit for bit. */
+    void addTransform(const btTransform &t)
+    {
+        addVec3(t.getOrigin());
+        for (int i = 0; i < 3; i++)
+            addVec3(t.getBasis()[i]);
+    }   // addTransform
+    // ------------------------------------------------------------------------
+    btTransform getTransform()
+    {
+        btVector3 origin = getVec3();
+        btMatrix3x3 basis;
+        for (int i = 0; i < 3; i++)
+            basis[i] = getVec3();
+        return btTransform(basis, origin);
+    }   // getTransform
+    // ------------------------------------------------------------------------
+    void addString(const std::string &s)
+    {
+        add<uint32_t>((uint32_t)s.size());
+        m_data.append(s);
+    }   // addString
+    // ------------------------------------------------------------------------
+    std::string getString()
+    {
+        uint32_t n = get<uint32_t>();
+        if (m_read_pos + n > m_data.size())
+            throw std::runtime_error("StateBuffer: read past end of state");
+        std::string s = m_data.substr(m_read_pos, n);
+        m_read_pos += n;
+        return s;
+    }   // getString
+    // ------------------------------------------------------------------------
+    /** Returns the serialized state. */
+    const std::string& getData() const { return m_data; }
+    // ------------------------------------------------------------------------
+    /** Returns true if all data has been read. */
+    bool atEnd() const { return m_read_pos == m_data.size(); }
+};   // StateBuffer
+
+#endif
@@ -17,7 +17,41 @@
 
 #include "utils/stk_process.hpp"
 
+#include <bitset>
+#include <mutex>
+
 namespace STKProcess
 {
     thread_local ProcessType g_process_type = PT_MAIN;
+    thread_local unsigned int g_process_slot = PT_MAIN;
+
+    std::mutex g_slot_mutex;
+    std::bitset<STK_MAX_PROCESS_SLOTS> g_used_slots;
+    // ------------------------------------------------------------------------
+    /** Reserves a free simulation slot for an additional independent
+     *  simulation in this process. The slots of the main and child process
+     *  are never handed out.
+     *  \return The slot, or STK_MAX_PROCESS_SLOTS if all slots are in use.
+     */
+    unsigned int acquireSlot()
+    {
+        std::lock_guard<std::mutex> lock(g_slot_mutex);
+        for (unsigned int i = PT_COUNT; i < STK_MAX_PROCESS_SLOTS; i++)
+        {
+            if (!g_used_slots[i])
+            {
+                g_used_slots[i] = true;
+                return i;
+            }
+        }
+        return STK_MAX_PROCESS_SLOTS;
+    }   // acquireSlot
+    // ------------------------------------------------------------------------
+    /** Returns a slot obtained from acquireSlot() so it can be reused. */
+    void releaseSlot(unsigned int slot)
+    {
+        std::lock_guard<std::mutex> lock(g_slot_mutex);
+        if (slot < STK_MAX_PROCESS_SLOTS)
+            g_used_slots[slot] = false;
+    }   // releaseSlot
 } // namespace STKProcess
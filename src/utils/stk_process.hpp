@@ -27,19 +27,51 @@ enum ProcessType : unsigned int
     PT_COUNT = 2
 };
 
+/** Maximum number of simulation slots that can be alive in one process at
+ *  the same time. Each slot has its own world, track, physics, race manager
+ *  and projectile manager. Slot PT_MAIN and PT_CHILD are used by the game
+ *  and its child process, all further slots are handed out on demand by
+ *  STKProcess::acquireSlot(). */
+const unsigned int STK_MAX_PROCESS_SLOTS = 128;
+
 namespace STKProcess
 {
     // ========================================================================
     extern thread_local ProcessType g_process_type;
+    extern thread_local unsigned int g_process_slot;
     // ------------------------------------------------------------------------
     /** Return which type (main or child) this thread belongs to. */
     inline ProcessType getType()                     { return g_process_type; }
     // ------------------------------------------------------------------------
+    /** Return the simulation slot this thread belongs to, all per-simulation
+     *  singletons (world, track, physics...) are indexed by it. */
+    inline unsigned int getSlot()                    { return g_process_slot; }
+    // ------------------------------------------------------------------------
     /** Called when any thread in main or child is created. */
-    inline void init(ProcessType pt)                   { g_process_type = pt; }
+    inline void init(ProcessType pt)
+    {
+        g_process_type = pt;
+        g_process_slot = pt;
+    }
+    // ------------------------------------------------------------------------
+    /** Called when a thread starts working on the simulation in the given
+     *  slot, see acquireSlot(). */
+    inline void init(ProcessType pt, unsigned int slot)
+    {
+        g_process_type = pt;
+        g_process_slot = slot;
+    }
     // ------------------------------------------------------------------------
     /** Reset when stk is started (for android mostly). */
-    inline void reset()                           { g_process_type = PT_MAIN; }
+    inline void reset()
+    {
+        g_process_type = PT_MAIN;
+        g_process_slot = PT_MAIN;
+    }
+    // ------------------------------------------------------------------------
+    unsigned int acquireSlot();
+    // ------------------------------------------------------------------------
+    void releaseSlot(unsigned int slot);
 } // namespace STKProcess
 
 #endif
@@ -0,0 +1,155 @@
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2020 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "utils/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+// ----------------------------------------------------------------------------
+/** Starts the worker threads.
+ *  \param num_threads Number of workers, 0 to use one per hardware thread
+ *         (minus the calling thread).
+ */
+ThreadPool::ThreadPool(unsigned int num_threads) : m_exit(false)
+{
+    if (num_threads == 0)
+    {
+        unsigned int hw = std::thread::hardware_concurrency();
+        num_threads = hw > 1 ? hw - 1 : 1;
+    }
+    for (unsigned int i = 0; i < num_threads; i++)
+        m_workers.emplace_back(&ThreadPool::workerMain, this);
+}   // ThreadPool
+
+// ----------------------------------------------------------------------------
+/** Finishes all queued tasks and joins the workers. */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_tasks_mutex);
+        m_exit = true;
+    }
+    m_tasks_cv.notify_all();
+    for (std::thread& t : m_workers)
+        t.join();
+}   // ~ThreadPool
+
+// ----------------------------------------------------------------------------
+void ThreadPool::workerMain()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_tasks_mutex);
+            m_tasks_cv.wait(lock, [this]()
+                { return m_exit || !m_tasks.empty(); });
+            if (m_tasks.empty())
+                return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}   // workerMain
+
+// ----------------------------------------------------------------------------
+/** Queues a task to be run by the next free worker. The task must not
+ *  throw. */
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_tasks_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_tasks_cv.notify_one();
+}   // submit
+
+// ----------------------------------------------------------------------------
+/** Calls fn(i) for all i in [0, n) spread over the workers and the calling
+ *  thread, and returns once all calls are done. The first exception thrown
+ *  by fn is rethrown in the calling thread.
+ */
+void ThreadPool::parallelFor(unsigned int n,
+                             const std::function<void(unsigned int)>& fn)
+{
+    if (n == 0)
+        return;
+    if (n == 1 || m_workers.empty())
+    {
+        for (unsigned int i = 0; i < n; i++)
+            fn(i);
+        return;
+    }
+
+    // Runners that only get a worker after all indices are taken do not
+    // touch fn anymore, so the shared state may outlive this call.
+    struct State
+    {
+        std::atomic<unsigned int> m_next;
+        unsigned int m_done;
+        std::exception_ptr m_error;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+    };
+    std::shared_ptr<State> state = std::make_shared<State>();
+    state->m_next = 0;
+    state->m_done = 0;
+
+    auto runner = [state, n, &fn]()
+    {
+        unsigned int i;
+        while ((i = state->m_next.fetch_add(1)) < n)
+        {
+            std::exception_ptr error;
+            try
+            {
+                fn(i);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(state->m_mutex);
+            if (error && !state->m_error)
+                state->m_error = error;
+            if (++state->m_done == n)
+                state->m_cv.notify_all();
+        }
+    };
+
+    unsigned int num_runners = std::min(n - 1, getNumThreads());
+    for (unsigned int i = 0; i < num_runners; i++)
+        submit(runner);
+    runner();
+
+    std::unique_lock<std::mutex> lock(state->m_mutex);
+    state->m_cv.wait(lock, [&state, n]() { return state->m_done == n; });
+    if (state->m_error)
+        std::rethrow_exception(state->m_error);
+}   // parallelFor
+
+// ----------------------------------------------------------------------------
+/** Returns the process wide pool, which is created on first use. */
+ThreadPool* ThreadPool::get()
+{
+    static ThreadPool pool;
+    return &pool;
+}   // get
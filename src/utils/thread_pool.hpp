@@ -0,0 +1,71 @@
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2020 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_THREAD_POOL_HPP
+#define HEADER_THREAD_POOL_HPP
+
+#include "utils/no_copy.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ *  \brief A fixed set of worker threads executing queued tasks.
+ *  The calling thread of parallelFor() takes part in the work, so nested
+ *  calls (a task running parallelFor() itself) can not deadlock even if all
+ *  workers are busy.
+ * \ingroup utils
+ */
+class ThreadPool : public NoCopy
+{
+private:
+    /** All worker threads. */
+    std::vector<std::thread> m_workers;
+
+    /** Tasks waiting for a free worker. */
+    std::deque<std::function<void()> > m_tasks;
+
+    /** Protects m_tasks and m_exit. */
+    std::mutex m_tasks_mutex;
+
+    /** Signals the workers that a task was queued or the pool is shutting
+     *  down. */
+    std::condition_variable m_tasks_cv;
+
+    /** Set when the pool is destroyed. */
+    bool m_exit;
+
+    void workerMain();
+
+public:
+         ThreadPool(unsigned int num_threads = 0);
+        ~ThreadPool();
+    void submit(std::function<void()> task);
+    void parallelFor(unsigned int n,
+                     const std::function<void(unsigned int)>& fn);
+    static ThreadPool* get();
+    // ------------------------------------------------------------------------
+    /** Returns the number of worker threads (not counting the caller). */
+    unsigned int getNumThreads() const
+                                  { return (unsigned int)m_workers.size(); }
+};   // ThreadPool
+
+#endif
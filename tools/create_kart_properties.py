@@ -140,6 +140,12 @@ def joinSubName(group, member, titleCase):
     else:
         return "_".join(words)
 
+""" Types that are not plain values are returned as const references """
+def getReturnType(typeC):
+    if typeC in ("float", "bool"):
+        return typeC
+    return "const {0}&".format(typeC)
+
 # Functions to generate code
 
 def createEnum(groups):
@@ -190,7 +196,7 @@ def createKpDefs(groups):
             typeC = m.typeC
 
             print("    {0} get{1}() const;".
-                format(typeC, nameTitle, nameUnderscore))
+                format(getReturnType(typeC), nameTitle, nameUnderscore))
 
 def createKpGetter(groups):
     for g in groups:
@@ -203,9 +209,34 @@ def createKpGetter(groups):
             print("""// ----------------------------------------------------------------------------
 {1} KartProperties::get{0}() const
 {{
-    return m_cached_characteristic->get{0}();
+    return m_cached_characteristic->getValues().m_{2};
 }}  // get{0}
-""".format(nameTitle, typeC))
+""".format(nameTitle, getReturnType(typeC), nameUnderscore))
+
+def createCcValues(groups):
+    for g in groups:
+        print()
+        print("        // {0}".format(g.getBaseName().title()))
+        for m in g.members:
+            nameUnderscore = joinSubName(g, m, False)
+            print("        {0} m_{1};".format(m.typeC, nameUnderscore))
+
+def createCcUpdate(groups):
+    for g in groups:
+        for m in g.members:
+            nameUnderscore = joinSubName(g, m, False)
+            print("    fetch({0}, &m_values.m_{1});".
+                format(nameUnderscore.upper(), nameUnderscore))
+
+def createCcProcess(groups):
+    unionMembers = { "float": "f", "bool": "b", "floatVector": "fv",
+                     "InterpolationArray": "ia" }
+    for g in groups:
+        for m in g.members:
+            nameUnderscore = joinSubName(g, m, False)
+            print("    case {0}:\n        *value.{1} = m_values.m_{2};\n        break;".
+                format(nameUnderscore.upper(), unionMembers[m.typeStr],
+                       nameUnderscore))
 
 def createGetType(groups):
     for g in groups:
@@ -246,6 +277,9 @@ functions = {
     "kpdefs":   (createKpDefs,   "Create the header function definitions for the getters", "karts/kart_properties.hpp"),
     "kpgetter": (createKpGetter, "Implement the getters",                                  "karts/kart_properties.cpp"),
     "loadXml":  (createLoadXml,  "Code to load the characteristics from an xml file",      "karts/xml_characteristic.cpp"),
+    "ccvalues": (createCcValues, "Create the members of the flat value table",             "karts/cached_characteristic.hpp"),
+    "ccupdate": (createCcUpdate, "Fill the flat value table from the source",              "karts/cached_characteristic.cpp"),
+    "ccprocess":(createCcProcess,"Implement the process function of the cache",            "karts/cached_characteristic.cpp"),
 }
 
 def main():